@@ -43,6 +43,7 @@ if [ $? -eq 0 ]; then
     echo "  ./calaos-remote-ui --input-backend libinput"
     echo "  ./calaos-remote-ui --server-ip 192.168.1.100"
     echo "  ./calaos-remote-ui --display-backend x11 --input-backend evdev"
+    echo "  ./calaos-remote-ui --display-backend headless --headless-dump-dir frames --headless-dump-frames 1,60,last"
     echo "  CALAOS_DISPLAY_BACKEND=x11 ./calaos-remote-ui"
     echo "  CALAOS_INPUT_BACKEND=libinput ./calaos-remote-ui"
     echo "  CALAOS_SERVER_IP=192.168.1.100 ./calaos-remote-ui"
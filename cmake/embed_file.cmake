@@ -0,0 +1,19 @@
+# Embed a binary file as a C array
+# Usage: cmake -DINPUT=<file> -DOUTPUT=<file.c> -DNAME=<symbol> -P embed_file.cmake
+#
+# Defines `const uint8_t <NAME>[]` and `const size_t <NAME>_size`.
+
+file(READ ${INPUT} hex HEX)
+string(LENGTH "${hex}" hex_length)
+math(EXPR size "${hex_length} / 2")
+
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+string(REGEX REPLACE "((0x[0-9a-f][0-9a-f],){16})" "\\1\n    " bytes "${bytes}")
+
+file(WRITE ${OUTPUT}
+    "/* Generated from ${INPUT} */\n"
+    "#include <stddef.h>\n"
+    "#include <stdint.h>\n\n"
+    "const uint8_t ${NAME}[] = {\n    ${bytes}\n};\n"
+    "const size_t ${NAME}_size = ${size};\n"
+)
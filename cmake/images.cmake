@@ -0,0 +1,100 @@
+# PNG to LVGL C image conversion
+# This file is included by both main/CMakeLists.txt (ESP-IDF) and CMakeLists.txt (Linux)
+#
+# Every main/images/*.png becomes an lv_image_dsc_t named after the file,
+# except `<name>_NN.png` sequences of two frames or more, which are packed by
+# scripts/pack_atlas.py into one image and an image_atlas_t `<name>_atlas`.
+# IMAGE_COMPRESSION (NONE, RLE or LZ4) selects the compression of the image
+# data; compressed images are decoded once into the LVGL image cache.
+
+set(IMAGES_CMAKE_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+set(IMAGE_COLOR_FORMAT RGB565A8)
+
+# Generate the images of IMAGE_DIR in OUTPUT_DIR with their declarations in
+# images_generated.h, the sources are returned in OUTPUT_VAR
+function(convert_images IMAGE_DIR OUTPUT_DIR OUTPUT_VAR)
+    set(CONVERTER_SCRIPT "${IMAGES_CMAKE_DIR}/../scripts/LVGLImage.py")
+    set(ATLAS_SCRIPT "${IMAGES_CMAKE_DIR}/../scripts/pack_atlas.py")
+    set(header "${OUTPUT_DIR}/images_generated.h")
+    set(sources "")
+
+    if(NOT IMAGE_COMPRESSION)
+        set(IMAGE_COMPRESSION NONE)
+    endif()
+
+    file(MAKE_DIRECTORY ${OUTPUT_DIR})
+    file(WRITE ${header} "#pragma once\n\n#include \"lvgl.h\"\n#include \"image_atlas.h\"\n\n")
+
+    file(GLOB image_files CONFIGURE_DEPENDS "${IMAGE_DIR}/*.png")
+    list(SORT image_files)
+
+    # Group frame sequences, light_on_00.png -> light_on
+    set(sequences "")
+    foreach(png_file ${image_files})
+        get_filename_component(file_name ${png_file} NAME_WE)
+        if(file_name MATCHES "^(.+)_[0-9]+$")
+            set(sequence ${CMAKE_MATCH_1})
+            list(APPEND sequences ${sequence})
+            list(APPEND frames_${sequence} ${png_file})
+        endif()
+    endforeach()
+    list(REMOVE_DUPLICATES sequences)
+
+    set(atlases "")
+    foreach(sequence ${sequences})
+        list(LENGTH frames_${sequence} frame_count)
+        if(frame_count GREATER 1)
+            list(APPEND atlases ${sequence})
+            list(REMOVE_ITEM image_files ${frames_${sequence}})
+        endif()
+    endforeach()
+
+    foreach(png_file ${image_files})
+        get_filename_component(file_name ${png_file} NAME_WE)
+        set(c_file "${OUTPUT_DIR}/${file_name}.c")
+
+        add_custom_command(
+            OUTPUT ${c_file}
+            COMMAND ${Python3_EXECUTABLE} ${CONVERTER_SCRIPT}
+                --ofmt C
+                --cf ${IMAGE_COLOR_FORMAT}
+                --compress ${IMAGE_COMPRESSION}
+                --output ${OUTPUT_DIR}
+                ${png_file}
+            DEPENDS ${png_file} ${CONVERTER_SCRIPT}
+            COMMENT "Converting ${png_file} to ${c_file}"
+            VERBATIM
+        )
+
+        string(REPLACE "-" "_" var_name ${file_name})
+        file(APPEND ${header} "extern const lv_image_dsc_t ${var_name};\n")
+
+        list(APPEND sources ${c_file})
+    endforeach()
+
+    foreach(sequence ${atlases})
+        string(REPLACE "-" "_" var_name ${sequence})
+        set(c_file "${OUTPUT_DIR}/${var_name}_atlas.c")
+
+        add_custom_command(
+            OUTPUT ${c_file}
+            COMMAND ${Python3_EXECUTABLE} ${ATLAS_SCRIPT}
+                --name ${var_name}
+                --cf ${IMAGE_COLOR_FORMAT}
+                --compress ${IMAGE_COMPRESSION}
+                --output ${OUTPUT_DIR}
+                ${frames_${sequence}}
+            DEPENDS ${frames_${sequence}} ${ATLAS_SCRIPT} ${CONVERTER_SCRIPT}
+            COMMENT "Packing ${sequence} frames into ${c_file}"
+            VERBATIM
+        )
+
+        file(APPEND ${header} "extern const lv_image_dsc_t ${var_name}_atlas_image;\n")
+        file(APPEND ${header} "extern const image_atlas_t ${var_name}_atlas;\n")
+
+        list(APPEND sources ${c_file})
+    endforeach()
+
+    set(${OUTPUT_VAR} ${sources} PARENT_SCOPE)
+endfunction()
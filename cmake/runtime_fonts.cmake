@@ -0,0 +1,42 @@
+# Roboto TTF files embedded for the runtime font engine (main/font_engine.cpp)
+# This file is included by both main/CMakeLists.txt (ESP-IDF) and CMakeLists.txt (Linux)
+
+set(RUNTIME_FONTS_CMAKE_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+set(RUNTIME_FONT_FILES
+    Roboto-Light
+    Roboto-Regular
+    Roboto-Medium
+    Roboto-Bold
+)
+
+# Generate one C array per TTF file in OUTPUT_DIR, the sources are returned in OUTPUT_VAR
+function(embed_runtime_fonts OUTPUT_DIR OUTPUT_VAR)
+    set(FONT_DIR "${RUNTIME_FONTS_CMAKE_DIR}/../fonts")
+    set(EMBED_SCRIPT "${RUNTIME_FONTS_CMAKE_DIR}/embed_file.cmake")
+    set(sources "")
+
+    foreach(font_name ${RUNTIME_FONT_FILES})
+        # Roboto-Light.ttf -> roboto_light_ttf
+        string(TOLOWER "${font_name}" symbol)
+        string(REPLACE "-" "_" symbol "${symbol}_ttf")
+        set(ttf_file "${FONT_DIR}/${font_name}.ttf")
+        set(c_file "${OUTPUT_DIR}/${symbol}.c")
+
+        add_custom_command(
+            OUTPUT ${c_file}
+            COMMAND ${CMAKE_COMMAND}
+                -DINPUT=${ttf_file}
+                -DOUTPUT=${c_file}
+                -DNAME=${symbol}
+                -P ${EMBED_SCRIPT}
+            DEPENDS ${ttf_file} ${EMBED_SCRIPT}
+            COMMENT "Embedding ${ttf_file}"
+            VERBATIM
+        )
+
+        list(APPEND sources ${c_file})
+    endforeach()
+
+    set(${OUTPUT_VAR} ${sources} PARENT_SCOPE)
+endfunction()
@@ -12,7 +12,9 @@ set(MAIN_SOURCES
     main/page_base.cpp
     main/stack_view.cpp
     main/calaos_page.cpp
+    main/pages_config_diff.cpp
     main/theme.cpp
+    main/font_engine.cpp
     main/calaos_discovery.cpp
     main/lvgl_timer.cpp
     main/provisioning_crypto.cpp
@@ -24,6 +26,10 @@ set(MAIN_SOURCES
     main/calaos_widget.cpp
     main/widget_factory.cpp
     main/image_sequence_animator.cpp
+    main/marquee_label.cpp
+    main/perf_hud.cpp
+    main/ui_queue.cpp
+    main/animation_scheduler.cpp
     main/widgets/widget_error.cpp
     main/widgets/light_switch_widget.cpp
     main/widgets/light_switch_wide_widget.cpp
@@ -44,6 +50,8 @@ set(NETWORK_SOURCES
     network/udp/udp_server.cpp
     network/http/http_client.cpp
     network/websocket/websocket_client.cpp
+    network/websocket/websocket_send_queue.cpp
+    network/websocket/websocket_reconnect_policy.cpp
 )
 
 # HAL sources - ESP32 specific
@@ -65,6 +73,11 @@ set(LINUX_HAL_SOURCES
     hal/linux/linux_hal_network.cpp
     hal/linux/linux_hal_system.cpp
     hal/linux/display_backend_selector.cpp
+    hal/linux/virtual_clock.cpp
+    hal/linux/frame_dump.cpp
+    hal/linux/frame_stats.cpp
+    hal/linux/page_flip_presenter.cpp
+    hal/linux/event_loop.cpp
     hal/linux/logging.cpp
     components/mongoose/mongoose/mongoose.c
 )
@@ -101,11 +114,18 @@ else()
     message(FATAL_ERROR "Unknown DETECTED_PLATFORM: ${DETECTED_PLATFORM}")
 endif()
 
+# Prebaked fonts are only linked when glyphs are not rasterized at runtime
+if(RUNTIME_FONTS)
+    set(LINKED_FONT_SOURCES "")
+else()
+    set(LINKED_FONT_SOURCES ${FONT_SOURCES})
+endif()
+
 # Combined source list for the current platform
 set(ALL_SOURCES
     ${MAIN_SOURCES}
     ${FLUX_SOURCES}
     ${NETWORK_SOURCES}
     ${PLATFORM_HAL_SOURCES}
-    ${FONT_SOURCES}
+    ${LINKED_FONT_SOURCES}
 )
\ No newline at end of file
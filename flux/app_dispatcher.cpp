@@ -57,14 +57,39 @@ void AppDispatcher::dispatch(const AppEvent& event)
         ESP_LOGW(TAG, "Event queue full, dropping event type %d", static_cast<int>(event.getType()));
         delete eventPtr;  // Clean up if queue is full
     }
+    size_t depth = getQueueDepth();
 #else
     // Add event to std::queue (non-blocking)
+    size_t depth;
     {
         flux::LockGuard lock(queueMutex_);
         eventQueue_.push(event);
+        depth = eventQueue_.size();
     }
     queueCondition_.notify_one();
 #endif
+
+    size_t highWater = queueHighWater_.load(std::memory_order_relaxed);
+    while (depth > highWater &&
+           !queueHighWater_.compare_exchange_weak(highWater, depth, std::memory_order_relaxed))
+    {
+    }
+}
+
+size_t AppDispatcher::getQueueDepth() const
+{
+#ifdef ESP_PLATFORM
+    return eventQueue_ ? uxQueueMessagesWaiting(eventQueue_) : 0;
+#else
+    flux::LockGuard lock(queueMutex_);
+    return eventQueue_.size();
+#endif
+}
+
+size_t AppDispatcher::takeQueueHighWater()
+{
+    // Restart from the current depth so a standing backlog stays visible
+    return queueHighWater_.exchange(getQueueDepth(), std::memory_order_relaxed);
 }
 
 void AppDispatcher::clearSubscribers()
@@ -45,6 +45,12 @@ public:
     // Explicitly stop the worker thread (call before application cleanup)
     void shutdown();
 
+    // Events waiting for the worker thread
+    size_t getQueueDepth() const;
+
+    // Highest queue depth seen since the previous call
+    size_t takeQueueHighWater();
+
 private:
     AppDispatcher();
 
@@ -87,9 +93,11 @@ private:
 #else
     // Linux/std implementation
     std::queue<AppEvent> eventQueue_;
-    flux::Mutex queueMutex_;
+    mutable flux::Mutex queueMutex_;
     std::condition_variable queueCondition_;
     std::thread workerThread_;
     std::atomic<bool> shouldStop_;
 #endif
+
+    std::atomic<size_t> queueHighWater_{0};
 };
\ No newline at end of file
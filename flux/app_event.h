@@ -34,6 +34,7 @@ enum class AppEventType
     WebSocketDisconnected,
     WebSocketAuthFailed,
     WebSocketError,
+    WebSocketLinkStatsUpdated,
 
     IoStateReceived,
     IoStatesReceived,
@@ -151,6 +152,13 @@ struct WebSocketErrorData
     std::string errorMessage;
 };
 
+struct WebSocketLinkStatsData
+{
+    uint32_t rttMs;        // Smoothed round-trip time
+    uint32_t jitterMs;     // Round-trip time variation
+    uint8_t lossPercent;   // Share of recent keepalive probes left unanswered
+};
+
 struct IoStateReceivedData
 {
     CalaosProtocol::IoState ioState;
@@ -178,6 +186,7 @@ using AppEventData = std::variant<
     WebSocketDisconnectedData,
     WebSocketAuthFailedData,
     WebSocketErrorData,
+    WebSocketLinkStatsData,
     IoStateReceivedData,
     IoStatesReceivedData,
     ConfigUpdateReceivedData
@@ -268,6 +268,9 @@ void AppStore::handleEvent(const AppEvent& event)
             {
                 state_.websocket.isConnecting = false;
                 state_.websocket.isConnected = false;
+                state_.websocket.rttMs = 0;
+                state_.websocket.rttJitterMs = 0;
+                state_.websocket.lossPercent = 0;
                 stateChanged = true;
                 ESP_LOGD(TAG, "WebSocket disconnected");
                 break;
@@ -307,6 +310,20 @@ void AppStore::handleEvent(const AppEvent& event)
                 break;
             }
 
+            case AppEventType::WebSocketLinkStatsUpdated:
+            {
+                if (auto* data = event.getData<WebSocketLinkStatsData>())
+                {
+                    state_.websocket.rttMs = data->rttMs;
+                    state_.websocket.rttJitterMs = data->jitterMs;
+                    state_.websocket.lossPercent = data->lossPercent;
+                    stateChanged = true;
+                    ESP_LOGD(TAG, "WebSocket link: rtt=%ums jitter=%ums loss=%u%%",
+                             data->rttMs, data->jitterMs, data->lossPercent);
+                }
+                break;
+            }
+
             case AppEventType::IoStateReceived:
             {
                 if (auto* data = event.getData<IoStateReceivedData>())
@@ -105,6 +105,11 @@ struct CalaosWebSocketState
     int authHttpCode = 0;
     std::string authErrorString;
 
+    // Link quality from keepalive probes (0 until the first sample)
+    uint32_t rttMs = 0;
+    uint32_t rttJitterMs = 0;
+    uint8_t lossPercent = 0;
+
     // Helper to check if auth error requires re-provisioning
     bool requiresReProvisioning() const
     {
@@ -171,7 +176,7 @@ struct AppState
                websocket.isConnecting == other.websocket.isConnecting &&
                websocket.hasError == other.websocket.hasError &&
                websocket.authFailed == other.websocket.authFailed;
-               // Note: ioStates and config not compared for performance
+               // Note: ioStates, config and link stats not compared for performance
     }
 
     bool operator!=(const AppState& other) const
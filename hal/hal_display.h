@@ -19,4 +19,8 @@ public:
     virtual void unlock() = 0;
 
     virtual lv_display_t* getLvglDisplay() = 0;
+
+    // Block until the last rendered frame is on screen. Returns false when the
+    // display is not vsync paced or nothing is pending, the caller sleeps then.
+    virtual bool waitVsync(uint32_t /*timeoutMs*/) { return false; }
 };
\ No newline at end of file
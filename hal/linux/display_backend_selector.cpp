@@ -67,7 +67,8 @@ std::vector<calaos_display_backend_t> DisplayBackendSelector::getAvailableBacken
         CALAOS_DISPLAY_BACKEND_DRM,
         CALAOS_DISPLAY_BACKEND_FBDEV,
         CALAOS_DISPLAY_BACKEND_X11,
-        CALAOS_DISPLAY_BACKEND_SDL
+        CALAOS_DISPLAY_BACKEND_SDL,
+        CALAOS_DISPLAY_BACKEND_HEADLESS
     };
 
     for (auto backend : allBackends)
@@ -91,6 +92,7 @@ calaos_display_backend_t DisplayBackendSelector::getBackendFromEnv()
     if (backend == "sdl") return CALAOS_DISPLAY_BACKEND_SDL;
     if (backend == "x11") return CALAOS_DISPLAY_BACKEND_X11;
     if (backend == "gles") return CALAOS_DISPLAY_BACKEND_GLES;
+    if (backend == "headless") return CALAOS_DISPLAY_BACKEND_HEADLESS;
 
     return CALAOS_DISPLAY_BACKEND_NONE;
 }
@@ -102,6 +104,7 @@ void DisplayBackendSelector::setBackendOverride(const std::string& backendName)
     else if (backendName == "sdl") backendOverride = CALAOS_DISPLAY_BACKEND_SDL;
     else if (backendName == "x11") backendOverride = CALAOS_DISPLAY_BACKEND_X11;
     else if (backendName == "gles") backendOverride = CALAOS_DISPLAY_BACKEND_GLES;
+    else if (backendName == "headless") backendOverride = CALAOS_DISPLAY_BACKEND_HEADLESS;
     else backendOverride = CALAOS_DISPLAY_BACKEND_NONE;
 }
 
@@ -119,6 +122,7 @@ std::string DisplayBackendSelector::getBackendName(calaos_display_backend_t back
         case CALAOS_DISPLAY_BACKEND_SDL: return "sdl";
         case CALAOS_DISPLAY_BACKEND_X11: return "x11";
         case CALAOS_DISPLAY_BACKEND_GLES: return "gles";
+        case CALAOS_DISPLAY_BACKEND_HEADLESS: return "headless";
         default: return "none";
     }
 }
@@ -137,6 +141,9 @@ bool DisplayBackendSelector::isBackendAvailable(calaos_display_backend_t backend
             return checkX11Available();
         case CALAOS_DISPLAY_BACKEND_GLES:
             return checkGlfw3Available();
+        case CALAOS_DISPLAY_BACKEND_HEADLESS:
+            // Renders to memory, always there but never picked by auto-detection
+            return true;
         default:
             return false;
     }
@@ -12,7 +12,8 @@ typedef enum {
     CALAOS_DISPLAY_BACKEND_DRM,
     CALAOS_DISPLAY_BACKEND_SDL,
     CALAOS_DISPLAY_BACKEND_X11,
-    CALAOS_DISPLAY_BACKEND_GLES
+    CALAOS_DISPLAY_BACKEND_GLES,
+    CALAOS_DISPLAY_BACKEND_HEADLESS
 } calaos_display_backend_t;
 
 class DisplayBackendSelector
@@ -0,0 +1,146 @@
+#include "event_loop.h"
+
+#ifndef ESP_PLATFORM
+
+#include "logging.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+static const char* TAG = "hal.loop";
+
+EventLoop& EventLoop::getInstance()
+{
+    static EventLoop instance;
+    return instance;
+}
+
+EventLoop::EventLoop()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0)
+    {
+        ESP_LOGE(TAG, "Failed to create epoll/eventfd: %s", strerror(errno));
+        return;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+}
+
+EventLoop::~EventLoop()
+{
+    if (wakeFd >= 0)
+        close(wakeFd);
+    if (epollFd >= 0)
+        close(epollFd);
+}
+
+void EventLoop::addInput(int fd, lv_indev_t* indev)
+{
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        ESP_LOGW(TAG, "Cannot watch input fd %d: %s", fd, strerror(errno));
+        return;
+    }
+
+    inputs.push_back({fd, indev});
+    ESP_LOGD(TAG, "Watching input fd %d", fd);
+}
+
+void EventLoop::removeInput(lv_indev_t* indev)
+{
+    auto it = std::find_if(inputs.begin(), inputs.end(),
+                           [indev](const Input& input) { return input.indev == indev; });
+    if (it == inputs.end())
+        return;
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, it->fd, nullptr);
+    inputs.erase(it);
+}
+
+bool EventLoop::isInputActive() const
+{
+    for (const Input& input : inputs)
+    {
+        // A held finger needs polling for long press and drag, a released
+        // one for the scroll throw
+        if (lv_indev_get_state(input.indev) == LV_INDEV_STATE_PRESSED ||
+            lv_indev_get_scroll_obj(input.indev))
+            return true;
+    }
+    return false;
+}
+
+uint32_t EventLoop::prepareWait()
+{
+    for (const Input& input : inputs)
+        lv_timer_pause(lv_indev_get_read_timer(input.indev));
+
+    // From here on, a thread posting a UI change must wake us up. seq_cst so
+    // that the caller's re-check of its queue cannot be ordered before it.
+    loopThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    waiting.store(true, std::memory_order_seq_cst);
+
+    // The caller's lv_timer_handler() answer still counts the read timers
+    // paused above. Another pass only runs timers that became due since, and
+    // returns the delay of the timers that are still running.
+    return lv_timer_handler();
+}
+
+bool EventLoop::wait(uint32_t timeoutMs)
+{
+    int timeout = (timeoutMs == LV_NO_TIMER_READY) ? -1 : static_cast<int>(timeoutMs);
+
+    struct epoll_event events[8];
+    int count = epoll_wait(epollFd, events, 8, timeout);
+    waiting.store(false, std::memory_order_release);
+
+    bool input = false;
+    for (int i = 0; i < count; i++)
+    {
+        if (events[i].data.fd == wakeFd)
+        {
+            uint64_t value;
+            while (read(wakeFd, &value, sizeof(value)) > 0)
+                ;
+        }
+        else
+        {
+            input = true;
+        }
+    }
+
+    if (count < 0 && errno != EINTR)
+        ESP_LOGW(TAG, "epoll_wait failed: %s", strerror(errno));
+
+    return input;
+}
+
+void EventLoop::resumeInput()
+{
+    for (const Input& input : inputs)
+        lv_timer_resume(lv_indev_get_read_timer(input.indev));
+}
+
+void EventLoop::wakeup()
+{
+    if (!waiting.load(std::memory_order_seq_cst) ||
+        std::this_thread::get_id() == loopThread.load(std::memory_order_relaxed))
+        return;
+
+    uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+        ESP_LOGW(TAG, "Failed to signal the main loop: %s", strerror(errno));
+}
+
+#endif // ESP_PLATFORM
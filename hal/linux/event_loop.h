@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef ESP_PLATFORM
+
+#include "lvgl.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Idle wait for the Linux main loop.
+// When the screen is static the loop blocks in a single epoll_wait on the
+// input device fds, an eventfd and the time until the next LVGL timer,
+// instead of waking up every few milliseconds to poll.
+//
+// Other threads change the UI by posting commands for the render thread or,
+// for the remaining direct users, under the display lock. Both posting and
+// releasing that lock call wakeup(), which interrupts an idle wait.
+class EventLoop
+{
+public:
+    static EventLoop& getInstance();
+
+    // Watch an input device fd (main thread, at init). While idle, the LVGL
+    // read timer of indev is paused and a readable fd resumes it.
+    void addInput(int fd, lv_indev_t* indev);
+    void removeInput(lv_indev_t* indev);
+
+    // True when an input device is being touched or scrolled and needs polling
+    bool isInputActive() const;
+
+    // Call with the display lock held, before releasing it for wait().
+    // Pauses the watched read timers, runs the LVGL timers that are due and
+    // returns the time until the next one (LV_NO_TIMER_READY when none is
+    // scheduled).
+    // A post that lands before this call sees no waiter and does not write
+    // the eventfd: the caller must re-check its queue afterwards and skip
+    // the wait when it is not empty.
+    uint32_t prepareWait();
+
+    // Block until input, wakeup() or timeoutMs. Returns true on input.
+    // Call resumeInput() with the display lock held afterwards.
+    bool wait(uint32_t timeoutMs);
+    void resumeInput();
+
+    // Interrupt a wait from another thread, no-op otherwise
+    void wakeup();
+
+private:
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    struct Input
+    {
+        int fd;
+        lv_indev_t* indev;
+    };
+
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::vector<Input> inputs;
+
+    std::atomic<bool> waiting{false};
+    std::atomic<std::thread::id> loopThread;
+};
+
+#endif // ESP_PLATFORM
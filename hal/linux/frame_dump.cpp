@@ -0,0 +1,194 @@
+#include "frame_dump.h"
+
+#ifndef ESP_PLATFORM
+
+#include "logging.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+static const char* TAG = "hal.framedump";
+
+namespace
+{
+
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len)
+{
+    static uint32_t table[256];
+    static bool tableReady = false;
+
+    if (!tableReady)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        tableReady = true;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+void putBe32(std::vector<uint8_t>& out, uint32_t value)
+{
+    out.push_back(value >> 24);
+    out.push_back(value >> 16);
+    out.push_back(value >> 8);
+    out.push_back(value);
+}
+
+void putChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data)
+{
+    putBe32(out, data.size());
+    size_t typePos = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    putBe32(out, crc32Update(0, out.data() + typePos, 4 + data.size()));
+}
+
+bool writeFile(const std::string& path, const uint8_t* data, size_t len)
+{
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f)
+    {
+        ESP_LOGE(TAG, "Failed to open %s for writing", path.c_str());
+        return false;
+    }
+
+    bool ok = fwrite(data, 1, len, f) == len;
+    ok = (fclose(f) == 0) && ok;
+
+    if (!ok)
+        ESP_LOGE(TAG, "Failed to write %s", path.c_str());
+    return ok;
+}
+
+} // namespace
+
+bool FrameDump::toRgb888(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t stride,
+                         lv_color_format_t format, std::vector<uint8_t>& out)
+{
+    out.resize(size_t(width) * height * 3);
+    uint8_t* dst = out.data();
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const uint8_t* row = pixels + size_t(y) * stride;
+
+        for (uint32_t x = 0; x < width; x++)
+        {
+            switch (format)
+            {
+                case LV_COLOR_FORMAT_RGB565:
+                {
+                    uint16_t c = row[x * 2] | (row[x * 2 + 1] << 8);
+                    uint8_t r = (c >> 11) & 0x1F;
+                    uint8_t g = (c >> 5) & 0x3F;
+                    uint8_t b = c & 0x1F;
+                    *dst++ = (r << 3) | (r >> 2);
+                    *dst++ = (g << 2) | (g >> 4);
+                    *dst++ = (b << 3) | (b >> 2);
+                    break;
+                }
+                case LV_COLOR_FORMAT_RGB888:
+                    // LVGL stores BGR in memory
+                    *dst++ = row[x * 3 + 2];
+                    *dst++ = row[x * 3 + 1];
+                    *dst++ = row[x * 3];
+                    break;
+                case LV_COLOR_FORMAT_XRGB8888:
+                case LV_COLOR_FORMAT_ARGB8888:
+                    *dst++ = row[x * 4 + 2];
+                    *dst++ = row[x * 4 + 1];
+                    *dst++ = row[x * 4];
+                    break;
+                default:
+                    ESP_LOGE(TAG, "Unsupported color format %d", format);
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FrameDump::writePpm(const std::string& path, const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height)
+{
+    char header[32];
+    int headerLen = snprintf(header, sizeof(header), "P6\n%u %u\n255\n", width, height);
+
+    std::vector<uint8_t> out(header, header + headerLen);
+    out.insert(out.end(), rgb.begin(), rgb.end());
+    return writeFile(path, out.data(), out.size());
+}
+
+bool FrameDump::writePng(const std::string& path, const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    static const size_t MAX_STORED_BLOCK = 65535;
+
+    std::vector<uint8_t> out(signature, signature + sizeof(signature));
+
+    std::vector<uint8_t> ihdr;
+    putBe32(ihdr, width);
+    putBe32(ihdr, height);
+    ihdr.push_back(8);  // bit depth
+    ihdr.push_back(2);  // color type: truecolor
+    ihdr.push_back(0);  // deflate
+    ihdr.push_back(0);  // adaptive filtering
+    ihdr.push_back(0);  // no interlace
+    putChunk(out, "IHDR", ihdr);
+
+    // Raw scanlines, each prefixed with filter type 0
+    size_t rowBytes = size_t(width) * 3;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb.begin() + y * rowBytes, rgb.begin() + (y + 1) * rowBytes);
+    }
+
+    // zlib stream made of stored deflate blocks
+    std::vector<uint8_t> zlib;
+    zlib.reserve(raw.size() + raw.size() / MAX_STORED_BLOCK * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+
+    uint32_t adlerA = 1, adlerB = 0;
+    for (size_t pos = 0; pos < raw.size() || pos == 0; pos += MAX_STORED_BLOCK)
+    {
+        size_t len = std::min(MAX_STORED_BLOCK, raw.size() - pos);
+        bool last = pos + len >= raw.size();
+
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(len & 0xFF);
+        zlib.push_back(len >> 8);
+        zlib.push_back(~len & 0xFF);
+        zlib.push_back((~len >> 8) & 0xFF);
+        zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + len);
+
+        for (size_t i = pos; i < pos + len; i++)
+        {
+            adlerA = (adlerA + raw[i]) % 65521;
+            adlerB = (adlerB + adlerA) % 65521;
+        }
+
+        if (last)
+            break;
+    }
+    putBe32(zlib, (adlerB << 16) | adlerA);
+
+    putChunk(out, "IDAT", zlib);
+    putChunk(out, "IEND", {});
+
+    return writeFile(path, out.data(), out.size());
+}
+
+#endif // ESP_PLATFORM
@@ -0,0 +1,21 @@
+#pragma once
+
+#ifndef ESP_PLATFORM
+
+#include "lvgl.h"
+#include <string>
+#include <vector>
+
+// Writes rendered frames to disk for headless runs (CI screenshots, visual diffs).
+// PNG output is uncompressed (stored deflate blocks) so no codec library is needed.
+namespace FrameDump
+{
+    // Convert a frame in RGB565, RGB888 or XRGB8888 to packed RGB888
+    bool toRgb888(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t stride,
+                  lv_color_format_t format, std::vector<uint8_t>& out);
+
+    bool writePpm(const std::string& path, const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height);
+    bool writePng(const std::string& path, const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height);
+}
+
+#endif // ESP_PLATFORM
@@ -0,0 +1,96 @@
+#include "frame_stats.h"
+
+#ifndef ESP_PLATFORM
+
+#include "logging.h"
+#include <algorithm>
+#include <cmath>
+
+static const char* TAG = "hal.frames";
+
+// Longer intervals are idle time between animations
+static const uint32_t IDLE_THRESHOLD_US = 100000;
+
+// A summary is logged this often while frames are being presented
+static const uint64_t LOG_PERIOD_US = 10000000;
+
+FrameStats::FrameStats(const std::string& name):
+    name(name)
+{
+}
+
+void FrameStats::setNominalInterval(uint32_t us)
+{
+    nominalUs = us;
+}
+
+void FrameStats::record(uint64_t timeUs)
+{
+    if (windowStartUs == 0)
+        windowStartUs = timeUs;
+
+    if (lastFrameUs != 0 && timeUs > lastFrameUs)
+    {
+        uint64_t interval = timeUs - lastFrameUs;
+        if (interval < IDLE_THRESHOLD_US)
+            intervals.push_back(static_cast<uint32_t>(interval));
+    }
+    lastFrameUs = timeUs;
+
+    if (timeUs - windowStartUs >= LOG_PERIOD_US)
+        log();
+}
+
+FrameStats::Summary FrameStats::summarize() const
+{
+    Summary s;
+    if (intervals.empty())
+        return s;
+
+    s.frames = intervals.size();
+
+    uint64_t sum = 0;
+    for (uint32_t i : intervals)
+    {
+        sum += i;
+        s.maxUs = std::max(s.maxUs, i);
+    }
+    double mean = double(sum) / intervals.size();
+    s.avgUs = static_cast<uint32_t>(mean);
+
+    double variance = 0;
+    for (uint32_t i : intervals)
+        variance += (i - mean) * (i - mean);
+    s.jitterUs = static_cast<uint32_t>(std::sqrt(variance / intervals.size()));
+
+    std::vector<uint32_t> sorted = intervals;
+    size_t rank = (sorted.size() * 99 + 99) / 100;
+    std::nth_element(sorted.begin(), sorted.begin() + rank - 1, sorted.end());
+    s.p99Us = sorted[rank - 1];
+
+    if (nominalUs)
+    {
+        for (uint32_t i : intervals)
+        {
+            if (i > nominalUs * 3 / 2)
+                s.missed++;
+        }
+    }
+
+    return s;
+}
+
+void FrameStats::log()
+{
+    Summary s = summarize();
+    if (s.frames > 0)
+    {
+        ESP_LOGI(TAG, "%s: frames=%u interval_avg_us=%u jitter_us=%u p99_us=%u max_us=%u missed=%u nominal_us=%u",
+                 name.c_str(), s.frames, s.avgUs, s.jitterUs, s.p99Us, s.maxUs, s.missed, nominalUs);
+    }
+
+    intervals.clear();
+    windowStartUs = lastFrameUs;
+}
+
+#endif // ESP_PLATFORM
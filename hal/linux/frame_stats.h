@@ -0,0 +1,45 @@
+#pragma once
+
+#ifndef ESP_PLATFORM
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame-to-frame presentation interval statistics.
+// Intervals longer than the idle threshold are gaps between animations and are
+// not counted, so the numbers describe pacing while something is moving.
+class FrameStats
+{
+public:
+    explicit FrameStats(const std::string& name);
+
+    // Expected interval, 0 when the refresh rate is unknown
+    void setNominalInterval(uint32_t us);
+
+    // Record a frame that reached the screen at timeUs (monotonic)
+    void record(uint64_t timeUs);
+
+    // Log a summary line and start a new window
+    void log();
+
+    struct Summary
+    {
+        uint32_t frames = 0;
+        uint32_t avgUs = 0;
+        uint32_t jitterUs = 0;  // standard deviation of the interval
+        uint32_t p99Us = 0;
+        uint32_t maxUs = 0;
+        uint32_t missed = 0;    // intervals of more than 1.5 nominal frames
+    };
+    Summary summarize() const;
+
+private:
+    std::string name;
+    uint32_t nominalUs = 0;
+    uint64_t lastFrameUs = 0;
+    uint64_t windowStartUs = 0;
+    std::vector<uint32_t> intervals;
+};
+
+#endif // ESP_PLATFORM
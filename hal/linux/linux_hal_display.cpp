@@ -1,7 +1,12 @@
 #include "linux_hal_display.h"
+#include "virtual_clock.h"
+#include "frame_dump.h"
+#include "event_loop.h"
 #include "logging.h"
 #include "lv_conf_platform.h"
 #include <iostream>
+#include <sstream>
+#include <sys/stat.h>
 
 // Include headers based on enabled backends
 #if LV_USE_LINUX_FBDEV
@@ -68,6 +73,9 @@ HalResult LinuxHalDisplay::init()
         case CALAOS_DISPLAY_BACKEND_GLES:
             result = initGlfw3Backend();
             break;
+        case CALAOS_DISPLAY_BACKEND_HEADLESS:
+            result = initHeadlessBackend();
+            break;
         default:
             ESP_LOGE(TAG, "Unsupported backend: %s", selector.getBackendName(currentBackend).c_str());
             break;
@@ -102,6 +110,9 @@ HalResult LinuxHalDisplay::deinit()
         case CALAOS_DISPLAY_BACKEND_GLES:
             deinitGlfw3Backend();
             break;
+        case CALAOS_DISPLAY_BACKEND_HEADLESS:
+            deinitHeadlessBackend();
+            break;
         default:
             break;
     }
@@ -160,6 +171,9 @@ bool LinuxHalDisplay::tryLock(uint32_t timeoutMs)
 void LinuxHalDisplay::unlock()
 {
     displayMutex.unlock();
+
+    // Whoever held the lock may have changed the UI, let an idle main loop render it
+    EventLoop::getInstance().wakeup();
 }
 
 lv_display_t* LinuxHalDisplay::getLvglDisplay()
@@ -179,12 +193,20 @@ std::string LinuxHalDisplay::getCurrentBackend() const
 
 HalResult LinuxHalDisplay::initFbdevBackend()
 {
-#if LV_USE_LINUX_FBDEV
     ESP_LOGI(TAG, "Initializing framebuffer backend");
 
     const char* fbDevice = getenv("LV_LINUX_FBDEV_DEVICE");
     if (!fbDevice) fbDevice = "/dev/fb0";
 
+    if (usePageFlip())
+    {
+        presenter = PageFlipPresenter::createFbdev(fbDevice);
+        if (presenter)
+            return initPresenterDisplay();
+        ESP_LOGW(TAG, "Page flipping unavailable on %s, using the LVGL fbdev driver", fbDevice);
+    }
+
+#if LV_USE_LINUX_FBDEV
     fbFd = open(fbDevice, O_RDWR);
     if (fbFd == -1)
     {
@@ -213,6 +235,7 @@ HalResult LinuxHalDisplay::initFbdevBackend()
     }
 
     lv_linux_fbdev_set_file(display, fbDevice);
+    attachDriverStats("fbdev driver");
 
     return HalResult::OK;
 #else
@@ -223,12 +246,20 @@ HalResult LinuxHalDisplay::initFbdevBackend()
 
 HalResult LinuxHalDisplay::initDrmBackend()
 {
-#if LV_USE_LINUX_DRM
     ESP_LOGI(TAG, "Initializing DRM backend");
 
     const char* drmCard = getenv("LV_LINUX_DRM_CARD");
     if (!drmCard) drmCard = "/dev/dri/card0";
 
+    if (usePageFlip())
+    {
+        presenter = PageFlipPresenter::createDrm(drmCard);
+        if (presenter)
+            return initPresenterDisplay();
+        ESP_LOGW(TAG, "Page flipping unavailable on %s, using the LVGL DRM driver", drmCard);
+    }
+
+#if LV_USE_LINUX_DRM
     display = lv_linux_drm_create();
     if (!display)
     {
@@ -237,6 +268,7 @@ HalResult LinuxHalDisplay::initDrmBackend()
     }
 
     lv_linux_drm_set_file(display, drmCard, -1);
+    attachDriverStats("drm driver");
 
     displayInfo.width = 720;  // Will be updated by DRM driver
     displayInfo.height = 720;
@@ -347,6 +379,8 @@ HalResult LinuxHalDisplay::initGlfw3Backend()
 
 void LinuxHalDisplay::deinitFbdevBackend()
 {
+    deinitPresenter();
+
 #if LV_USE_LINUX_FBDEV
     if (fbFd != -1)
     {
@@ -358,7 +392,8 @@ void LinuxHalDisplay::deinitFbdevBackend()
 
 void LinuxHalDisplay::deinitDrmBackend()
 {
-    // DRM cleanup is handled by LVGL
+    // Without page flipping, DRM cleanup is handled by LVGL
+    deinitPresenter();
 }
 
 void LinuxHalDisplay::deinitSdlBackend()
@@ -374,4 +409,238 @@ void LinuxHalDisplay::deinitX11Backend()
 void LinuxHalDisplay::deinitGlfw3Backend()
 {
     // GLFW3 cleanup would be handled here
-}
\ No newline at end of file
+}
+
+bool LinuxHalDisplay::usePageFlip() const
+{
+    const char* vsync = getenv("CALAOS_DISPLAY_VSYNC");
+    return !vsync || atoi(vsync) != 0;
+}
+
+HalResult LinuxHalDisplay::initPresenterDisplay()
+{
+    display = presenter->createDisplay();
+    if (!display)
+    {
+        ESP_LOGE(TAG, "Failed to create page flipping display");
+        presenter.reset();
+        return HalResult::ERROR;
+    }
+
+    lv_display_set_user_data(display, this);
+    lv_display_set_default(display);
+
+    displayInfo.width = presenter->getWidth();
+    displayInfo.height = presenter->getHeight();
+    displayInfo.colorDepth = presenter->getColorDepth();
+
+    return HalResult::OK;
+}
+
+void LinuxHalDisplay::deinitPresenter()
+{
+    if (driverStats)
+    {
+        driverStats->log();
+        driverStats.reset();
+    }
+
+    if (!presenter)
+        return;
+
+    presenter->getStats().log();
+
+    // The display renders into the presenter's buffers, drop it first
+    if (display)
+    {
+        lv_display_delete(display);
+        display = nullptr;
+    }
+    presenter.reset();
+}
+
+bool LinuxHalDisplay::waitVsync(uint32_t timeoutMs)
+{
+    return presenter && presenter->waitFlip(timeoutMs);
+}
+
+void LinuxHalDisplay::attachDriverStats(const std::string& name)
+{
+    driverStats = std::make_unique<FrameStats>(name);
+    lv_display_add_event_cb(display, driverFrameCb, LV_EVENT_RENDER_READY, driverStats.get());
+}
+
+void LinuxHalDisplay::driverFrameCb(lv_event_t* e)
+{
+    // Flushes are synchronous in the LVGL drivers, the frame is out once rendered
+    FrameStats* stats = static_cast<FrameStats*>(lv_event_get_user_data(e));
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    stats->record(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+static uint32_t headlessTick()
+{
+    return static_cast<uint32_t>(VirtualClock::getInstance().nowMs());
+}
+
+HalResult LinuxHalDisplay::initHeadlessBackend()
+{
+    ESP_LOGI(TAG, "Initializing headless backend");
+
+    int width = 720;
+    int height = 720;
+    const char* size = getenv("CALAOS_HEADLESS_SIZE");
+    if (size && (sscanf(size, "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0))
+    {
+        ESP_LOGE(TAG, "Invalid headless size '%s', expected WIDTHxHEIGHT", size);
+        return HalResult::ERROR;
+    }
+
+    int depth = LV_COLOR_DEPTH;
+    const char* depthEnv = getenv("CALAOS_HEADLESS_DEPTH");
+    if (depthEnv)
+        depth = atoi(depthEnv);
+
+    lv_color_format_t format;
+    switch (depth)
+    {
+        case 16: format = LV_COLOR_FORMAT_RGB565; break;
+        case 24: format = LV_COLOR_FORMAT_RGB888; break;
+        case 32: format = LV_COLOR_FORMAT_XRGB8888; break;
+        default:
+            ESP_LOGE(TAG, "Unsupported headless color depth %d (use 16, 24 or 32)", depth);
+            return HalResult::ERROR;
+    }
+
+    // Deterministic time: LVGL reads the virtual clock, the main loop advances it
+    const char* frameMs = getenv("CALAOS_HEADLESS_FRAME_MS");
+    VirtualClock::getInstance().enable(frameMs ? static_cast<uint32_t>(atoi(frameMs)) : 0);
+    lv_tick_set_cb(headlessTick);
+
+    display = lv_display_create(width, height);
+    if (!display)
+    {
+        ESP_LOGE(TAG, "Failed to create headless display");
+        return HalResult::ERROR;
+    }
+
+    lv_display_set_color_format(display, format);
+
+    // A single full-size buffer in direct mode is the framebuffer itself
+    headlessStride = lv_draw_buf_width_to_stride(width, format);
+    headlessBuffer.assign(static_cast<size_t>(headlessStride) * height, 0);
+    lv_display_set_buffers(display, headlessBuffer.data(), nullptr, headlessBuffer.size(),
+                           LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(display, headlessFlush);
+    lv_display_set_user_data(display, this);
+    lv_display_set_driver_data(display, this);
+    lv_display_set_default(display);
+
+    displayInfo.width = width;
+    displayInfo.height = height;
+    displayInfo.colorDepth = depth;
+
+    // Frame capture
+    const char* dumpDir = getenv("CALAOS_HEADLESS_DUMP_DIR");
+    if (dumpDir && *dumpDir)
+    {
+        headlessDumpDir = dumpDir;
+        mkdir(headlessDumpDir.c_str(), 0755);
+
+        const char* dumpFormat = getenv("CALAOS_HEADLESS_DUMP_FORMAT");
+        headlessDumpFormat = dumpFormat ? dumpFormat : "png";
+        if (headlessDumpFormat != "png" && headlessDumpFormat != "ppm")
+        {
+            ESP_LOGW(TAG, "Unknown dump format '%s', using png", headlessDumpFormat.c_str());
+            headlessDumpFormat = "png";
+        }
+
+        // Comma separated frame numbers, "all" and/or "last"
+        const char* dumpFrames = getenv("CALAOS_HEADLESS_DUMP_FRAMES");
+        std::stringstream list(dumpFrames ? dumpFrames : "last");
+        std::string item;
+        while (std::getline(list, item, ','))
+        {
+            if (item == "all")
+                headlessDumpAll = true;
+            else if (item == "last")
+                headlessDumpLast = true;
+            else if (!item.empty())
+                headlessDumpFrames.insert(static_cast<uint32_t>(strtoul(item.c_str(), nullptr, 10)));
+        }
+
+        ESP_LOGI(TAG, "Dumping headless frames to %s (%s)", headlessDumpDir.c_str(), headlessDumpFormat.c_str());
+    }
+
+    ESP_LOGI(TAG, "Headless display %dx%d, %d-bit", width, height, depth);
+    return HalResult::OK;
+}
+
+void LinuxHalDisplay::deinitHeadlessBackend()
+{
+    if (headlessDumpLast && headlessFrames > 0)
+        dumpFrame(headlessDumpDir + "/frame_last." + headlessDumpFormat);
+
+    // The display still points at the buffer, drop it first
+    if (display)
+    {
+        lv_display_delete(display);
+        display = nullptr;
+    }
+    headlessBuffer.clear();
+    headlessBuffer.shrink_to_fit();
+}
+
+void LinuxHalDisplay::headlessFlush(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap)
+{
+    LinuxHalDisplay* self = static_cast<LinuxHalDisplay*>(lv_display_get_user_data(disp));
+
+    // Direct mode renders in place, a frame is complete on its last flush
+    if (self && lv_display_flush_is_last(disp))
+        self->onHeadlessFrame();
+
+    lv_display_flush_ready(disp);
+}
+
+void LinuxHalDisplay::onHeadlessFrame()
+{
+    headlessFrames++;
+
+    if (headlessDumpDir.empty())
+        return;
+
+    if (headlessDumpAll || headlessDumpFrames.count(headlessFrames))
+    {
+        // Virtual time in the name lets runs be compared frame by frame
+        char name[48];
+        snprintf(name, sizeof(name), "/frame_%06u_t%08llu.", headlessFrames,
+                 (unsigned long long)VirtualClock::getInstance().nowMs());
+        dumpFrame(headlessDumpDir + name + headlessDumpFormat);
+    }
+}
+
+uint32_t LinuxHalDisplay::getFrameCount() const
+{
+    return headlessFrames;
+}
+
+bool LinuxHalDisplay::dumpFrame(const std::string& path)
+{
+    if (currentBackend != CALAOS_DISPLAY_BACKEND_HEADLESS || headlessBuffer.empty())
+    {
+        ESP_LOGW(TAG, "Frame dump is only available with the headless backend");
+        return false;
+    }
+
+    std::vector<uint8_t> rgb;
+    if (!FrameDump::toRgb888(headlessBuffer.data(), displayInfo.width, displayInfo.height,
+                             headlessStride, lv_display_get_color_format(display), rgb))
+        return false;
+
+    bool isPpm = path.size() >= 4 && path.compare(path.size() - 4, 4, ".ppm") == 0;
+    bool ok = isPpm ? FrameDump::writePpm(path, rgb, displayInfo.width, displayInfo.height)
+                    : FrameDump::writePng(path, rgb, displayInfo.width, displayInfo.height);
+    if (ok)
+        ESP_LOGD(TAG, "Frame %u written to %s", headlessFrames, path.c_str());
+    return ok;
+}
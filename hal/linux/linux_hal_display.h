@@ -2,7 +2,13 @@
 
 #include "../hal_display.h"
 #include "display_backend_selector.h"
+#include "page_flip_presenter.h"
+#include "frame_stats.h"
+#include <memory>
 #include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 
 class LinuxHalDisplay : public HalDisplay
 {
@@ -17,11 +23,16 @@ public:
     bool tryLock(uint32_t timeoutMs) override;
     void unlock() override;
     lv_display_t* getLvglDisplay() override;
+    bool waitVsync(uint32_t timeoutMs) override;
 
     // Backend-specific methods
     void setBackendOverride(const std::string& backend);
     std::string getCurrentBackend() const;
 
+    // Headless backend: frames rendered so far and on-demand capture
+    uint32_t getFrameCount() const;
+    bool dumpFrame(const std::string& path);
+
 private:
     lv_display_t* display = nullptr;
     DisplayInfo displayInfo;
@@ -34,6 +45,7 @@ private:
     HalResult initSdlBackend();
     HalResult initX11Backend();
     HalResult initGlfw3Backend();
+    HalResult initHeadlessBackend();
 
     // Backend-specific cleanup
     void deinitFbdevBackend();
@@ -41,12 +53,36 @@ private:
     void deinitSdlBackend();
     void deinitX11Backend();
     void deinitGlfw3Backend();
+    void deinitHeadlessBackend();
+
+    // DRM/fbdev page flipping, disabled with CALAOS_DISPLAY_VSYNC=0
+    bool usePageFlip() const;
+    HalResult initPresenterDisplay();
+    void deinitPresenter();
+    std::unique_ptr<PageFlipPresenter> presenter;
+
+    // Frame pacing of the plain LVGL drivers, for comparison with page flipping
+    void attachDriverStats(const std::string& name);
+    static void driverFrameCb(lv_event_t* e);
+    std::unique_ptr<FrameStats> driverStats;
 
     // Framebuffer backend data
     uint8_t* fbBuffer = nullptr;
     int fbFd = -1;
     size_t fbSize = 0;
 
+    // Headless backend data, configured from CALAOS_HEADLESS_* variables
+    static void headlessFlush(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap);
+    void onHeadlessFrame();
+    std::vector<uint8_t> headlessBuffer;
+    uint32_t headlessStride = 0;
+    uint32_t headlessFrames = 0;
+    std::string headlessDumpDir;
+    std::string headlessDumpFormat;
+    std::set<uint32_t> headlessDumpFrames;
+    bool headlessDumpAll = false;
+    bool headlessDumpLast = false;
+
     // Generic backend data
     void* backendData = nullptr;
 };
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "linux_hal_input.h"
+#include "event_loop.h"
 #include "logging.h"
 #include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
 
 static const char* TAG = "hal.input";
 
@@ -49,6 +52,7 @@ HalResult LinuxHalInput::deinit()
     // LVGL handles cleanup automatically
     if (inputDevice)
     {
+        EventLoop::getInstance().removeInput(inputDevice);
         lv_indev_delete(inputDevice);
         inputDevice = nullptr;
     }
@@ -125,13 +129,13 @@ bool LinuxHalInput::isInputBackendAvailable(calaos_input_backend_t backend)
     switch (backend)
     {
         case CALAOS_INPUT_BACKEND_EVDEV:
-#if LV_USE_LINUX_EVDEV
-            return access("/dev/input", F_OK) == 0;
+#if LV_USE_EVDEV
+            return access(getEvdevDevice(), F_OK) == 0;
 #else
             return false;
 #endif
         case CALAOS_INPUT_BACKEND_LIBINPUT:
-#if LV_USE_LINUX_LIBINPUT
+#if LV_USE_LIBINPUT
             return access("/dev/input", F_OK) == 0;  // Simplified check
 #else
             return false;
@@ -164,23 +168,39 @@ calaos_input_backend_t LinuxHalInput::getInputBackendFromEnv()
     return CALAOS_INPUT_BACKEND_NONE;
 }
 
-HalResult LinuxHalInput::initEvdevBackend()
+const char* LinuxHalInput::getEvdevDevice() const
 {
-#if LV_USE_LINUX_EVDEV
-    ESP_LOGI(TAG, "Initializing evdev input backend");
-    
     // Use environment variable override if set
     const char* evdevDevice = getenv("LV_LINUX_EVDEV_POINTER_DEVICE");
-    if (!evdevDevice) evdevDevice = "/dev/input/event*";  // Let LVGL find the device
-    
-    inputDevice = lv_linux_evdev_create(LV_INDEV_TYPE_POINTER, evdevDevice);
+#if LV_USE_EVDEV
+    if (!evdevDevice) evdevDevice = LV_EVDEV_POINTER_DEVICE;
+#endif
+    return evdevDevice ? evdevDevice : "";
+}
+
+HalResult LinuxHalInput::initEvdevBackend()
+{
+#if LV_USE_EVDEV
+    ESP_LOGI(TAG, "Initializing evdev input backend");
+
+    const char* evdevDevice = getEvdevDevice();
+    int fd = open(evdevDevice, O_RDONLY | O_NOCTTY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        ESP_LOGE(TAG, "Failed to open evdev device %s", evdevDevice);
+        return HalResult::ERROR;
+    }
+
+    // LVGL owns the fd from here, the main loop only polls it while idle
+    inputDevice = lv_evdev_create_fd(LV_INDEV_TYPE_POINTER, fd);
     if (!inputDevice)
     {
         ESP_LOGE(TAG, "Failed to create evdev input device");
         return HalResult::ERROR;
     }
-    
-    ESP_LOGI(TAG, "evdev input device created successfully");
+    EventLoop::getInstance().addInput(fd, inputDevice);
+
+    ESP_LOGI(TAG, "evdev input device created successfully on %s", evdevDevice);
     return HalResult::OK;
 #else
     ESP_LOGE(TAG, "evdev backend not compiled in");
@@ -190,10 +210,12 @@ HalResult LinuxHalInput::initEvdevBackend()
 
 HalResult LinuxHalInput::initLibinputBackend()
 {
-#if LV_USE_LINUX_LIBINPUT
+#if LV_USE_LIBINPUT
     ESP_LOGI(TAG, "Initializing libinput backend");
-    
-    inputDevice = lv_linux_libinput_create(LV_INDEV_TYPE_POINTER, "/dev/input/event*");
+
+    // Not registered with the idle wait: the driver drains the device from
+    // its own thread, so its read timer keeps polling
+    inputDevice = lv_libinput_create(LV_INDEV_TYPE_POINTER, "/dev/input/event*");
     if (!inputDevice)
     {
         ESP_LOGE(TAG, "Failed to create libinput input device");
@@ -34,4 +34,5 @@ private:
     // Backend-specific initialization
     HalResult initEvdevBackend();
     HalResult initLibinputBackend();
+    const char* getEvdevDevice() const;
 };
\ No newline at end of file
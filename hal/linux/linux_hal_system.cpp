@@ -1,4 +1,5 @@
 #include "linux_hal_system.h"
+#include "virtual_clock.h"
 #include "logging.h"
 #include <iostream>
 #include <fstream>
@@ -36,11 +37,21 @@ HalResult LinuxHalSystem::deinit()
 
 void LinuxHalSystem::delay(uint32_t ms)
 {
+    VirtualClock& clock = VirtualClock::getInstance();
+    if (clock.isEnabled())
+    {
+        clock.advance(clock.stepFor(ms));
+        return;
+    }
+
     std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
 
 uint64_t LinuxHalSystem::getTimeMs()
 {
+    if (VirtualClock::getInstance().isEnabled())
+        return VirtualClock::getInstance().nowMs();
+
     auto now = std::chrono::steady_clock::now();
     auto duration = now.time_since_epoch();
     return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
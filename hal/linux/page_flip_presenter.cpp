@@ -0,0 +1,566 @@
+#include "page_flip_presenter.h"
+
+#ifndef ESP_PLATFORM
+
+#include "logging.h"
+#include "lv_conf_platform.h"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+
+#if LV_USE_FBDEV
+#include <linux/fb.h>
+#endif
+
+#if LV_USE_DRM
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+#endif
+
+static const char* TAG = "hal.flip";
+
+// Refresh interval assumed when the device does not report its timings
+static const uint32_t DEFAULT_REFRESH_US = 16667;
+
+// A flip that takes longer than this is treated as lost
+static const uint32_t FLIP_TIMEOUT_MS = 100;
+
+static uint64_t monotonicUs()
+{
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+}
+
+PageFlipPresenter::PageFlipPresenter(const char* name):
+    stats(name)
+{
+}
+
+lv_display_t* PageFlipPresenter::createDisplay()
+{
+    display = lv_display_create(width, height);
+    if (!display)
+        return nullptr;
+
+    lv_display_set_color_format(display, format);
+    lv_display_set_buffers_with_stride(display, buffers[0], buffers[1], stride * height, stride,
+                                       LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(display, flushCb);
+    lv_display_set_flush_wait_cb(display, flushWaitCb);
+    lv_display_set_driver_data(display, this);
+
+    stats.setNominalInterval(refreshUs);
+    return display;
+}
+
+void PageFlipPresenter::flushCb(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap)
+{
+    PageFlipPresenter* self = static_cast<PageFlipPresenter*>(lv_display_get_driver_data(disp));
+
+    // Direct mode renders in place, only the end of the frame needs a flip
+    if (!lv_display_flush_is_last(disp))
+    {
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    int index = (pxMap == self->buffers[0]) ? 0 : 1;
+    if (!self->queueFlip(index))
+    {
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    // Flushing stays set until the flip completes, LVGL then waits in flushWaitCb
+    // before touching the other buffer
+    self->flipPending = true;
+}
+
+void PageFlipPresenter::flushWaitCb(lv_display_t* disp)
+{
+    PageFlipPresenter* self = static_cast<PageFlipPresenter*>(lv_display_get_driver_data(disp));
+    if (self->flipPending)
+        self->waitFlip(FLIP_TIMEOUT_MS);
+}
+
+bool PageFlipPresenter::waitFlip(uint32_t timeoutMs)
+{
+    if (!flipPending)
+        return false;
+
+    if (waitFlipDone(timeoutMs))
+    {
+        stats.record(flipTimeUs);
+    }
+    else if (timeoutMs >= FLIP_TIMEOUT_MS)
+    {
+        // Display off or driver stuck: move on rather than freezing the UI
+        if (!timeoutLogged)
+            ESP_LOGW(TAG, "Page flip did not complete within %u ms", timeoutMs);
+        timeoutLogged = true;
+    }
+    else
+    {
+        return true;
+    }
+
+    flipPending = false;
+    lv_display_flush_ready(display);
+    return true;
+}
+
+#if LV_USE_FBDEV
+
+// Double-height virtual framebuffer: buffer 1 starts yres lines below buffer 0
+// and FBIOPAN_DISPLAY selects the one scanned out.
+class FbdevPageFlip : public PageFlipPresenter
+{
+public:
+    FbdevPageFlip():
+        PageFlipPresenter("fbdev flip")
+    {
+    }
+
+    ~FbdevPageFlip() override
+    {
+        if (mapped != MAP_FAILED)
+        {
+            // Leave the console on the first page
+            vinfo.yoffset = 0;
+            ioctl(fd, FBIOPAN_DISPLAY, &vinfo);
+            munmap(mapped, mappedSize);
+        }
+        if (fd >= 0)
+            close(fd);
+    }
+
+    bool open(const std::string& device)
+    {
+        fd = ::open(device.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0)
+        {
+            ESP_LOGW(TAG, "Cannot open %s: %s", device.c_str(), strerror(errno));
+            return false;
+        }
+
+        if (ioctl(fd, FBIOGET_VSCREENINFO, &vinfo) < 0)
+        {
+            ESP_LOGW(TAG, "FBIOGET_VSCREENINFO failed: %s", strerror(errno));
+            return false;
+        }
+
+        switch (vinfo.bits_per_pixel)
+        {
+            case 16: format = LV_COLOR_FORMAT_RGB565; break;
+            case 24: format = LV_COLOR_FORMAT_RGB888; break;
+            case 32: format = LV_COLOR_FORMAT_XRGB8888; break;
+            default:
+                ESP_LOGW(TAG, "Unsupported framebuffer depth %u", vinfo.bits_per_pixel);
+                return false;
+        }
+
+        vinfo.yres_virtual = vinfo.yres * 2;
+        vinfo.yoffset = 0;
+        vinfo.activate = FB_ACTIVATE_NOW;
+        ioctl(fd, FBIOPUT_VSCREENINFO, &vinfo);
+
+        struct fb_fix_screeninfo finfo;
+        if (ioctl(fd, FBIOGET_VSCREENINFO, &vinfo) < 0 || ioctl(fd, FBIOGET_FSCREENINFO, &finfo) < 0)
+            return false;
+
+        size_t pageSize = size_t(finfo.line_length) * vinfo.yres;
+        if (vinfo.yres_virtual < vinfo.yres * 2 || finfo.smem_len < pageSize * 2 || finfo.ypanstep == 0)
+        {
+            ESP_LOGW(TAG, "Framebuffer cannot hold or pan between two pages (yres_virtual=%u, smem=%u)",
+                     vinfo.yres_virtual, finfo.smem_len);
+            return false;
+        }
+
+        mappedSize = finfo.smem_len;
+        mapped = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+            ESP_LOGW(TAG, "Cannot map framebuffer: %s", strerror(errno));
+            return false;
+        }
+
+        width = vinfo.xres;
+        height = vinfo.yres;
+        stride = finfo.line_length;
+        buffers[0] = static_cast<uint8_t*>(mapped);
+        buffers[1] = buffers[0] + pageSize;
+
+        // pixclock is in picoseconds per pixel
+        uint64_t lineClocks = vinfo.left_margin + vinfo.xres + vinfo.right_margin + vinfo.hsync_len;
+        uint64_t frameLines = vinfo.upper_margin + vinfo.yres + vinfo.lower_margin + vinfo.vsync_len;
+        refreshUs = vinfo.pixclock ? lineClocks * frameLines * vinfo.pixclock / 1000000 : DEFAULT_REFRESH_US;
+
+        ESP_LOGI(TAG, "fbdev page flipping on %s: %ux%u %u bpp, refresh %u us",
+                 device.c_str(), width, height, vinfo.bits_per_pixel, refreshUs);
+        return true;
+    }
+
+protected:
+    bool queueFlip(int index) override
+    {
+        vinfo.yoffset = index * vinfo.yres;
+
+        // Drivers backed by DRM apply the pan synchronously at vblank,
+        // others latch it and FBIO_WAITFORVSYNC tells when it happened
+        uint64_t start = monotonicUs();
+        if (ioctl(fd, FBIOPAN_DISPLAY, &vinfo) < 0)
+        {
+            ESP_LOGW(TAG, "FBIOPAN_DISPLAY failed: %s", strerror(errno));
+            return false;
+        }
+        flipTimeUs = monotonicUs();
+        panBlocked = flipTimeUs - start > refreshUs / 4;
+        return true;
+    }
+
+    bool waitFlipDone(uint32_t timeoutMs) override
+    {
+        if (panBlocked || !vsyncSupported)
+            return true;
+
+        __u32 crtc = 0;
+        if (ioctl(fd, FBIO_WAITFORVSYNC, &crtc) < 0)
+        {
+            // Without it the pan still avoids half-drawn frames, only tearing remains
+            ESP_LOGW(TAG, "FBIO_WAITFORVSYNC not supported (%s), pacing disabled", strerror(errno));
+            vsyncSupported = false;
+            return true;
+        }
+        flipTimeUs = monotonicUs();
+        return true;
+    }
+
+private:
+    int fd = -1;
+    void* mapped = MAP_FAILED;
+    size_t mappedSize = 0;
+    struct fb_var_screeninfo vinfo = {};
+    bool panBlocked = false;
+    bool vsyncSupported = true;
+};
+
+#endif // LV_USE_FBDEV
+
+#if LV_USE_DRM
+
+// Two dumb buffers on the first connected output, switched with drmModePageFlip.
+// The flip event carries the vblank timestamp of the frame.
+class DrmPageFlip : public PageFlipPresenter
+{
+public:
+    DrmPageFlip():
+        PageFlipPresenter("drm flip")
+    {
+    }
+
+    ~DrmPageFlip() override
+    {
+        if (fd < 0)
+            return;
+
+        // Let a pending flip land before the buffers go away
+        deferredIndex = -1;
+        if (flipQueued)
+            waitFlipDone(FLIP_TIMEOUT_MS);
+
+        if (savedCrtc)
+        {
+            drmModeSetCrtc(fd, savedCrtc->crtc_id, savedCrtc->buffer_id, savedCrtc->x, savedCrtc->y,
+                           &connectorId, 1, &savedCrtc->mode);
+            drmModeFreeCrtc(savedCrtc);
+        }
+
+        for (int i = 0; i < 2; i++)
+        {
+            if (buffers[i])
+                munmap(buffers[i], bufferSize);
+            if (fbIds[i])
+                drmModeRmFB(fd, fbIds[i]);
+            if (handles[i])
+            {
+                struct drm_mode_destroy_dumb destroy = {};
+                destroy.handle = handles[i];
+                drmIoctl(fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy);
+            }
+        }
+
+        close(fd);
+    }
+
+    bool open(const std::string& card)
+    {
+        fd = ::open(card.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0)
+        {
+            ESP_LOGW(TAG, "Cannot open %s: %s", card.c_str(), strerror(errno));
+            return false;
+        }
+
+        if (!findOutput())
+            return false;
+
+        width = mode.hdisplay;
+        height = mode.vdisplay;
+        format = (LV_COLOR_DEPTH == 16) ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_XRGB8888;
+        uint32_t bpp = lv_color_format_get_bpp(format);
+
+        for (int i = 0; i < 2; i++)
+        {
+            struct drm_mode_create_dumb create = {};
+            create.width = width;
+            create.height = height;
+            create.bpp = bpp;
+            if (drmIoctl(fd, DRM_IOCTL_MODE_CREATE_DUMB, &create) < 0)
+            {
+                ESP_LOGW(TAG, "Cannot create dumb buffer: %s", strerror(errno));
+                return false;
+            }
+            handles[i] = create.handle;
+            stride = create.pitch;
+            bufferSize = create.size;
+
+            if (drmModeAddFB(fd, width, height, bpp == 16 ? 16 : 24, bpp, stride, handles[i], &fbIds[i]) != 0)
+            {
+                ESP_LOGW(TAG, "Cannot add framebuffer: %s", strerror(errno));
+                return false;
+            }
+
+            struct drm_mode_map_dumb map = {};
+            map.handle = handles[i];
+            if (drmIoctl(fd, DRM_IOCTL_MODE_MAP_DUMB, &map) < 0)
+                return false;
+
+            void* ptr = mmap(nullptr, bufferSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, map.offset);
+            if (ptr == MAP_FAILED)
+            {
+                ESP_LOGW(TAG, "Cannot map dumb buffer: %s", strerror(errno));
+                return false;
+            }
+            buffers[i] = static_cast<uint8_t*>(ptr);
+            memset(buffers[i], 0, bufferSize);
+        }
+
+        savedCrtc = drmModeGetCrtc(fd, crtcId);
+        if (drmModeSetCrtc(fd, crtcId, fbIds[0], 0, 0, &connectorId, 1, &mode) != 0)
+        {
+            ESP_LOGW(TAG, "Cannot set mode: %s", strerror(errno));
+            return false;
+        }
+
+        refreshUs = mode.vrefresh ? 1000000 / mode.vrefresh : DEFAULT_REFRESH_US;
+
+        ESP_LOGI(TAG, "DRM page flipping on %s: %ux%u@%u, %u bpp",
+                 card.c_str(), width, height, mode.vrefresh, bpp);
+        return true;
+    }
+
+protected:
+    bool queueFlip(int index) override
+    {
+        // A flip that outlived waitFlip's timeout is still owned by the kernel:
+        // collect its event if it has landed, otherwise queue this one behind it
+        // since drmModePageFlip would only fail with EBUSY
+        if (flipQueued)
+            handleEvents(0);
+
+        if (flipQueued)
+        {
+            deferredIndex = index;
+            return true;
+        }
+
+        return submitFlip(index);
+    }
+
+    bool waitFlipDone(uint32_t timeoutMs) override
+    {
+        uint64_t deadline = monotonicUs() + timeoutMs * 1000ULL;
+
+        while (flipQueued)
+        {
+            uint64_t now = monotonicUs();
+            if (now >= deadline)
+                return false;
+
+            if (!handleEvents(static_cast<int>((deadline - now + 999) / 1000)))
+                return false;
+
+            // The stale flip landed, send the frame that was waiting behind it
+            if (!flipQueued && deferredIndex >= 0)
+            {
+                int index = deferredIndex;
+                deferredIndex = -1;
+                submitFlip(index);
+            }
+        }
+
+        return true;
+    }
+
+private:
+    bool submitFlip(int index)
+    {
+        if (drmModePageFlip(fd, crtcId, fbIds[index], DRM_MODE_PAGE_FLIP_EVENT, this) != 0)
+        {
+            // Logged once per second at most, a blanked output fails every frame
+            int err = errno;
+            failedFlips++;
+            uint64_t now = monotonicUs();
+            if (now - lastFailureLogUs >= 1000000)
+            {
+                ESP_LOGW(TAG, "drmModePageFlip failed: %s (%u failures)", strerror(err), failedFlips);
+                lastFailureLogUs = now;
+                failedFlips = 0;
+            }
+            return false;
+        }
+        flipQueued = true;
+        return true;
+    }
+
+    // Dispatch the flip event if one arrives within timeoutMs.
+    // Returns false when the device cannot be polled.
+    bool handleEvents(int timeoutMs)
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        int ret = poll(&pfd, 1, timeoutMs);
+        if (ret < 0)
+            return errno == EINTR;
+        if (ret == 0)
+            return true;
+
+        drmEventContext events = {};
+        events.version = 2;
+        events.page_flip_handler = pageFlipHandler;
+        drmHandleEvent(fd, &events);
+        return true;
+    }
+
+    static void pageFlipHandler(int fd, unsigned int frame, unsigned int sec, unsigned int usec, void* data)
+    {
+        DrmPageFlip* self = static_cast<DrmPageFlip*>(data);
+        self->flipTimeUs = uint64_t(sec) * 1000000 + usec;
+        self->flipQueued = false;
+    }
+
+    bool findOutput()
+    {
+        drmModeRes* res = drmModeGetResources(fd);
+        if (!res)
+        {
+            ESP_LOGW(TAG, "Not a KMS device");
+            return false;
+        }
+
+        bool found = false;
+        for (int i = 0; i < res->count_connectors && !found; i++)
+        {
+            drmModeConnector* conn = drmModeGetConnector(fd, res->connectors[i]);
+            if (!conn)
+                continue;
+
+            if (conn->connection == DRM_MODE_CONNECTED && conn->count_modes > 0)
+            {
+                mode = conn->modes[0];
+                for (int m = 0; m < conn->count_modes; m++)
+                {
+                    if (conn->modes[m].type & DRM_MODE_TYPE_PREFERRED)
+                    {
+                        mode = conn->modes[m];
+                        break;
+                    }
+                }
+
+                connectorId = conn->connector_id;
+                crtcId = findCrtc(res, conn);
+                found = crtcId != 0;
+            }
+
+            drmModeFreeConnector(conn);
+        }
+
+        drmModeFreeResources(res);
+
+        if (!found)
+            ESP_LOGW(TAG, "No connected output with a usable CRTC");
+        return found;
+    }
+
+    uint32_t findCrtc(drmModeRes* res, drmModeConnector* conn)
+    {
+        // Keep the CRTC already driving the connector when there is one
+        if (conn->encoder_id)
+        {
+            drmModeEncoder* enc = drmModeGetEncoder(fd, conn->encoder_id);
+            uint32_t crtc = enc ? enc->crtc_id : 0;
+            drmModeFreeEncoder(enc);
+            if (crtc)
+                return crtc;
+        }
+
+        for (int e = 0; e < conn->count_encoders; e++)
+        {
+            drmModeEncoder* enc = drmModeGetEncoder(fd, conn->encoders[e]);
+            if (!enc)
+                continue;
+
+            uint32_t possible = enc->possible_crtcs;
+            drmModeFreeEncoder(enc);
+
+            for (int c = 0; c < res->count_crtcs; c++)
+            {
+                if (possible & (1u << c))
+                    return res->crtcs[c];
+            }
+        }
+
+        return 0;
+    }
+
+    int fd = -1;
+    uint32_t connectorId = 0;
+    uint32_t crtcId = 0;
+    drmModeModeInfo mode = {};
+    drmModeCrtc* savedCrtc = nullptr;
+    uint32_t handles[2] = {0, 0};
+    uint32_t fbIds[2] = {0, 0};
+    size_t bufferSize = 0;
+    bool flipQueued = false;
+    int deferredIndex = -1;
+    uint32_t failedFlips = 0;
+    uint64_t lastFailureLogUs = 0;
+};
+
+#endif // LV_USE_DRM
+
+std::unique_ptr<PageFlipPresenter> PageFlipPresenter::createDrm(const std::string& card)
+{
+#if LV_USE_DRM
+    auto presenter = std::make_unique<DrmPageFlip>();
+    if (presenter->open(card))
+        return presenter;
+#endif
+    return nullptr;
+}
+
+std::unique_ptr<PageFlipPresenter> PageFlipPresenter::createFbdev(const std::string& device)
+{
+#if LV_USE_FBDEV
+    auto presenter = std::make_unique<FbdevPageFlip>();
+    if (presenter->open(device))
+        return presenter;
+#endif
+    return nullptr;
+}
+
+#endif // ESP_PLATFORM
@@ -0,0 +1,68 @@
+#pragma once
+
+#ifndef ESP_PLATFORM
+
+#include "../hal_types.h"
+#include "frame_stats.h"
+#include "lvgl.h"
+#include <memory>
+#include <string>
+
+// Vsync-paced presentation for the DRM and fbdev backends.
+// LVGL renders in direct mode into two full-screen buffers that live in scanout
+// memory. The last flush of a frame queues a flip to the rendered buffer, and
+// the frame only completes when the flip has happened, so the next frame never
+// draws into the buffer that is on screen. The main loop waits on the flip
+// (waitFlip) instead of sleeping, which paces rendering to the display refresh.
+class PageFlipPresenter
+{
+public:
+    virtual ~PageFlipPresenter() = default;
+
+    // Return nullptr when the device cannot be opened or double-buffered,
+    // the caller then falls back to the plain LVGL driver
+    static std::unique_ptr<PageFlipPresenter> createDrm(const std::string& card);
+    static std::unique_ptr<PageFlipPresenter> createFbdev(const std::string& device);
+
+    // Create the LVGL display rendering into the flip buffers
+    lv_display_t* createDisplay();
+
+    // Block until the queued flip is on screen.
+    // Returns false immediately when no flip is pending.
+    bool waitFlip(uint32_t timeoutMs);
+
+    uint32_t getWidth() const { return width; }
+    uint32_t getHeight() const { return height; }
+    uint32_t getColorDepth() const { return lv_color_format_get_bpp(format); }
+    uint32_t getRefreshUs() const { return refreshUs; }
+
+    FrameStats& getStats() { return stats; }
+
+protected:
+    PageFlipPresenter(const char* name);
+
+    // Make buffers[index] the scanout buffer at the next vblank
+    virtual bool queueFlip(int index) = 0;
+
+    // Wait for the queued flip, set flipTimeUs to when it hit the screen
+    virtual bool waitFlipDone(uint32_t timeoutMs) = 0;
+
+    uint8_t* buffers[2] = {nullptr, nullptr};
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t stride = 0;
+    lv_color_format_t format = LV_COLOR_FORMAT_UNKNOWN;
+    uint32_t refreshUs = 0;
+    uint64_t flipTimeUs = 0;
+
+private:
+    static void flushCb(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap);
+    static void flushWaitCb(lv_display_t* disp);
+
+    lv_display_t* display = nullptr;
+    bool flipPending = false;
+    bool timeoutLogged = false;
+    FrameStats stats;
+};
+
+#endif // ESP_PLATFORM
@@ -0,0 +1,28 @@
+#pragma once
+
+#ifndef ESP_PLATFORM
+
+#include <stdio.h>
+
+// Minimal harness shared by the host test tools: each check prints one
+// "ok"/"FAIL" line, testResult() prints PASS or FAIL and gives the exit code.
+// Included once per test executable.
+
+static int failures = 0;
+
+static void check(bool ok, const char* name, const char* detail = "")
+{
+    printf("%-4s %s %s\n", ok ? "ok" : "FAIL", name, detail);
+    if (!ok)
+    {
+        failures++;
+    }
+}
+
+static int testResult()
+{
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
+
+#endif // ESP_PLATFORM
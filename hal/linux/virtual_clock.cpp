@@ -0,0 +1,32 @@
+#include "virtual_clock.h"
+
+#ifndef ESP_PLATFORM
+
+#include "logging.h"
+
+static const char* TAG = "hal.clock";
+
+VirtualClock& VirtualClock::getInstance()
+{
+    static VirtualClock instance;
+    return instance;
+}
+
+void VirtualClock::enable(uint32_t stepMs)
+{
+    frameStepMs = stepMs;
+    now.store(0, std::memory_order_release);
+    enabled.store(true, std::memory_order_release);
+
+    if (stepMs)
+        ESP_LOGI(TAG, "Virtual clock enabled, %u ms per frame", stepMs);
+    else
+        ESP_LOGI(TAG, "Virtual clock enabled, following LVGL timer schedule");
+}
+
+void VirtualClock::advance(uint32_t ms)
+{
+    now.fetch_add(ms, std::memory_order_acq_rel);
+}
+
+#endif // ESP_PLATFORM
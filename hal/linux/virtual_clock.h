@@ -0,0 +1,36 @@
+#pragma once
+
+#ifndef ESP_PLATFORM
+
+#include <atomic>
+#include <cstdint>
+
+// Simulated time source for headless runs.
+// When enabled, LVGL ticks, HalSystem::getTimeMs() and the smooth_ui_toolkit
+// tick all read this clock, and HalSystem::delay() advances it instead of
+// sleeping. A UI run then depends only on its inputs, not on host load.
+class VirtualClock
+{
+public:
+    static VirtualClock& getInstance();
+
+    // stepMs > 0 advances by a fixed frame step on every delay() call,
+    // 0 advances by exactly the requested delay
+    void enable(uint32_t stepMs);
+    bool isEnabled() const { return enabled.load(std::memory_order_acquire); }
+
+    uint64_t nowMs() const { return now.load(std::memory_order_acquire); }
+    void advance(uint32_t ms);
+
+    // Amount a delay(ms) call moves the clock forward
+    uint32_t stepFor(uint32_t ms) const { return frameStepMs ? frameStepMs : ms; }
+
+private:
+    VirtualClock() = default;
+
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> now{0};
+    uint32_t frameStepMs = 0;
+};
+
+#endif // ESP_PLATFORM
@@ -0,0 +1,211 @@
+#include "animation_scheduler.h"
+#include "smooth_ui_toolkit.h"
+#include <algorithm>
+#include <iterator>
+
+AnimationScheduler& AnimationScheduler::getInstance()
+{
+    static AnimationScheduler instance;
+    return instance;
+}
+
+uint32_t AnimationScheduler::now()
+{
+    // Same clock as smooth_ui_toolkit animations, including headless virtual time
+    return smooth_ui_toolkit::ui_hal::get_tick();
+}
+
+AnimationScheduler::Handle AnimationScheduler::add(lv_obj_t* obj, TickCallback callback, HiddenCallback hidden)
+{
+    Handle handle = nextHandle++;
+    if (nextHandle == INVALID_HANDLE)
+        nextHandle++;
+
+    // Entries are only appended between ticks, so callbacks are never moved while running
+    if (ticking)
+        added.push_back({handle, obj, std::move(callback), std::move(hidden), false, false});
+    else
+        entries.push_back({handle, obj, std::move(callback), std::move(hidden), false, false});
+    return handle;
+}
+
+void AnimationScheduler::remove(Handle handle)
+{
+    Entry* entry = find(handle);
+    if (!entry)
+        return;
+
+    if (ticking)
+    {
+        // Compacted at the end of the tick
+        entry->handle = INVALID_HANDLE;
+        entry->started = false;
+    }
+    else
+    {
+        entries.erase(entries.begin() + (entry - entries.data()));
+    }
+
+    updateTimer();
+}
+
+void AnimationScheduler::start(Handle handle)
+{
+    Entry* entry = find(handle);
+    if (!entry || entry->started)
+        return;
+
+    entry->started = true;
+    visibilityChecked = false;
+    updateTimer();
+}
+
+void AnimationScheduler::stop(Handle handle)
+{
+    Entry* entry = find(handle);
+    if (!entry || !entry->started)
+        return;
+
+    entry->started = false;
+    updateTimer();
+}
+
+bool AnimationScheduler::isStarted(Handle handle) const
+{
+    const Entry* entry = find(handle);
+    return entry && entry->started;
+}
+
+size_t AnimationScheduler::getActiveCount() const
+{
+    size_t count = 0;
+    for (const Entry& entry : entries)
+        count += entry.started;
+    for (const Entry& entry : added)
+        count += entry.started;
+    return count;
+}
+
+size_t AnimationScheduler::getRegisteredCount() const
+{
+    size_t count = added.size();
+    for (const Entry& entry : entries)
+        count += entry.handle != INVALID_HANDLE;
+    return count;
+}
+
+AnimationScheduler::Entry* AnimationScheduler::find(Handle handle)
+{
+    if (handle == INVALID_HANDLE)
+        return nullptr;
+
+    for (auto* list : {&entries, &added})
+    {
+        for (Entry& entry : *list)
+        {
+            if (entry.handle == handle)
+                return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const AnimationScheduler::Entry* AnimationScheduler::find(Handle handle) const
+{
+    return const_cast<AnimationScheduler*>(this)->find(handle);
+}
+
+void AnimationScheduler::updateTimer()
+{
+    // The tick re-evaluates on exit
+    if (ticking)
+        return;
+
+    bool active = getActiveCount() > 0;
+    if (!active)
+        visibleCount = 0;
+
+    // Started but all off-screen, like marquees on prewarmed tabs: wait for
+    // a render to bring them back instead of waking the loop every period
+    if (!active || (visibilityChecked && visibleCount == 0))
+    {
+        if (timer && !timerPaused)
+        {
+            lv_timer_pause(timer);
+            timerPaused = true;
+        }
+        return;
+    }
+
+    if (!timer)
+    {
+        timer = lv_timer_create(timerCb, LV_DEF_REFR_PERIOD, this);
+
+        lv_display_t* display = lv_display_get_default();
+        if (display)
+            lv_display_add_event_cb(display, renderStartCb, LV_EVENT_RENDER_START, this);
+        return;
+    }
+
+    if (timerPaused)
+    {
+        // First tick one period from now, like a freshly created timer
+        lv_timer_reset(timer);
+        lv_timer_resume(timer);
+        timerPaused = false;
+    }
+}
+
+void AnimationScheduler::tick()
+{
+    uint32_t nowMs = now();
+    size_t visible = 0;
+
+    ticking = true;
+    visibilityChecked = true;
+    for (Entry& entry : entries)
+    {
+        if (!entry.started)
+            continue;
+
+        // Off-screen animators keep their state and wait
+        if (entry.obj && !lv_obj_is_visible(entry.obj))
+        {
+            if (entry.visible && entry.hidden)
+                entry.hidden();
+            entry.visible = false;
+            continue;
+        }
+
+        entry.visible = true;
+        visible++;
+        if (!entry.callback(nowMs))
+            entry.started = false;
+    }
+    ticking = false;
+
+    std::move(added.begin(), added.end(), std::back_inserter(entries));
+    added.clear();
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const Entry& entry) { return entry.handle == INVALID_HANDLE; }),
+                  entries.end());
+
+    visibleCount = visible;
+    updateTimer();
+}
+
+void AnimationScheduler::timerCb(lv_timer_t* timer)
+{
+    static_cast<AnimationScheduler*>(lv_timer_get_user_data(timer))->tick();
+}
+
+void AnimationScheduler::renderStartCb(lv_event_t* e)
+{
+    AnimationScheduler* self = static_cast<AnimationScheduler*>(lv_event_get_user_data(e));
+    if (!self->timerPaused || self->getActiveCount() == 0)
+        return;
+
+    // Something changed on screen, a hidden animator may be visible again
+    self->visibilityChecked = false;
+    self->updateTimer();
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Shared clock for widget animations
+ *
+ * Instead of one LVGL timer per animator, animators register here and are
+ * advanced together by a single LVGL timer, all with the same timestamp
+ * (the smooth_ui_toolkit tick, in milliseconds).
+ *
+ * An animator is only ticked while it is started and its object is visible:
+ * animators on a hidden tab or under a page pushed on the StackView are
+ * skipped, and resume where they were when they come back on screen. When no
+ * animator is started, or none of the started ones is visible, the timer is
+ * paused, so a static screen costs nothing. Hidden animators only come back
+ * with a redraw (tab change, scroll, screen load), so a paused timer is
+ * resumed for one check on the next render of the display.
+ *
+ * The app drives a single display, so there is a single scheduler.
+ * All methods must be called from the LVGL context.
+ */
+class AnimationScheduler
+{
+public:
+    /**
+     * @brief Advance an animator
+     * @param nowMs Timestamp shared by all animators of this tick
+     * @return false once the animation is over, the animator is then stopped
+     */
+    using TickCallback = std::function<bool(uint32_t nowMs)>;
+
+    /**
+     * @brief Called when a started animator leaves the screen, to release
+     * what it only needs while visible
+     */
+    using HiddenCallback = std::function<void()>;
+
+    using Handle = uint32_t;
+    static const Handle INVALID_HANDLE = 0;
+
+    /**
+     * @brief Get singleton instance
+     */
+    static AnimationScheduler& getInstance();
+
+    /**
+     * @brief Register an animator, initially stopped
+     * @param obj Object whose visibility gates the ticks, nullptr for always
+     * @param callback Called on every tick while started
+     * @param hidden Called once when obj is no longer visible at a tick, optional
+     */
+    Handle add(lv_obj_t* obj, TickCallback callback, HiddenCallback hidden = nullptr);
+
+    /**
+     * @brief Unregister an animator, safe to call from its own callback
+     */
+    void remove(Handle handle);
+
+    /**
+     * @brief Start or stop ticking an animator
+     */
+    void start(Handle handle);
+    void stop(Handle handle);
+    bool isStarted(Handle handle) const;
+
+    /**
+     * @brief Current time of the animation clock in milliseconds
+     */
+    static uint32_t now();
+
+    /**
+     * @brief Number of started animators, and of those visible at the last tick
+     */
+    size_t getActiveCount() const;
+    size_t getVisibleCount() const { return visibleCount; }
+
+    size_t getRegisteredCount() const;
+
+private:
+    AnimationScheduler() = default;
+
+    AnimationScheduler(const AnimationScheduler&) = delete;
+    AnimationScheduler& operator=(const AnimationScheduler&) = delete;
+
+    struct Entry
+    {
+        Handle handle;
+        lv_obj_t* obj;
+        TickCallback callback;
+        HiddenCallback hidden;
+        bool started;
+        bool visible;  // At the last tick while started
+    };
+
+    Entry* find(Handle handle);
+    const Entry* find(Handle handle) const;
+    void updateTimer();
+    void tick();
+
+    static void timerCb(lv_timer_t* timer);
+    static void renderStartCb(lv_event_t* e);
+
+    std::vector<Entry> entries;
+    std::vector<Entry> added;  // Registered during a tick
+    lv_timer_t* timer = nullptr;
+    bool timerPaused = false;
+    Handle nextHandle = 1;
+    size_t visibleCount = 0;
+    bool visibilityChecked = false;  // No animator started since the last tick
+    bool ticking = false;
+};
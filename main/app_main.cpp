@@ -5,17 +5,25 @@
 #include "smooth_ui_toolkit.h"
 #include "../flux/flux.h"
 #include "provisioning_manager.h"
+#include "perf_hud.h"
+#include "ui_queue.h"
 
 #ifdef ESP_PLATFORM
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_timer.h"
 #else
+#include "linux/virtual_clock.h"
+#include "linux/event_loop.h"
 #include <iostream>
+#include <chrono>
 #endif
 
 static const char* TAG = "main";
 
+// Upper bound for a page flip, a display that stops flipping must not stall the loop
+static const uint32_t VSYNC_TIMEOUT_MS = 100;
+
 AppMain* g_appMain = nullptr;
 
 AppMain::AppMain():
@@ -59,6 +67,14 @@ bool AppMain::init()
     });
 
     ESP_LOGI(TAG, "Configured smooth_ui_toolkit HAL for ESP32");
+#else
+    // Headless runs: toolkit animations follow the virtual clock like LVGL does
+    if (VirtualClock::getInstance().isEnabled())
+    {
+        smooth_ui_toolkit::ui_hal::on_get_tick([]() -> uint32_t {
+            return static_cast<uint32_t>(VirtualClock::getInstance().nowMs());
+        });
+    }
 #endif
 
     logSystemInfo();
@@ -109,6 +125,14 @@ bool AppMain::initFast()
     });
 
     ESP_LOGI(TAG, "Configured smooth_ui_toolkit HAL for ESP32");
+#else
+    // Headless runs: toolkit animations follow the virtual clock like LVGL does
+    if (VirtualClock::getInstance().isEnabled())
+    {
+        smooth_ui_toolkit::ui_hal::on_get_tick([]() -> uint32_t {
+            return static_cast<uint32_t>(VirtualClock::getInstance().nowMs());
+        });
+    }
 #endif
 
     logSystemInfo();
@@ -152,19 +176,33 @@ void AppMain::run()
 
         hal->getDisplay().lock(0);
 
+        #ifndef ESP_PLATFORM
+        EventLoop::getInstance().resumeInput();
+        #endif
+
         if (loop_count < 5)
         {
             ESP_LOGD(TAG, "Main loop iteration %d - lock acquired, calling renderLoop", loop_count);
         }
 
+        // UI changes posted by other threads since the last frame
+        UiQueue::getInstance().drain();
+
         renderLoop();
         uint32_t timeMs = 5;
+        #ifndef ESP_PLATFORM
+        bool idle = false;
+        #endif
 
         loop_count++;
 
         #ifndef ESP_PLATFORM
         // On Linux, we need to handle LVGL timers ourselves
+        auto handlerStart = std::chrono::steady_clock::now();
         timeMs = lv_timer_handler();
+        auto handlerTime = std::chrono::steady_clock::now() - handlerStart;
+        PerfHud::getInstance().recordHandlerTime(
+            std::chrono::duration_cast<std::chrono::microseconds>(handlerTime).count());
 
         // Check if display is still valid (window not closed) - Linux only
         lv_display_t* disp = hal->getDisplay().getLvglDisplay();
@@ -181,13 +219,44 @@ void AppMain::run()
             running = false;
             break;
         }
+
+        // Nothing moving on screen: block until input, a UI change from another
+        // thread or the next LVGL timer. Headless runs keep stepping virtual time.
+        idle = !VirtualClock::getInstance().isEnabled() &&
+               !(stackView && stackView->hasRunningAnimations()) &&
+               !EventLoop::getInstance().isInputActive();
+        if (idle)
+        {
+            timeMs = EventLoop::getInstance().prepareWait();
+            // Posted after this frame's drain but before prepareWait(): that
+            // post saw no waiter, so don't block, draw it on the next frame
+            if (!UiQueue::getInstance().empty())
+                timeMs = 0;
+        }
         #endif
 
         hal->getDisplay().unlock();
 
-        // Ensure minimum delay to avoid watchdog issues
+        // Page flipping displays: start the next frame as soon as this one is on screen
+        bool flipped = hal->getDisplay().waitVsync(VSYNC_TIMEOUT_MS);
+
+        #ifndef ESP_PLATFORM
+        if (idle)
+        {
+            EventLoop::getInstance().wait(timeMs);
+            continue;
+        }
+        #endif
+
+        if (flipped)
+            continue;
+
+        // Ensure minimum delay to avoid watchdog issues, and keep polling
+        // at frame rate when LVGL has no timer scheduled
         if (timeMs < 1)
             timeMs = 1;
+        if (timeMs > LV_DEF_REFR_PERIOD)
+            timeMs = LV_DEF_REFR_PERIOD;
 
         hal->getSystem().delay(timeMs);
     }
@@ -226,6 +295,13 @@ void AppMain::createBasicUi()
     auto startupPage = std::make_unique<StartupPage>(lv_screen_active());
     stackView->push(std::move(startupPage));
 
+    PerfHud::getInstance().init(hal->getDisplay().getLvglDisplay());
+
+#ifndef ESP_PLATFORM
+    // A posted UI command ends an idle wait of the render loop
+    UiQueue::getInstance().setWakeup([]() { EventLoop::getInstance().wakeup(); });
+#endif
+
     hal->getDisplay().unlock();
 }
 
@@ -79,8 +79,8 @@ void CalaosDiscovery::startDiscovery()
 
     // Start UDP listening for responses
     auto& udpClient = CalaosNet::instance().udpClient();
-    NetworkResult result = udpClient.startReceiving(BCAST_UDP_PORT,
-        [this](NetworkResult result, const NetworkBuffer& data)
+    NetworkResult result = udpClient.startReceivingViews(BCAST_UDP_PORT,
+        [this](NetworkResult result, const NetworkBufferView& data)
         {
             onUdpDataReceived(result, data);
         });
@@ -188,7 +188,7 @@ void CalaosDiscovery::sendDiscoveryBroadcast()
     }
 }
 
-void CalaosDiscovery::onUdpDataReceived(NetworkResult result, const NetworkBuffer& data)
+void CalaosDiscovery::onUdpDataReceived(NetworkResult result, const NetworkBufferView& data)
 {
     if (result != NetworkResult::OK)
     {
@@ -209,7 +209,7 @@ void CalaosDiscovery::onUdpDataReceived(NetworkResult result, const NetworkBuffe
     }
 
     // Convert to string for easier processing
-    std::string message(reinterpret_cast<const char*>(data.data.data()), data.size);
+    std::string message(reinterpret_cast<const char*>(data.data), data.size);
 
     // Filter out our own broadcast messages
     if (message.substr(0, 15) == "CALAOS_DISCOVER")
@@ -23,7 +23,7 @@ public:
 private:
     void discoveryThread();
     void sendDiscoveryBroadcast();
-    void onUdpDataReceived(NetworkResult result, const NetworkBuffer& data);
+    void onUdpDataReceived(NetworkResult result, const NetworkBufferView& data);
     void onDiscoveryTimeout();
 
     std::atomic<bool> running_;
@@ -1,17 +1,55 @@
 #include "calaos_page.h"
 #include "theme.h"
 #include "app_main.h"
-#include "hal.h"
 #include "logging.h"
 #include "widget_factory.h"
+#include "perf_hud.h"
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#endif
 
 static const char* TAG = "CalaosPage";
 extern AppMain* g_appMain;
 
+// Pages on each side of the active one that are built ahead of a swipe
+static const int PREWARM_DISTANCE = 1;
+
+// Beyond this, the pages farthest from the active one are unloaded
+static const int MAX_LOADED_PAGES = 5;
+
+// Below this, every page outside the prewarm window is unloaded
+#ifdef ESP_PLATFORM
+static const size_t LOW_MEMORY_FREE_BYTES = 512 * 1024;
+#endif
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+static const uint8_t LOW_MEMORY_USED_PCT = 80;
+#endif
+
+static bool isMemoryLow()
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+    if (mem.used_pct >= LOW_MEMORY_USED_PCT)
+        return true;
+#endif
+
+#ifdef ESP_PLATFORM
+    return heap_caps_get_free_size(MALLOC_CAP_DEFAULT) < LOW_MEMORY_FREE_BYTES;
+#else
+    return false;
+#endif
+}
+
 CalaosPage::CalaosPage(lv_obj_t *parent):
     PageBase(parent),
     tabview(nullptr),
-    pageIndicatorContainer(nullptr)
+    pageIndicatorContainer(nullptr),
+    stateNotified_(false),
+    uiGuard_(UiQueue::makeGuard())
 {
     ESP_LOGI(TAG, "Creating CalaosPage");
 
@@ -22,7 +60,8 @@ CalaosPage::CalaosPage(lv_obj_t *parent):
     // Create tabview (pages will be added when config is received)
     createTabView();
 
-    // Subscribe to state changes
+    // Subscribe before reading the initial state, so a config dispatched
+    // while the pages are built is not lost
     subscriptionId_ = AppStore::getInstance().subscribe([this](const AppState& state)
     {
         onStateChanged(state);
@@ -30,28 +69,45 @@ CalaosPage::CalaosPage(lv_obj_t *parent):
 
     // Get initial state
     const AppState& initialState = AppStore::getInstance().getState();
-    lastWebSocketState = initialState.websocket;
-    lastConfigJson = "";
+    CalaosWebSocketState websocket = initialState.websocket;
+    CalaosProtocol::RemoteUIConfig config = initialState.config;
 
-    // Try to create pages from current config if available
-    if (!initialState.config.pages_json.empty())
+    CalaosProtocol::PagesConfig initialPages;
+    bool createPages = false;
     {
-        ESP_LOGI(TAG, "Initial config available, creating pages");
-        lastConfigJson = initialState.config.pages_json;
-        try
-        {
-            auto pagesConfig = initialState.config.getParsedPages();
-            createPagesFromConfig(pagesConfig);
-        }
-        catch (const std::exception& e)
+        flux::LockGuard lock(stateMutex_);
+
+        // Otherwise the dispatcher saw a newer state and posted the pages itself
+        if (!stateNotified_)
         {
-            ESP_LOGE(TAG, "Failed to parse initial config: %s", e.what());
+            lastWebSocketState = websocket;
+
+            // Try to create pages from current config if available
+            if (!config.pages_json.empty())
+            {
+                ESP_LOGI(TAG, "Initial config available, creating pages");
+                lastConfigJson = config.pages_json;
+                try
+                {
+                    initialPages = config.getParsedPages();
+                    lastPagesConfig = initialPages;
+                    createPages = true;
+                }
+                catch (const std::exception& e)
+                {
+                    ESP_LOGE(TAG, "Failed to parse initial config: %s", e.what());
+                }
+            }
+            else
+            {
+                ESP_LOGI(TAG, "No initial config, waiting for remote_ui_config_update");
+            }
         }
     }
-    else
-    {
-        ESP_LOGI(TAG, "No initial config, waiting for remote_ui_config_update");
-    }
+
+    // Built outside the lock, widgets read the AppStore
+    if (createPages)
+        createPagesFromConfig(initialPages);
 }
 
 CalaosPage::~CalaosPage()
@@ -60,6 +116,9 @@ CalaosPage::~CalaosPage()
 
     // Unsubscribe from AppStore to prevent dangling pointer
     AppStore::getInstance().unsubscribe(subscriptionId_);
+
+    // Nothing will reuse the pooled widgets until the next CalaosPage
+    WidgetFactory::getInstance().clearPool();
 }
 
 void CalaosPage::render()
@@ -79,6 +138,23 @@ void CalaosPage::render()
     }
 }
 
+bool CalaosPage::hasRunningAnimations()
+{
+    if (!tabview)
+        return false;
+
+    uint32_t currentTab = lv_tabview_get_tab_active(tabview);
+    if (currentTab >= pageWidgets.size())
+        return false;
+
+    for (auto& widget : pageWidgets[currentTab])
+    {
+        if (widget && widget->hasRunningAnimations())
+            return true;
+    }
+    return false;
+}
+
 void CalaosPage::createTabView()
 {
     // Create tabview using LVGL C API
@@ -95,6 +171,9 @@ void CalaosPage::createTabView()
     // Set up event callback for tab changes
     lv_obj_add_event_cb(tabview, tabViewEventCb, LV_EVENT_VALUE_CHANGED, this);
 
+    // Build pages that come into view before the tab change is settled
+    lv_obj_add_event_cb(lv_tabview_get_content(tabview), contentScrollEventCb, LV_EVENT_SCROLL, this);
+
     ESP_LOGI(TAG, "Tab view created");
 }
 
@@ -118,19 +197,21 @@ void CalaosPage::createPageIndicator(int numPages)
     lv_obj_set_style_border_width(pageIndicatorContainer, 0, LV_PART_MAIN);
     lv_obj_set_style_pad_all(pageIndicatorContainer, 0, LV_PART_MAIN);
 
-    // Create dots dynamically
-    lv_color_t inactiveColor = lv_color_make(0x66, 0x66, 0x66);
+    // Hidden gesture: long press on the indicator toggles the performance overlay
+    lv_obj_add_event_cb(pageIndicatorContainer, [](lv_event_t*) {
+        PerfHud::getInstance().toggle();
+    }, LV_EVENT_LONG_PRESSED, nullptr);
 
+    // Create dots dynamically
     pageIndicatorDots.clear();
     for (int i = 0; i < numPages; i++)
     {
         lv_obj_t* dot = lv_obj_create(pageIndicatorContainer);
         lv_obj_set_size(dot, 12, 12);
         lv_obj_set_pos(dot, i * 30 + 10, 4);
-        lv_obj_set_style_radius(dot, LV_RADIUS_CIRCLE, LV_PART_MAIN);
-        lv_obj_set_style_border_width(dot, 0, LV_PART_MAIN);
-        lv_obj_set_style_bg_color(dot, inactiveColor, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(dot, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_add_style(dot, &theme_styles().pageDot, LV_PART_MAIN);
+        lv_obj_add_style(dot, &theme_styles().pageDotActive, LV_STATE_CHECKED);
+        lv_obj_remove_flag(dot, LV_OBJ_FLAG_CLICKABLE);
 
         pageIndicatorDots.push_back(dot);
     }
@@ -146,19 +227,8 @@ void CalaosPage::updatePageIndicator(uint32_t activeTab)
     if (pageIndicatorDots.empty())
         return;
 
-    lv_color_t inactiveColor = lv_color_make(0x66, 0x66, 0x66);
-
     for (size_t i = 0; i < pageIndicatorDots.size(); i++)
-    {
-        if (i == activeTab)
-        {
-            lv_obj_set_style_bg_color(pageIndicatorDots[i], theme_color_blue, LV_PART_MAIN);
-        }
-        else
-        {
-            lv_obj_set_style_bg_color(pageIndicatorDots[i], inactiveColor, LV_PART_MAIN);
-        }
-    }
+        lv_obj_set_state(pageIndicatorDots[i], LV_STATE_CHECKED, i == activeTab);
 }
 
 void CalaosPage::tabViewEventCb(lv_event_t* e)
@@ -172,18 +242,115 @@ void CalaosPage::tabViewEventCb(lv_event_t* e)
     page->onTabChanged(activeTab);
 }
 
+void CalaosPage::contentScrollEventCb(lv_event_t* e)
+{
+    CalaosPage* page = static_cast<CalaosPage*>(lv_event_get_user_data(e));
+    if (page)
+        page->onContentScroll();
+}
+
 void CalaosPage::onTabChanged(uint32_t activeTab)
 {
     ESP_LOGI(TAG, "Tab changed to: %d", activeTab);
     updatePageIndicator(activeTab);
+
+    prewarmAround(activeTab);
+    evictPages(activeTab);
+}
+
+void CalaosPage::onContentScroll()
+{
+    if (pageLoaded.empty())
+        return;
+
+    // Neighbours are prewarmed, this only catches flings and jumps across
+    // several pages
+    lv_obj_t* content = lv_tabview_get_content(tabview);
+    int32_t pitch = lv_obj_get_content_width(content) + lv_obj_get_style_pad_column(content, LV_PART_MAIN);
+    if (pitch <= 0)
+        return;
+
+    int32_t scrollX = std::max<int32_t>(lv_obj_get_scroll_x(content), 0);
+    int last = static_cast<int>(pageLoaded.size()) - 1;
+    int first = std::min<int>(scrollX / pitch, last);
+    int next = std::min<int>((scrollX + pitch - 1) / pitch, last);
+
+    loadPage(first);
+    loadPage(next);
+}
+
+void CalaosPage::loadPage(int pageIndex)
+{
+    if (pageIndex < 0 || pageIndex >= static_cast<int>(pageLoaded.size()) || pageLoaded[pageIndex])
+        return;
+
+    createWidgetsForPage(pageIndex, pagesConfig.pages[pageIndex], gridInfo);
+    pageLoaded[pageIndex] = true;
+}
+
+void CalaosPage::unloadPage(int pageIndex)
+{
+    if (!pageLoaded[pageIndex])
+        return;
+
+    ESP_LOGI(TAG, "Unloading page %d", pageIndex);
+
+    // Widgets read their state back from the AppStore when reloaded
+    releaseWidgets(pageWidgets[pageIndex]);
+    lv_obj_clean(tabContent[pageIndex]);
+    pageLoaded[pageIndex] = false;
+}
+
+void CalaosPage::prewarmAround(int activeTab)
+{
+    loadPage(activeTab);
+    for (int distance = 1; distance <= PREWARM_DISTANCE; distance++)
+    {
+        loadPage(activeTab + distance);
+        loadPage(activeTab - distance);
+    }
+}
+
+void CalaosPage::evictPages(int activeTab)
+{
+    int loaded = std::count(pageLoaded.begin(), pageLoaded.end(), true);
+
+    while (loaded > 0)
+    {
+        if (loaded <= MAX_LOADED_PAGES && !isMemoryLow())
+            break;
+
+        // Farthest loaded page outside the prewarm window
+        int farthest = -1;
+        for (int i = 0; i < static_cast<int>(pageLoaded.size()); i++)
+        {
+            int distance = std::abs(i - activeTab);
+            if (pageLoaded[i] && distance > PREWARM_DISTANCE &&
+                (farthest < 0 || distance > std::abs(farthest - activeTab)))
+                farthest = i;
+        }
+
+        if (farthest < 0)
+            break;
+
+        unloadPage(farthest);
+        loaded--;
+    }
+
+    if (isMemoryLow())
+        WidgetFactory::getInstance().clearPool();
 }
 
 void CalaosPage::destroyPages()
 {
     ESP_LOGI(TAG, "Destroying existing pages");
 
-    // Clear widgets (unique_ptr auto-deletes)
+    // Release widgets before their tabs are deleted
+    for (auto& widgets : pageWidgets)
+        releaseWidgets(widgets);
     pageWidgets.clear();
+    pageLoaded.clear();
+    pagesConfig = CalaosProtocol::PagesConfig();
 
     // Delete page indicator
     if (pageIndicatorContainer)
@@ -201,6 +368,10 @@ void CalaosPage::destroyPages()
     }
     tabContent.clear();
 
+    // Each tab also added a button to the (hidden) tab bar
+    if (tabview)
+        lv_obj_clean(lv_tabview_get_tab_bar(tabview));
+
     ESP_LOGI(TAG, "Pages destroyed");
 }
 
@@ -216,14 +387,12 @@ void CalaosPage::createPagesFromConfig(const CalaosProtocol::PagesConfig& config
         ESP_LOGW(TAG, "No pages in config - creating empty placeholder");
         // Create one empty tab
         lv_obj_t* tab = lv_tabview_add_tab(tabview, "Empty");
-        lv_obj_set_style_bg_color(tab, theme_color_black, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(tab, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_add_style(tab, &theme_styles().page, LV_PART_MAIN);
 
         // Show "No pages configured" message
         lv_obj_t* label = lv_label_create(tab);
         lv_label_set_text(label, "No pages configured");
-        lv_obj_set_style_text_color(label, theme_color_white, 0);
-        lv_obj_set_style_text_font(label, &roboto_medium_24, 0);
+        lv_obj_add_style(label, theme_text_style(ThemeText::PageMessage), 0);
         lv_obj_align(label, LV_ALIGN_CENTER, 0, 0);
 
         tabContent.push_back(tab);
@@ -231,7 +400,6 @@ void CalaosPage::createPagesFromConfig(const CalaosProtocol::PagesConfig& config
     }
 
     // Calculate grid layout info
-    GridLayoutInfo gridInfo;
     gridInfo.gridWidth = config.grid_width;
     gridInfo.gridHeight = config.grid_height;
     gridInfo.screenWidth = 720;
@@ -244,30 +412,39 @@ void CalaosPage::createPagesFromConfig(const CalaosProtocol::PagesConfig& config
             gridInfo.gridWidth, gridInfo.gridHeight,
             gridInfo.cellWidth, gridInfo.cellHeight);
 
-    // Create tabs
-    for (int i = 0; i < numPages; i++)
-    {
-        char tabName[32];
-        snprintf(tabName, sizeof(tabName), "Page %d", i + 1);
-
-        lv_obj_t* tab = lv_tabview_add_tab(tabview, tabName);
-        tabContent.push_back(tab);
+    // Kept to build the other pages on demand
+    pagesConfig = config;
+    pageWidgets.resize(numPages);
+    pageLoaded.assign(numPages, false);
 
-        // Style tab
-        lv_obj_set_style_bg_color(tab, theme_color_black, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(tab, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(tab, 0, LV_PART_MAIN);
-
-        // Create widgets for this page
-        createWidgetsForPage(i, config.pages[i], gridInfo);
-    }
+    // Create tabs, only empty containers at this point
+    for (int i = 0; i < numPages; i++)
+        tabContent.push_back(addTab(i));
 
     // Create page indicator (only if > 1 page)
     createPageIndicator(numPages);
 
+    // Widgets for the active page and its neighbours, the rest on demand
+    int activeTab = std::min<int>(lv_tabview_get_tab_active(tabview), numPages - 1);
+    updatePageIndicator(activeTab);
+    prewarmAround(activeTab);
+
     ESP_LOGI(TAG, "Created %d page(s) successfully", numPages);
 }
 
+lv_obj_t* CalaosPage::addTab(int pageIndex)
+{
+    char tabName[32];
+    snprintf(tabName, sizeof(tabName), "Page %d", pageIndex + 1);
+
+    lv_obj_t* tab = lv_tabview_add_tab(tabview, tabName);
+
+    // Style tab
+    lv_obj_add_style(tab, &theme_styles().page, LV_PART_MAIN);
+
+    return tab;
+}
+
 void CalaosPage::createWidgetsForPage(int pageIndex,
                                      const CalaosProtocol::PageConfig& pageConfig,
                                      const GridLayoutInfo& gridInfo)
@@ -280,65 +457,220 @@ void CalaosPage::createWidgetsForPage(int pageIndex,
 
     for (const auto& widgetConfig : pageConfig.widgets)
     {
-        // Validate widget position
-        if (widgetConfig.x < 0 || widgetConfig.y < 0)
-        {
-            ESP_LOGW(TAG, "Invalid widget position: (%d,%d) - skipping",
-                    widgetConfig.x, widgetConfig.y);
-            continue;
-        }
+        auto widget = createWidget(tabContainer, widgetConfig, gridInfo);
+        if (widget)
+            widgets.push_back(std::move(widget));
+    }
+
+    pageWidgets[pageIndex] = std::move(widgets);
+
+    ESP_LOGI(TAG, "Page %d: created %zu widget(s)", pageIndex, pageWidgets[pageIndex].size());
+}
+
+std::unique_ptr<CalaosWidget> CalaosPage::createWidget(lv_obj_t* tabContainer,
+                                                      const CalaosProtocol::WidgetConfig& widgetConfig,
+                                                      const GridLayoutInfo& gridInfo)
+{
+    // Validate widget position
+    if (widgetConfig.x < 0 || widgetConfig.y < 0)
+    {
+        ESP_LOGW(TAG, "Invalid widget position: (%d,%d) - skipping",
+                widgetConfig.x, widgetConfig.y);
+        return nullptr;
+    }
+
+    if (widgetConfig.x + widgetConfig.w > gridInfo.gridWidth ||
+        widgetConfig.y + widgetConfig.h > gridInfo.gridHeight)
+    {
+        ESP_LOGW(TAG, "Widget out of bounds: pos(%d,%d) size(%dx%d) in grid(%dx%d) - skipping",
+                widgetConfig.x, widgetConfig.y,
+                widgetConfig.w, widgetConfig.h,
+                gridInfo.gridWidth, gridInfo.gridHeight);
+        return nullptr;
+    }
+
+    // Create widget via factory
+    auto widget = WidgetFactory::getInstance().createWidget(
+        tabContainer, widgetConfig, gridInfo
+    );
+
+    if (widget)
+    {
+        ESP_LOGI(TAG, "Created widget: type=%s, io_id=%s at (%d,%d)",
+                widgetConfig.type.c_str(), widgetConfig.io_id.c_str(),
+                widgetConfig.x, widgetConfig.y);
+    }
+    else
+    {
+        ESP_LOGE(TAG, "Failed to create widget: type=%s, io_id=%s",
+                widgetConfig.type.c_str(), widgetConfig.io_id.c_str());
+    }
+
+    return widget;
+}
+
+void CalaosPage::releaseWidgets(std::vector<std::unique_ptr<CalaosWidget>>& widgets)
+{
+    // Kept by the factory for the next widgets of the same type and size
+    for (auto& widget : widgets)
+        WidgetFactory::getInstance().releaseWidget(std::move(widget));
+    widgets.clear();
+}
+
+void CalaosPage::applyConfig(const CalaosProtocol::PagesConfig& config, const PagesConfigDiff& diff)
+{
+    // Placeholder and empty configs have no pages to patch
+    if (diff.gridChanged || pageLoaded.empty() || config.pages.empty())
+    {
+        destroyPages();
+        createPagesFromConfig(config);
+        return;
+    }
+
+    patchPages(config, diff);
+}
+
+void CalaosPage::patchPages(const CalaosProtocol::PagesConfig& config, const PagesConfigDiff& diff)
+{
+    int numPages = config.pages.size();
+    int oldNumPages = tabContent.size();
+    int oldActive = lv_tabview_get_tab_active(tabview);
+    int newActive = -1;
+
+    ESP_LOGI(TAG, "Patching pages: %d -> %d page(s), %zu removed",
+            oldNumPages, numPages, diff.removedPages.size());
+
+    // Take the old pages out, so scroll events raised while tabs are deleted
+    // and moved don't load pages from a half patched state
+    std::vector<lv_obj_t*> oldTabs = std::move(tabContent);
+    std::vector<std::vector<std::unique_ptr<CalaosWidget>>> oldWidgets = std::move(pageWidgets);
+    std::vector<bool> oldLoaded = std::move(pageLoaded);
+    tabContent.clear();
+    pageWidgets.clear();
+    pageLoaded.clear();
+
+    lv_obj_t* tabBar = lv_tabview_get_tab_bar(tabview);
+    for (int oldIndex : diff.removedPages)
+    {
+        releaseWidgets(oldWidgets[oldIndex]);
+        lv_obj_del(oldTabs[oldIndex]);
+
+        // Each tab has a button in the (hidden) tab bar
+        lv_obj_del(lv_obj_get_child(tabBar, -1));
+    }
+
+    std::vector<lv_obj_t*> tabs(numPages);
+    std::vector<std::vector<std::unique_ptr<CalaosWidget>>> widgets(numPages);
+    std::vector<bool> loaded(numPages, false);
 
-        if (widgetConfig.x + widgetConfig.w > gridInfo.gridWidth ||
-            widgetConfig.y + widgetConfig.h > gridInfo.gridHeight)
+    for (const PageDiff& page : diff.pages)
+    {
+        int i = page.newIndex;
+        if (page.isInserted())
         {
-            ESP_LOGW(TAG, "Widget out of bounds: pos(%d,%d) size(%dx%d) in grid(%dx%d) - skipping",
-                    widgetConfig.x, widgetConfig.y,
-                    widgetConfig.w, widgetConfig.h,
-                    gridInfo.gridWidth, gridInfo.gridHeight);
+            // Built on demand like any other page
+            tabs[i] = addTab(i);
             continue;
         }
 
-        // Create widget via factory
-        auto widget = WidgetFactory::getInstance().createWidget(
-            tabContainer, widgetConfig, gridInfo
-        );
+        tabs[i] = oldTabs[page.oldIndex];
+        widgets[i] = std::move(oldWidgets[page.oldIndex]);
+        loaded[i] = oldLoaded[page.oldIndex];
 
-        if (widget)
+        if (loaded[i] && page.hasWidgetChanges())
+            patchWidgets(tabs[i], page, widgets[i]);
+
+        if (page.oldIndex == oldActive)
+            newActive = i;
+    }
+
+    // Inserted tabs were appended, put every tab at its new position
+    for (int i = 0; i < numPages; i++)
+        lv_obj_move_to_index(tabs[i], i);
+
+    tabContent = std::move(tabs);
+    pageWidgets = std::move(widgets);
+    pageLoaded = std::move(loaded);
+    pagesConfig = config;
+
+    // Stay on the page that was shown, or the closest one if it is gone
+    if (newActive < 0)
+        newActive = std::min(oldActive, numPages - 1);
+    lv_tabview_set_active(tabview, newActive, LV_ANIM_OFF);
+
+    if (numPages != oldNumPages)
+    {
+        if (pageIndicatorContainer)
         {
-            widgets.push_back(std::move(widget));
-            ESP_LOGI(TAG, "Created widget: type=%s, io_id=%s at (%d,%d)",
-                    widgetConfig.type.c_str(), widgetConfig.io_id.c_str(),
-                    widgetConfig.x, widgetConfig.y);
+            lv_obj_del(pageIndicatorContainer);
+            pageIndicatorContainer = nullptr;
         }
+        pageIndicatorDots.clear();
+        createPageIndicator(numPages);
+    }
+    updatePageIndicator(newActive);
+
+    prewarmAround(newActive);
+    evictPages(newActive);
+}
+
+void CalaosPage::patchWidgets(lv_obj_t* tabContainer,
+                              const PageDiff& page,
+                              std::vector<std::unique_ptr<CalaosWidget>>& widgets)
+{
+    std::vector<CalaosProtocol::WidgetConfig> current;
+    current.reserve(widgets.size());
+    for (const auto& widget : widgets)
+        current.push_back(widget->getConfig());
+
+    WidgetPatch patch = WidgetPatch::compute(current, page, gridInfo.gridWidth, gridInfo.gridHeight);
+
+    for (const auto& move : patch.moved)
+        widgets[move.first]->moveTo(move.second);
+
+    // Released widgets can be reused by the created ones
+    std::vector<bool> released(widgets.size(), false);
+    for (int index : patch.released)
+        released[index] = true;
+
+    std::vector<std::unique_ptr<CalaosWidget>> kept;
+    for (size_t i = 0; i < widgets.size(); i++)
+    {
+        if (released[i])
+            WidgetFactory::getInstance().releaseWidget(std::move(widgets[i]));
         else
-        {
-            ESP_LOGE(TAG, "Failed to create widget: type=%s, io_id=%s",
-                    widgetConfig.type.c_str(), widgetConfig.io_id.c_str());
-        }
+            kept.push_back(std::move(widgets[i]));
     }
+    widgets = std::move(kept);
 
-    pageWidgets.push_back(std::move(widgets));
+    for (const auto& config : patch.created)
+    {
+        if (auto widget = createWidget(tabContainer, config, gridInfo))
+            widgets.push_back(std::move(widget));
+    }
 
-    ESP_LOGI(TAG, "Page %d: created %zu widget(s)", pageIndex, pageWidgets[pageIndex].size());
+    ESP_LOGI(TAG, "Page %d: %zu added, %zu removed, %zu moved, %zu resized",
+            page.newIndex, page.added.size(), page.removed.size(),
+            page.moved.size(), page.resized.size());
 }
 
 void CalaosPage::onStateChanged(const AppState& state)
 {
+    // Runs on the dispatcher thread: detect changes here and post the UI work
+    flux::LockGuard lock(stateMutex_);
+    stateNotified_ = true;
+
     // Check for disconnection
     if (!state.websocket.isConnected && lastWebSocketState.isConnected)
     {
         ESP_LOGI(TAG, "WebSocket disconnected - returning to StartupPage");
 
         // Pop this page from StackView
-        if (g_appMain && g_appMain->getStackView())
+        UiQueue::getInstance().post(uiGuard_, []()
         {
-            // Use display lock for thread safety
-            if (HAL::getInstance().getDisplay().tryLock(100))
-            {
+            if (g_appMain && g_appMain->getStackView())
                 g_appMain->getStackView()->pop(stack_animation_type::SlideVertical);
-                HAL::getInstance().getDisplay().unlock();
-            }
-        }
+        });
     }
 
     lastWebSocketState = state.websocket;
@@ -346,33 +678,46 @@ void CalaosPage::onStateChanged(const AppState& state)
     // Check for config updates
     if (state.config.pages_json != lastConfigJson && !state.config.pages_json.empty())
     {
-        ESP_LOGI(TAG, "Config changed, recreating pages");
+        bool firstConfig = lastConfigJson.empty();
         lastConfigJson = state.config.pages_json;
 
-        // Use display lock for UI updates
-        if (HAL::getInstance().getDisplay().tryLock(100))
+        try
         {
-            try
-            {
-                // Parse new config
-                auto pagesConfig = state.config.getParsedPages();
-
-                // Destroy old pages
-                destroyPages();
+            // Parse and diff the new config, off the render thread
+            auto pagesConfig = state.config.getParsedPages();
+            PagesConfigDiff diff = PagesConfigDiff::compute(lastPagesConfig, pagesConfig);
+            lastPagesConfig = pagesConfig;
 
-                // Create new pages
-                createPagesFromConfig(pagesConfig);
+            if (firstConfig)
+            {
+                ESP_LOGI(TAG, "First config, creating pages");
+                diff.gridChanged = true;
             }
-            catch (const std::exception& e)
+            else if (diff.isEmpty())
             {
-                ESP_LOGE(TAG, "Failed to parse/create pages from config: %s", e.what());
+                ESP_LOGI(TAG, "Config changed, layout unchanged");
+                return;
+            }
+            else
+            {
+                ESP_LOGI(TAG, "Config changed, patching pages");
             }
 
-            HAL::getInstance().getDisplay().unlock();
+            UiQueue::getInstance().post(uiGuard_, [this, pagesConfig, diff]()
+            {
+                try
+                {
+                    applyConfig(pagesConfig, diff);
+                }
+                catch (const std::exception& e)
+                {
+                    ESP_LOGE(TAG, "Failed to create pages from config: %s", e.what());
+                }
+            });
         }
-        else
+        catch (const std::exception& e)
         {
-            ESP_LOGW(TAG, "Failed to acquire display lock for config update");
+            ESP_LOGE(TAG, "Failed to parse config: %s", e.what());
         }
     }
 }
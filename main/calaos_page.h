@@ -5,6 +5,8 @@
 #include "lvgl/smooth_lvgl.h"
 #include "flux.h"
 #include "calaos_widget.h"
+#include "ui_queue.h"
+#include "pages_config_diff.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -15,6 +17,7 @@ public:
     CalaosPage(lv_obj_t *parent);
     ~CalaosPage();
     void render() override;
+    bool hasRunningAnimations() override;
 
 private:
     // Tab view (CHANGED: dynamic instead of fixed array)
@@ -28,10 +31,20 @@ private:
     // NEW: Widget storage per page
     std::vector<std::vector<std::unique_ptr<CalaosWidget>>> pageWidgets;
 
-    // State management
+    // Pages are built lazily: only the active page and its neighbours have
+    // widgets, the other tabs are empty containers until approached
+    CalaosProtocol::PagesConfig pagesConfig;
+    GridLayoutInfo gridInfo;
+    std::vector<bool> pageLoaded;
+
+    // State management, shared with the dispatcher thread under stateMutex_
+    flux::Mutex stateMutex_;
+    bool stateNotified_;  // The dispatcher already handled a state, newer than the initial one
     CalaosWebSocketState lastWebSocketState;
     std::string lastConfigJson;  // NEW: Detect config changes
+    CalaosProtocol::PagesConfig lastPagesConfig;  // Layout the next config is diffed against
     SubscriptionId subscriptionId_;  // NEW: Track AppStore subscription
+    UiQueue::Guard uiGuard_;  // Drops posted UI commands once the page is gone
 
     void createTabView();
     void createPageIndicator(int numPages);  // CHANGED: parameter numPages
@@ -40,12 +53,32 @@ private:
     // NEW: Dynamic page/widget management
     void destroyPages();
     void createPagesFromConfig(const CalaosProtocol::PagesConfig& config);
+    lv_obj_t* addTab(int pageIndex);
     void createWidgetsForPage(int pageIndex,
                              const CalaosProtocol::PageConfig& pageConfig,
                              const GridLayoutInfo& gridInfo);
+    std::unique_ptr<CalaosWidget> createWidget(lv_obj_t* tabContainer,
+                                               const CalaosProtocol::WidgetConfig& widgetConfig,
+                                               const GridLayoutInfo& gridInfo);
+    void releaseWidgets(std::vector<std::unique_ptr<CalaosWidget>>& widgets);
+
+    // Incremental config updates
+    void applyConfig(const CalaosProtocol::PagesConfig& config, const PagesConfigDiff& diff);
+    void patchPages(const CalaosProtocol::PagesConfig& config, const PagesConfigDiff& diff);
+    void patchWidgets(lv_obj_t* tabContainer,
+                      const PageDiff& page,
+                      std::vector<std::unique_ptr<CalaosWidget>>& widgets);
+
+    // Lazy page management
+    void loadPage(int pageIndex);
+    void unloadPage(int pageIndex);
+    void prewarmAround(int activeTab);
+    void evictPages(int activeTab);
+    void onContentScroll();
 
     void onStateChanged(const AppState& state);
     void onTabChanged(uint32_t activeTab);
 
     static void tabViewEventCb(lv_event_t* e);
+    static void contentScrollEventCb(lv_event_t* e);
 };
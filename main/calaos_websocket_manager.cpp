@@ -6,6 +6,7 @@
 #include "../hal/hal.h"
 #include <nlohmann/json.hpp>
 #include <sstream>
+#include <algorithm>
 
 using json = nlohmann::json;
 
@@ -24,6 +25,9 @@ static const int HTTP_TOO_MANY_REQUESTS = 429;
 static const int WS_CLOSE_UNAUTHORIZED = 4001;
 static const int WS_CLOSE_FORBIDDEN = 4003;
 
+// A set_state command still queued after this long is stale and dropped
+static const uint32_t SET_STATE_TTL_MS = 3000;
+
 // Helper function to parse authentication error from JSON response
 // Server returns: {"error": "invalid_token", "status": "authentication_failed"}
 static WebSocketAuthErrorType parseAuthErrorType(const std::string& errorString)
@@ -87,12 +91,24 @@ static bool parseAuthErrorResponse(const std::string& responseBody, std::string&
 CalaosWebSocketManager::CalaosWebSocketManager():
     currentState_(WebSocketState::DISCONNECTED),
     isConnecting_(false),
-    consecutiveHandshakeErrors_(0)
+    consecutiveHandshakeErrors_(0),
+    subscriptionId_(0),
+    lastNetworkConnected_(false),
+    lastLinkStats_{0, 0, 0}
 {
+    const AppState& state = AppStore::getInstance().getState();
+    lastNetworkConnected_ = state.network.isConnected;
+    lastNetworkIp_ = state.network.ipAddress;
+
+    subscriptionId_ = AppStore::getInstance().subscribe([this](const AppState& appState)
+    {
+        onAppStateChanged(appState);
+    });
 }
 
 CalaosWebSocketManager::~CalaosWebSocketManager()
 {
+    AppStore::getInstance().unsubscribe(subscriptionId_);
     disconnect();
 }
 
@@ -160,11 +176,12 @@ bool CalaosWebSocketManager::connect()
     config.pong_timeout_ms = 10000;
     config.verify_ssl = false;  // TODO: Support SSL verification
     config.auto_reconnect = true;
-    config.reconnect_delay_ms = 5000;
-    config.max_reconnect_attempts = 5;
+    config.reconnect_delay_ms = 1000;
+    config.max_reconnect_delay_ms = 30000;
+    config.max_reconnect_attempts = 0;  // Keep retrying, the remote has nothing else to do
 
     // Set callbacks
-    wsClient.setMessageCallback([this](const WebSocketMessage& msg)
+    wsClient.setMessageViewCallback([this](const WebSocketMessageView& msg)
     {
         onMessage(msg);
     });
@@ -184,6 +201,11 @@ bool CalaosWebSocketManager::connect()
         onError(error, message);
     });
 
+    wsClient.setLinkStatsCallback([this](const WebSocketLinkStats& stats)
+    {
+        onLinkStats(stats);
+    });
+
     // Set reconnect config callback to regenerate auth headers on each reconnection
     // This ensures fresh nonce/timestamp are used, avoiding "nonce reuse" errors
     wsClient.setReconnectConfigCallback([this, config]() -> WebSocketConfig
@@ -250,8 +272,16 @@ bool CalaosWebSocketManager::setIoState(const std::string& io_id, const std::str
         std::string message = j.dump();
         ESP_LOGD(TAG, "Sending IO state: %s", message.c_str());
 
+        // User commands go first. A newer command for the same IO replaces a
+        // queued one, and a command that could not leave within a few seconds
+        // is dropped rather than replayed late.
+        WebSocketSendOptions options;
+        options.priority = WebSocketPriority::HIGH;
+        options.ttl_ms = SET_STATE_TTL_MS;
+        options.replace_key = "set_state:" + io_id;
+
         WebSocketClient& wsClient = CalaosNet::instance().webSocketClient();
-        NetworkResult result = wsClient.sendJson(message);
+        NetworkResult result = wsClient.sendJson(message, options);
 
         return result == NetworkResult::OK;
     }
@@ -278,8 +308,11 @@ bool CalaosWebSocketManager::requestConfig()
         std::string message = j.dump();
         ESP_LOGD(TAG, "Requesting config");
 
+        WebSocketSendOptions options;
+        options.replace_key = CalaosProtocol::MSG_GET_CONFIG;
+
         WebSocketClient& wsClient = CalaosNet::instance().webSocketClient();
-        NetworkResult result = wsClient.sendJson(message);
+        NetworkResult result = wsClient.sendJson(message, options);
 
         return result == NetworkResult::OK;
     }
@@ -326,13 +359,14 @@ std::map<std::string, std::string> CalaosWebSocketManager::buildAuthHeaders()
     return headers;
 }
 
-void CalaosWebSocketManager::onMessage(const WebSocketMessage& message)
+void CalaosWebSocketManager::onMessage(const WebSocketMessageView& message)
 {
-    ESP_LOGD(TAG, "Received message: %s", message.data.c_str());
+    ESP_LOGD(TAG, "Received message: %.*s", (int)message.data.size(), message.data.data());
 
     try
     {
-        json j = json::parse(message.data);
+        // Parse straight from the receive buffer, no intermediate copy
+        json j = json::parse(message.data.begin(), message.data.end());
 
         if (!j.contains("msg"))
         {
@@ -363,6 +397,11 @@ void CalaosWebSocketManager::onMessage(const WebSocketMessage& message)
     }
 }
 
+void CalaosWebSocketManager::injectMessage(std::string_view payload)
+{
+    onMessage(WebSocketMessageView(payload, WebSocketOpcode::TEXT));
+}
+
 void CalaosWebSocketManager::onStateChanged(WebSocketState state)
 {
     ESP_LOGI(TAG, "State changed: %d", static_cast<int>(state));
@@ -389,6 +428,60 @@ void CalaosWebSocketManager::onStateChanged(WebSocketState state)
     }
 }
 
+void CalaosWebSocketManager::onLinkStats(const WebSocketLinkStats& stats)
+{
+    WebSocketLinkStatsData data;
+    data.rttMs = stats.smoothed_rtt_ms;
+    data.jitterMs = stats.jitter_ms;
+    data.lossPercent = static_cast<uint8_t>(stats.loss * 100.0f + 0.5f);
+
+    // Every store update copies the whole AppState and wakes all subscribers,
+    // so only forward changes that matter
+    auto differs = [](uint32_t a, uint32_t b)
+    {
+        uint32_t delta = a > b ? a - b : b - a;
+        return delta >= 5 && delta * 10 >= std::max(a, b);
+    };
+
+    if (!differs(data.rttMs, lastLinkStats_.rttMs) &&
+        !differs(data.jitterMs, lastLinkStats_.jitterMs) &&
+        data.lossPercent == lastLinkStats_.lossPercent &&
+        lastLinkStats_.rttMs != 0)
+    {
+        return;
+    }
+
+    lastLinkStats_ = data;
+    AppDispatcher::getInstance().dispatch(AppEvent(AppEventType::WebSocketLinkStatsUpdated, data));
+}
+
+void CalaosWebSocketManager::onAppStateChanged(const AppState& state)
+{
+    bool changed = state.network.isConnected != lastNetworkConnected_ ||
+                   state.network.ipAddress != lastNetworkIp_;
+
+    lastNetworkConnected_ = state.network.isConnected;
+    lastNetworkIp_ = state.network.ipAddress;
+
+    if (!changed)
+    {
+        return;
+    }
+
+    WebSocketClient& wsClient = CalaosNet::instance().webSocketClient();
+
+    if (isConnected())
+    {
+        // A roam or DHCP renewal can leave a half-open TCP connection behind
+        wsClient.notifyNetworkChanged();
+    }
+    else if (state.network.isConnected && !state.network.ipAddress.empty())
+    {
+        // Link is back (NetworkIpAssigned/NetworkStatusChanged), don't sit out the backoff
+        wsClient.reconnectNow();
+    }
+}
+
 void CalaosWebSocketManager::onClose(int code, const std::string& reason)
 {
     ESP_LOGI(TAG, "Connection closed: code=%d, reason=%s", code, reason.c_str());
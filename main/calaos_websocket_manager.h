@@ -2,9 +2,11 @@
 
 #include "calaos_protocol.h"
 #include "calaos_net.h"
+#include "app_store.h"
 #include <nlohmann/json.hpp>
 #include <memory>
 #include <string>
+#include <string_view>
 
 // Global pointer to WebSocket manager instance (set by StartupPage)
 extern class CalaosWebSocketManager* g_wsManager;
@@ -59,6 +61,14 @@ public:
      */
     bool requestConfig();
 
+    /**
+     * @brief Process a raw server message as if received on the WebSocket
+     * @param payload JSON text ({"msg": ..., "data": ...})
+     *
+     * Lets replay and benchmark tools drive the UI without a server.
+     */
+    void injectMessage(std::string_view payload);
+
 private:
     /**
      * @brief Build WebSocket URL from server URL
@@ -76,13 +86,24 @@ private:
     /**
      * @brief WebSocket message callback
      */
-    void onMessage(const WebSocketMessage& message);
+    void onMessage(const WebSocketMessageView& message);
 
     /**
      * @brief WebSocket state change callback
      */
     void onStateChanged(WebSocketState state);
 
+    /**
+     * @brief Link quality callback, forwards RTT/jitter/loss to the store
+     */
+    void onLinkStats(const WebSocketLinkStats& stats);
+
+    /**
+     * @brief Watch network state: probe the link on changes while connected,
+     * reconnect immediately when the network comes back while disconnected
+     */
+    void onAppStateChanged(const AppState& state);
+
     /**
      * @brief WebSocket close callback
      */
@@ -126,4 +147,9 @@ private:
     WebSocketState currentState_;
     bool isConnecting_;
     int consecutiveHandshakeErrors_;  // Track consecutive handshake failures
+
+    SubscriptionId subscriptionId_;
+    bool lastNetworkConnected_;
+    std::string lastNetworkIp_;
+    WebSocketLinkStatsData lastLinkStats_;  // Last values dispatched to the store
 };
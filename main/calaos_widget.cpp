@@ -1,17 +1,23 @@
 #include "calaos_widget.h"
 #include "calaos_websocket_manager.h"
-#include "hal.h"
+#include "theme.h"
 #include "logging.h"
 
 static const char* TAG = "widget";
 
+// Guards notifiedState_ of all widgets, the dispatcher notifies them one at a time
+static flux::Mutex notifyMutex;
+
 CalaosWidget::CalaosWidget(lv_obj_t* parent,
                            const CalaosProtocol::WidgetConfig& config,
                            const GridLayoutInfo& gridInfo):
     Container(parent),
     config(config),
     gridInfo(gridInfo),
-    subscriptionId_(0)
+    subscriptionId_(0),
+    stateNotified_(false),
+    uiGuard_(UiQueue::makeGuard()),
+    factoryKey_(0)
 {
     ESP_LOGI(TAG, "Creating widget: type=%s, io_id=%s, pos=(%d,%d), size=(%dx%d)",
             config.type.c_str(), config.io_id.c_str(),
@@ -20,14 +26,25 @@ CalaosWidget::CalaosWidget(lv_obj_t* parent,
     // Calculate and apply grid-based position
     calculateAndApplyPosition();
 
-    // Set default styling
-    setBgOpa(LV_OPA_COVER);
-    setPadding(0, 0, 0, 0);
+    // Shared card styling, the ON colors apply with LV_STATE_CHECKED
+    const ThemeStyles& styles = theme_styles();
+    lv_obj_add_style(get(), &styles.widget, LV_PART_MAIN);
+    lv_obj_add_style(get(), &styles.widgetOn, LV_STATE_CHECKED);
 
-    // Subscribe to state changes
+    // Subscribe to state changes and get initial state from AppStore
     subscribeToStateChanges();
+}
+
+CalaosWidget::~CalaosWidget()
+{
+    ESP_LOGI(TAG, "Destroying widget: %s", config.io_id.c_str());
 
-    // Try to get initial state from AppStore
+    // Unsubscribe from AppStore to prevent dangling pointer
+    AppStore::getInstance().unsubscribe(subscriptionId_);
+}
+
+void CalaosWidget::loadInitialState()
+{
     const AppState& state = AppStore::getInstance().getState();
     auto it = state.ioStates.find(config.io_id);
     if (it != state.ioStates.end())
@@ -39,7 +56,8 @@ CalaosWidget::CalaosWidget(lv_obj_t* parent,
     else
     {
         ESP_LOGW(TAG, "Widget %s: IO state not found in AppStore", config.io_id.c_str());
-        // Set default state
+        // Set default state, nothing left from a previous IO
+        currentState = CalaosProtocol::IoState();
         currentState.id = config.io_id;
         currentState.type = config.type;
         currentState.state = "unknown";
@@ -47,12 +65,43 @@ CalaosWidget::CalaosWidget(lv_obj_t* parent,
     }
 }
 
-CalaosWidget::~CalaosWidget()
+void CalaosWidget::release(lv_obj_t* pool)
 {
-    ESP_LOGI(TAG, "Destroying widget: %s", config.io_id.c_str());
+    ESP_LOGI(TAG, "Releasing widget: %s", config.io_id.c_str());
 
-    // Unsubscribe from AppStore to prevent dangling pointer
     AppStore::getInstance().unsubscribe(subscriptionId_);
+    subscriptionId_ = 0;
+
+    // Updates already posted for this IO are dropped
+    uiGuard_ = UiQueue::makeGuard();
+
+    onRelease();
+    lv_obj_set_parent(get(), pool);
+}
+
+void CalaosWidget::rebind(lv_obj_t* parent,
+                          const CalaosProtocol::WidgetConfig& newConfig,
+                          const GridLayoutInfo& newGridInfo)
+{
+    ESP_LOGI(TAG, "Rebinding widget: type=%s, io_id=%s -> %s",
+            newConfig.type.c_str(), config.io_id.c_str(), newConfig.io_id.c_str());
+
+    config = newConfig;
+    gridInfo = newGridInfo;
+
+    lv_obj_set_parent(get(), parent);
+    lv_obj_remove_state(get(), static_cast<lv_state_t>(LV_STATE_PRESSED | LV_STATE_CHECKED));
+    calculateAndApplyPosition();
+
+    subscribeToStateChanges();
+    onRebind();
+}
+
+void CalaosWidget::moveTo(const CalaosProtocol::WidgetConfig& newConfig)
+{
+    config.x = newConfig.x;
+    config.y = newConfig.y;
+    calculateAndApplyPosition();
 }
 
 void CalaosWidget::calculateAndApplyPosition()
@@ -75,15 +124,31 @@ void CalaosWidget::calculateAndApplyPosition()
 
 void CalaosWidget::subscribeToStateChanges()
 {
-    // Subscribe to AppStore state changes
+    {
+        flux::LockGuard lock(notifyMutex);
+        notifiedState_ = CalaosProtocol::IoState();
+        stateNotified_ = false;
+    }
+
+    // Subscribe first, so an update dispatched while the initial state is
+    // read is not lost
     subscriptionId_ = AppStore::getInstance().subscribe([this](const AppState& appState)
     {
         onAppStateChanged(appState);
     });
+
+    loadInitialState();
+
+    // Otherwise a newer state is already posted and will replace currentState
+    flux::LockGuard lock(notifyMutex);
+    if (!stateNotified_)
+        notifiedState_ = currentState;
 }
 
 void CalaosWidget::onAppStateChanged(const AppState& appState)
 {
+    // Runs on the dispatcher thread: only changes of our IO reach the render thread
+
     // Find our IO state in the map
     auto it = appState.ioStates.find(config.io_id);
     if (it == appState.ioStates.end())
@@ -94,40 +159,43 @@ void CalaosWidget::onAppStateChanged(const AppState& appState)
 
     const CalaosProtocol::IoState& newState = it->second;
 
+    flux::LockGuard lock(notifyMutex);
+
     // Check if state actually changed
-    if (newState.state == currentState.state &&
-        newState.name == currentState.name &&
-        newState.enabled == currentState.enabled &&
-        newState.visible == currentState.visible)
+    if (newState.state == notifiedState_.state &&
+        newState.name == notifiedState_.name &&
+        newState.enabled == notifiedState_.enabled &&
+        newState.visible == notifiedState_.visible)
     {
         // No change
         return;
     }
 
+    notifiedState_ = newState;
+    stateNotified_ = true;
+
+    UiQueue::getInstance().post(uiGuard_, [this, newState]()
+    {
+        applyState(newState);
+    });
+}
+
+void CalaosWidget::applyState(const CalaosProtocol::IoState& newState)
+{
     // Update current state
     currentState = newState;
 
     ESP_LOGI(TAG, "Widget %s state update: %s", config.io_id.c_str(), newState.state.c_str());
 
-    // Acquire display lock before updating UI
-    if (HAL::getInstance().getDisplay().tryLock(100))
+    try
     {
-        try
-        {
-            // Call child implementation to update UI
-            onStateUpdate(newState);
-        }
-        catch (const std::exception& e)
-        {
-            ESP_LOGE(TAG, "Exception in onStateUpdate for %s: %s",
-                    config.io_id.c_str(), e.what());
-        }
-
-        HAL::getInstance().getDisplay().unlock();
+        // Call child implementation to update UI
+        onStateUpdate(newState);
     }
-    else
+    catch (const std::exception& e)
     {
-        ESP_LOGW(TAG, "Failed to acquire display lock for widget %s update", config.io_id.c_str());
+        ESP_LOGE(TAG, "Exception in onStateUpdate for %s: %s",
+                config.io_id.c_str(), e.what());
     }
 }
 
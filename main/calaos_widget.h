@@ -4,6 +4,7 @@
 #include "lvgl/smooth_lvgl.h"
 #include "calaos_protocol.h"
 #include "app_store.h"
+#include "ui_queue.h"
 #include <string>
 #include <memory>
 #include <functional>
@@ -29,7 +30,7 @@ struct GridLayoutInfo
  * - Grid-based positioning and sizing
  * - AppStore subscription for IO state updates
  * - Sending state changes via WebSocket
- * - Thread-safe UI updates with display lock
+ * - UI updates posted through UiQueue and applied on the LVGL thread
  */
 class CalaosWidget : public smooth_ui_toolkit::lvgl_cpp::Container
 {
@@ -56,13 +57,37 @@ public:
      */
     const std::string& getIoId() const { return config.io_id; }
 
+    /**
+     * @brief Move the widget to another cell of the grid, keeping its size
+     * @param newConfig Widget configuration with the new position
+     */
+    void moveTo(const CalaosProtocol::WidgetConfig& newConfig);
+
     /**
      * @brief Called from page render loop to update animations
      * Child classes override this to update their animations
      */
     virtual void render() {}
 
+    /**
+     * @brief True while render() has animations to advance
+     */
+    virtual bool hasRunningAnimations() { return false; }
+
 protected:
+    /**
+     * @brief Called when the widget is released to the WidgetFactory pool
+     * Child classes override this to stop their animations
+     */
+    virtual void onRelease() {}
+
+    /**
+     * @brief Called when a pooled widget is bound to a new config and IO
+     * currentState already holds the state of the new IO. Child classes
+     * override this to reset their UI as the constructor sets it up.
+     */
+    virtual void onRebind() { onStateUpdate(currentState); }
+
     /**
      * @brief Send state change to server (called by child classes)
      * @param newState New state value
@@ -84,22 +109,58 @@ protected:
     CalaosProtocol::IoState currentState;
 
 private:
+    friend class WidgetFactory;
+
+    /**
+     * @brief Detach from the IO and move under pool (WidgetFactory)
+     */
+    void release(lv_obj_t* pool);
+
+    /**
+     * @brief Bind a released widget to a new config and IO (WidgetFactory)
+     */
+    void rebind(lv_obj_t* parent,
+                const CalaosProtocol::WidgetConfig& newConfig,
+                const GridLayoutInfo& newGridInfo);
+
     /**
      * @brief Calculate pixel position from grid coordinates and apply to widget
      */
     void calculateAndApplyPosition();
 
     /**
-     * @brief Subscribe to AppStore state changes
+     * @brief Load the IO state from the AppStore, or a default one
+     */
+    void loadInitialState();
+
+    /**
+     * @brief Subscribe to AppStore state changes, then load the initial state
      */
     void subscribeToStateChanges();
 
     /**
-     * @brief Called when AppStore state changes
+     * @brief Called when AppStore state changes (dispatcher thread)
      * @param appState New application state
      */
     void onAppStateChanged(const AppState& appState);
 
+    /**
+     * @brief Apply a new IO state to the UI (render thread)
+     * @param newState New IO state
+     */
+    void applyState(const CalaosProtocol::IoState& newState);
+
     // Subscription ID for unsubscribing
     SubscriptionId subscriptionId_;
+
+    // Last state posted to the render thread, shared with the dispatcher
+    // thread under the notify lock
+    CalaosProtocol::IoState notifiedState_;
+    bool stateNotified_;  // Set once the dispatcher posted a state since subscribing
+
+    // Drops posted updates once the widget is destroyed or released
+    UiQueue::Guard uiGuard_;
+
+    // Type and size in the WidgetFactory pool, 0 if not pooled
+    uint32_t factoryKey_;
 };
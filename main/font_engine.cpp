@@ -0,0 +1,451 @@
+#include "font_engine.h"
+#include "logging.h"
+#include "misc/cache/lv_cache.h"
+#include "misc/cache/lv_cache_private.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+static const char* TAG = "FontEngine";
+
+FontEngine& FontEngine::getInstance()
+{
+    static FontEngine instance;
+    return instance;
+}
+
+extern "C" const lv_font_t* font_engine_default(void)
+{
+    // LVGL asks for the default font on every style lookup without a font
+    static const lv_font_t* font = FontEngine::get(FontWeight::Regular, 24);
+    return font;
+}
+
+#if CALAOS_RUNTIME_FONTS
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_HEAP_FACTOR_SIZE_32 50
+#define STBTT_HEAP_FACTOR_SIZE_128 20
+#define STBTT_HEAP_FACTOR_SIZE_DEFAULT 10
+#include "libs/tiny_ttf/stb_truetype_htcw.h"
+
+// Embedded by cmake/embed_file.cmake
+extern "C" const uint8_t roboto_light_ttf[];
+extern "C" const uint8_t roboto_regular_ttf[];
+extern "C" const uint8_t roboto_medium_ttf[];
+extern "C" const uint8_t roboto_bold_ttf[];
+
+// Characters of the prebaked fonts: ASCII, Latin-1 and Latin Extended-A.
+// Their metrics are computed with the font, they also set its line height.
+static const uint32_t LATIN_FIRST = 0x20;
+static const uint32_t LATIN_LAST = 0x17F;
+
+static bool isLatin(uint32_t letter)
+{
+    return letter >= LATIN_FIRST && letter <= LATIN_LAST &&
+           (letter < 0x80 || letter >= 0xA0);
+}
+
+// Room for the largest glyphs, a smaller cache would fail to draw them
+static const size_t MIN_CACHE_BYTES = 16 * 1024;
+
+// Kerning pairs remembered per font before starting over
+static const size_t MAX_KERNING_PAIRS = 4096;
+
+struct FontEngine::Face
+{
+    stbtt_fontinfo info;
+    const uint8_t* data;
+};
+
+struct FontEngine::GlyphMetrics
+{
+    int index = 0;  // 0 when the font has no glyph for the letter
+    int advance = 0;  // In font units
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = 0;
+    int y1 = 0;
+};
+
+struct FontEngine::Font
+{
+    lv_font_t font = {};
+    Face* face = nullptr;
+    float scale = 0;
+    GlyphMetrics latin[LATIN_LAST - LATIN_FIRST + 1];
+
+    std::mutex kerningMutex;
+    std::unordered_map<uint32_t, int> kerning;  // Glyph pair to font units
+
+    GlyphMetrics metrics(uint32_t letter) const
+    {
+        if (isLatin(letter))
+            return latin[letter - LATIN_FIRST];
+
+        GlyphMetrics m;
+        m.index = stbtt_FindGlyphIndex(&face->info, letter);
+        if (m.index)
+        {
+            stbtt_GetGlyphHMetrics(&face->info, m.index, &m.advance, nullptr);
+            stbtt_GetGlyphBitmapBox(&face->info, m.index, scale, scale, &m.x0, &m.y0, &m.x1, &m.y1);
+        }
+        return m;
+    }
+
+    int kern(int left, int right)
+    {
+        uint32_t key = (uint32_t)left << 16 | (uint32_t)right;
+
+        std::lock_guard<std::mutex> lock(kerningMutex);
+        auto it = kerning.find(key);
+        if (it != kerning.end())
+            return it->second;
+
+        if (kerning.size() >= MAX_KERNING_PAIRS)
+            kerning.clear();
+
+        int value = stbtt_GetGlyphKernAdvance(&face->info, left, right);
+        kerning.emplace(key, value);
+        return value;
+    }
+};
+
+// Cache node: bitmaps of all fonts in one LRU, evicted by size
+struct FontEngine::GlyphEntry
+{
+    lv_cache_slot_size_t slot;  // Must come first
+    const Font* font;
+    uint32_t glyph;
+    lv_draw_buf_t* bitmap;
+};
+
+struct FontEngine::Callbacks
+{
+    static bool getGlyphDsc(const lv_font_t* font, lv_font_glyph_dsc_t* dsc,
+                            uint32_t letter, uint32_t letterNext);
+    static const void* getGlyphBitmap(lv_font_glyph_dsc_t* dsc, lv_draw_buf_t* drawBuf);
+    static void releaseGlyph(const lv_font_t* font, lv_font_glyph_dsc_t* dsc);
+
+    static bool cacheCreate(GlyphEntry* entry, void* userData);
+    static void cacheFree(GlyphEntry* entry, void* userData);
+    static lv_cache_compare_res_t cacheCompare(const GlyphEntry* a, const GlyphEntry* b);
+};
+
+FontEngine::Face* FontEngine::getFace(FontWeight weight)
+{
+    int i = (int)weight;
+    if (faces[i])
+        return faces[i].get();
+
+    static const uint8_t* const files[] = {
+        roboto_light_ttf,
+        roboto_regular_ttf,
+        roboto_medium_ttf,
+        roboto_bold_ttf,
+    };
+
+    auto face = std::make_unique<Face>();
+    face->data = files[i];
+    if (!stbtt_InitFont(&face->info, face->data, stbtt_GetFontOffsetForIndex(face->data, 0)))
+    {
+        ESP_LOGE(TAG, "Failed to parse embedded font %d", i);
+        return nullptr;
+    }
+
+    faces[i] = std::move(face);
+    return faces[i].get();
+}
+
+lv_cache_t* FontEngine::getCache()
+{
+    if (cache)
+        return cache;
+
+    lv_cache_ops_t ops = {};
+    ops.compare_cb = (lv_cache_compare_cb_t)Callbacks::cacheCompare;
+    ops.create_cb = (lv_cache_create_cb_t)Callbacks::cacheCreate;
+    ops.free_cb = (lv_cache_free_cb_t)Callbacks::cacheFree;
+
+    cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(GlyphEntry), cacheLimit, ops);
+    lv_cache_set_name(cache, "FONT_ENGINE_GLYPHS");
+    return cache;
+}
+
+const lv_font_t* FontEngine::getFont(FontWeight weight, int size)
+{
+    int key = (int)weight * 1000 + size;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = fonts.find(key);
+    if (it != fonts.end())
+        return &it->second->font;
+
+    Face* face = getFace(weight);
+    if (!face && weight != FontWeight::Regular)
+        face = getFace(FontWeight::Regular);
+    if (!face || !getCache())
+        return nullptr;
+
+    auto font = std::make_unique<Font>();
+    font->face = face;
+    font->scale = stbtt_ScaleForMappingEmToPixels(&face->info, size);
+
+    // Same line box as the prebaked fonts: the extent of the Latin glyphs
+    int ascent = 0;
+    int descent = 0;
+    for (uint32_t letter = LATIN_FIRST; letter <= LATIN_LAST; letter++)
+    {
+        if (!isLatin(letter))
+            continue;
+
+        GlyphMetrics& m = font->latin[letter - LATIN_FIRST];
+        m.index = stbtt_FindGlyphIndex(&face->info, letter);
+        if (!m.index)
+            continue;
+
+        stbtt_GetGlyphHMetrics(&face->info, m.index, &m.advance, nullptr);
+        stbtt_GetGlyphBitmapBox(&face->info, m.index, font->scale, font->scale, &m.x0, &m.y0, &m.x1, &m.y1);
+        if (m.x1 > m.x0)
+        {
+            ascent = std::max(ascent, -m.y0);
+            descent = std::max(descent, m.y1);
+        }
+    }
+
+    lv_font_t& f = font->font;
+    f.get_glyph_dsc = Callbacks::getGlyphDsc;
+    f.get_glyph_bitmap = Callbacks::getGlyphBitmap;
+    f.release_glyph = Callbacks::releaseGlyph;
+    f.line_height = ascent + descent;
+    f.base_line = descent;
+    f.subpx = LV_FONT_SUBPX_NONE;
+    f.kerning = LV_FONT_KERNING_NORMAL;
+    f.dsc = font.get();
+
+    // Underline from the 'post' table
+    stbtt_uint32 post = stbtt__find_table((stbtt_uint8*)face->data, face->info.fontstart, "post");
+    if (post)
+    {
+        f.underline_position = (int8_t)std::lround(ttSHORT(face->data, post + 8) * font->scale);
+        f.underline_thickness = (int8_t)std::max(1L, std::lround(ttSHORT(face->data, post + 10) * font->scale));
+    }
+
+    ESP_LOGD(TAG, "Created font weight %d size %d, line height %d", (int)weight, size, (int)f.line_height);
+
+    const lv_font_t* result = &font->font;
+    fonts.emplace(key, std::move(font));
+    return result;
+}
+
+void FontEngine::setCacheLimit(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    cacheLimit = std::max(bytes, MIN_CACHE_BYTES);
+    if (!cache)
+        return;
+
+    lv_cache_set_max_size(cache, cacheLimit, nullptr);
+    while (lv_cache_get_size(cache, nullptr) > cacheLimit)
+    {
+        // Glyphs being drawn cannot be evicted
+        if (!lv_cache_evict_one(cache, nullptr))
+            break;
+    }
+}
+
+FontEngine::Stats FontEngine::getStats() const
+{
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.fonts = fonts.size();
+        stats.cacheLimit = cacheLimit;
+        if (cache)
+            stats.cacheBytes = lv_cache_get_size(cache, nullptr);
+    }
+    stats.glyphs = glyphCount;
+    stats.misses = misses;
+    stats.hits = lookups - std::min<uint64_t>(lookups, stats.misses);
+    return stats;
+}
+
+bool FontEngine::Callbacks::getGlyphDsc(const lv_font_t* font, lv_font_glyph_dsc_t* dsc,
+                                        uint32_t letter, uint32_t letterNext)
+{
+    Font* f = (Font*)font->dsc;
+
+    GlyphMetrics m = f->metrics(letter);
+    if (!m.index)
+        return false;
+
+    int advance = m.advance;
+    if (letterNext)
+    {
+        GlyphMetrics next = f->metrics(letterNext);
+        if (next.index)
+            advance += f->kern(m.index, next.index);
+    }
+
+    dsc->adv_w = (uint16_t)std::lround(advance * f->scale);
+    dsc->box_w = std::max(0, m.x1 - m.x0);
+    dsc->box_h = std::max(0, m.y1 - m.y0);
+    dsc->ofs_x = m.x0;
+    dsc->ofs_y = -m.y1;  // Bottom of the bitmap from the baseline
+    dsc->format = LV_FONT_GLYPH_FORMAT_A8;
+    dsc->is_placeholder = false;
+    dsc->gid.index = m.index;
+    dsc->entry = nullptr;
+    return true;
+}
+
+const void* FontEngine::Callbacks::getGlyphBitmap(lv_font_glyph_dsc_t* dsc, lv_draw_buf_t* drawBuf)
+{
+    LV_UNUSED(drawBuf);
+
+    FontEngine& engine = getInstance();
+    engine.lookups++;
+
+    GlyphEntry key = {};
+    key.slot.size = sizeof(lv_draw_buf_t) + dsc->box_w * dsc->box_h;
+    key.font = (const Font*)dsc->resolved_font->dsc;
+    key.glyph = dsc->gid.index;
+
+    // Rasterized on a miss, pinned until releaseGlyph
+    lv_cache_entry_t* entry = lv_cache_acquire_or_create(engine.cache, &key, nullptr);
+    if (!entry)
+    {
+        ESP_LOGW(TAG, "No room for glyph %u in the cache", (unsigned)key.glyph);
+        return nullptr;
+    }
+
+    dsc->entry = entry;
+    return ((GlyphEntry*)lv_cache_entry_get_data(entry))->bitmap;
+}
+
+void FontEngine::Callbacks::releaseGlyph(const lv_font_t* font, lv_font_glyph_dsc_t* dsc)
+{
+    LV_UNUSED(font);
+
+    if (!dsc->entry)
+        return;
+
+    lv_cache_release(getInstance().cache, dsc->entry, nullptr);
+    dsc->entry = nullptr;
+}
+
+bool FontEngine::Callbacks::cacheCreate(GlyphEntry* entry, void* userData)
+{
+    LV_UNUSED(userData);
+
+    const Font* font = entry->font;
+    const stbtt_fontinfo* info = &font->face->info;
+
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBox(info, entry->glyph, font->scale, font->scale, &x0, &y0, &x1, &y1);
+    int w = std::max(1, x1 - x0);
+    int h = std::max(1, y1 - y0);
+
+    lv_draw_buf_t* bitmap = lv_draw_buf_create_ex(lv_draw_buf_get_font_handlers(), w, h,
+                                                  LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if (!bitmap)
+    {
+        ESP_LOGE(TAG, "Out of memory for a %dx%d glyph", w, h);
+        return false;
+    }
+
+    lv_draw_buf_clear(bitmap, nullptr);
+    stbtt_MakeGlyphBitmap(info, bitmap->data, w, h, bitmap->header.stride,
+                          font->scale, font->scale, entry->glyph);
+    lv_draw_buf_flush_cache(bitmap, nullptr);
+
+    entry->bitmap = bitmap;
+
+    FontEngine& engine = getInstance();
+    engine.misses++;
+    engine.glyphCount++;
+    return true;
+}
+
+void FontEngine::Callbacks::cacheFree(GlyphEntry* entry, void* userData)
+{
+    LV_UNUSED(userData);
+
+    lv_draw_buf_destroy(entry->bitmap);
+    getInstance().glyphCount--;
+}
+
+lv_cache_compare_res_t FontEngine::Callbacks::cacheCompare(const GlyphEntry* a, const GlyphEntry* b)
+{
+    if (a->font != b->font)
+        return a->font < b->font ? -1 : 1;
+    if (a->glyph != b->glyph)
+        return a->glyph < b->glyph ? -1 : 1;
+    return 0;
+}
+
+#else // CALAOS_RUNTIME_FONTS
+
+struct BakedFont
+{
+    FontWeight weight;
+    int size;
+    const lv_font_t* font;
+};
+
+static const BakedFont bakedFonts[] = {
+    {FontWeight::Light, 22, &roboto_light_22},
+    {FontWeight::Light, 24, &roboto_light_24},
+    {FontWeight::Light, 26, &roboto_light_26},
+    {FontWeight::Light, 28, &roboto_light_28},
+    {FontWeight::Light, 32, &roboto_light_32},
+    {FontWeight::Light, 48, &roboto_light_48},
+    {FontWeight::Regular, 22, &roboto_regular_22},
+    {FontWeight::Regular, 24, &roboto_regular_24},
+    {FontWeight::Regular, 26, &roboto_regular_26},
+    {FontWeight::Regular, 28, &roboto_regular_28},
+    {FontWeight::Regular, 32, &roboto_regular_32},
+    {FontWeight::Regular, 48, &roboto_regular_48},
+    {FontWeight::Medium, 22, &roboto_medium_22},
+    {FontWeight::Medium, 24, &roboto_medium_24},
+    {FontWeight::Medium, 26, &roboto_medium_26},
+    {FontWeight::Medium, 28, &roboto_medium_28},
+    {FontWeight::Medium, 32, &roboto_medium_32},
+    {FontWeight::Medium, 48, &roboto_medium_48},
+    {FontWeight::Bold, 22, &roboto_bold_22},
+    {FontWeight::Bold, 24, &roboto_bold_24},
+    {FontWeight::Bold, 26, &roboto_bold_26},
+    {FontWeight::Bold, 28, &roboto_bold_28},
+    {FontWeight::Bold, 32, &roboto_bold_32},
+    {FontWeight::Bold, 48, &roboto_bold_48},
+    {FontWeight::Bold, 50, &roboto_bold_50},
+};
+
+const lv_font_t* FontEngine::getFont(FontWeight weight, int size)
+{
+    const BakedFont* best = nullptr;
+    for (const BakedFont& baked : bakedFonts)
+    {
+        if (baked.weight != weight)
+            continue;
+        if (!best || std::abs(baked.size - size) < std::abs(best->size - size))
+            best = &baked;
+    }
+
+    if (best->size != size)
+        ESP_LOGW(TAG, "No prebaked Roboto %d, using size %d", size, best->size);
+    return best->font;
+}
+
+void FontEngine::setCacheLimit(size_t bytes)
+{
+    LV_UNUSED(bytes);
+}
+
+FontEngine::Stats FontEngine::getStats() const
+{
+    return Stats();
+}
+
+#endif // CALAOS_RUNTIME_FONTS
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "lvgl.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+enum class FontWeight
+{
+    Light,
+    Regular,
+    Medium,
+    Bold,
+};
+
+/**
+ * @brief Roboto fonts by weight and size
+ *
+ * With CALAOS_RUNTIME_FONTS (the default) glyphs are rasterized on demand
+ * from the Roboto TTF files embedded in the binary, instead of linking one
+ * prebaked bitmap font per weight and size. The TTF files are parsed once,
+ * each weight and size is created the first time it is asked for and lives
+ * as long as the app, and all of them share a single LRU cache of glyph
+ * bitmaps bounded in bytes. Glyph metrics of the Latin range are computed
+ * when a font is created, so text layout never touches the TTF outlines.
+ *
+ * Without CALAOS_RUNTIME_FONTS, the prebaked fonts of main/fonts are linked
+ * and get() returns the one of the closest size.
+ *
+ * get() may be called from any thread, glyphs are rendered from the draw
+ * threads.
+ */
+class FontEngine
+{
+public:
+    struct Stats
+    {
+        size_t fonts = 0;        ///< Weight and size pairs created
+        size_t glyphs = 0;       ///< Glyph bitmaps in the cache
+        size_t cacheBytes = 0;   ///< Memory used by the cached bitmaps
+        size_t cacheLimit = 0;   ///< Cache budget, 0 with prebaked fonts
+        uint64_t hits = 0;
+        uint64_t misses = 0;     ///< Glyphs rasterized
+    };
+
+    /**
+     * @brief Get singleton instance
+     */
+    static FontEngine& getInstance();
+
+    /**
+     * @brief Default glyph cache budget
+     */
+    static const size_t DEFAULT_CACHE_BYTES = 256 * 1024;
+
+    /**
+     * @brief Font of a weight and pixel size
+     * @return nullptr only if the embedded TTF files cannot be parsed
+     */
+    static const lv_font_t* get(FontWeight weight, int size)
+    {
+        return getInstance().getFont(weight, size);
+    }
+
+    const lv_font_t* getFont(FontWeight weight, int size);
+
+    /**
+     * @brief Change the glyph cache budget, evicting glyphs above it
+     * @param bytes Clamped to a few glyphs of the largest sizes
+     */
+    void setCacheLimit(size_t bytes);
+
+    Stats getStats() const;
+
+private:
+    FontEngine() = default;
+    ~FontEngine() = default;
+
+    FontEngine(const FontEngine&) = delete;
+    FontEngine& operator=(const FontEngine&) = delete;
+
+#if CALAOS_RUNTIME_FONTS
+    struct Face;
+    struct Font;
+    struct GlyphMetrics;
+    struct GlyphEntry;
+    struct Callbacks;  // LVGL font and glyph cache callbacks
+
+    Face* getFace(FontWeight weight);
+    lv_cache_t* getCache();
+
+    mutable std::mutex mutex;
+    std::unique_ptr<Face> faces[4];
+    std::map<int, std::unique_ptr<Font>> fonts;  // Keyed by weight and size
+    lv_cache_t* cache = nullptr;
+    size_t cacheLimit = DEFAULT_CACHE_BYTES;
+
+    std::atomic<size_t> glyphCount{0};
+    std::atomic<uint64_t> lookups{0};
+    std::atomic<uint64_t> misses{0};
+#endif
+};
+
+/**
+ * @brief LV_FONT_DEFAULT: Roboto Regular 24
+ */
+extern "C" const lv_font_t* font_engine_default(void);
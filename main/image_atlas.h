@@ -0,0 +1,18 @@
+#pragma once
+
+#include "lvgl.h"
+
+/**
+ * @brief Frames of an image sequence packed in a single image
+ *
+ * Generated by scripts/pack_atlas.py for every `<name>_NN.png` sequence of
+ * main/images, see cmake/images.cmake. A frame is shown by an lv_image of
+ * the frame size displaying the atlas image with an offset, see
+ * ImageSequenceAnimator.
+ */
+typedef struct
+{
+    const lv_image_dsc_t* image;  ///< Atlas image, frames stacked vertically
+    uint32_t frame_count;
+    const lv_area_t* frames;      ///< Rectangle of every frame in the atlas image
+} image_atlas_t;
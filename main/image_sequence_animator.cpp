@@ -7,7 +7,6 @@
  */
 
 #include "image_sequence_animator.h"
-#include "lvgl_timer.h"
 #include "logging.h"
 
 static const char* TAG = "ImageSequenceAnimator";
@@ -26,21 +25,28 @@ ImageSequenceAnimator::ImageSequenceAnimator(lv_obj_t* imageObj, const Config& c
         return;
     }
 
+    // One frame of the atlas is shown at a time
+    if (config_.atlas) {
+        const lv_area_t& frame = config_.atlas->frames[0];
+        lv_obj_set_size(imageObj_, lv_area_get_width(&frame), lv_area_get_height(&frame));
+    }
+
     // Set initial image
     if (config_.staticImage) {
-        lv_image_set_src(imageObj_, config_.staticImage);
-    } else if (!config_.frames.empty()) {
-        lv_image_set_src(imageObj_, config_.frames[0]);
+        showStaticImage();
+    } else {
+        showFrame(0);
     }
 
     ESP_LOGI(TAG, "Created ImageSequenceAnimator with %zu frames, %ums duration",
-             config_.frames.size(), config_.frameDuration);
+             getFrameCount(), config_.frameDuration);
 }
 
 // Destructor
 ImageSequenceAnimator::~ImageSequenceAnimator()
 {
     stop();
+    unregisterFromScheduler();
     ESP_LOGD(TAG, "Destroyed ImageSequenceAnimator");
 }
 
@@ -48,7 +54,6 @@ ImageSequenceAnimator::~ImageSequenceAnimator()
 ImageSequenceAnimator::ImageSequenceAnimator(ImageSequenceAnimator&& other) noexcept
     : imageObj_(other.imageObj_),
       config_(std::move(other.config_)),
-      animationTimer_(std::move(other.animationTimer_)),
       currentState_(other.currentState_),
       currentFrameIndex_(other.currentFrameIndex_),
       currentRepeatCount_(other.currentRepeatCount_),
@@ -56,6 +61,14 @@ ImageSequenceAnimator::ImageSequenceAnimator(ImageSequenceAnimator&& other) noex
       onFrameChange_(std::move(other.onFrameChange_)),
       onComplete_(std::move(other.onComplete_))
 {
+    // The scheduler entry points to other, register this object instead
+    nextFrameMs_ = other.nextFrameMs_;
+    other.unregisterFromScheduler();
+    if (currentState_ == State::Playing && config_.threadSafe) {
+        registerWithScheduler();
+        AnimationScheduler::getInstance().start(schedulerHandle_);
+    }
+
     // Reset other object
     other.imageObj_ = nullptr;
     other.currentState_ = State::Idle;
@@ -70,17 +83,24 @@ ImageSequenceAnimator& ImageSequenceAnimator::operator=(ImageSequenceAnimator&&
     if (this != &other) {
         // Clean up current resources
         stop();
+        unregisterFromScheduler();
 
         // Move from other
         imageObj_ = other.imageObj_;
         config_ = std::move(other.config_);
-        animationTimer_ = std::move(other.animationTimer_);
         currentState_ = other.currentState_;
         currentFrameIndex_ = other.currentFrameIndex_;
         currentRepeatCount_ = other.currentRepeatCount_;
         reverseDirection_ = other.reverseDirection_;
         onFrameChange_ = std::move(other.onFrameChange_);
         onComplete_ = std::move(other.onComplete_);
+        nextFrameMs_ = other.nextFrameMs_;
+
+        other.unregisterFromScheduler();
+        if (currentState_ == State::Playing && config_.threadSafe) {
+            registerWithScheduler();
+            AnimationScheduler::getInstance().start(schedulerHandle_);
+        }
 
         // Reset other
         other.imageObj_ = nullptr;
@@ -136,10 +156,38 @@ ImageSequenceAnimator::Config ImageSequenceAnimator::createPingPong(
     return config;
 }
 
+ImageSequenceAnimator::Config ImageSequenceAnimator::createOneShot(
+    const image_atlas_t* atlas,
+    const lv_image_dsc_t* staticImage,
+    uint32_t frameDuration)
+{
+    Config config = createOneShot(std::vector<const lv_image_dsc_t*>(), staticImage, frameDuration);
+    config.atlas = atlas;
+    return config;
+}
+
+ImageSequenceAnimator::Config ImageSequenceAnimator::createLoop(
+    const image_atlas_t* atlas,
+    uint32_t frameDuration)
+{
+    Config config = createLoop(std::vector<const lv_image_dsc_t*>(), frameDuration);
+    config.atlas = atlas;
+    return config;
+}
+
+ImageSequenceAnimator::Config ImageSequenceAnimator::createPingPong(
+    const image_atlas_t* atlas,
+    uint32_t frameDuration)
+{
+    Config config = createPingPong(std::vector<const lv_image_dsc_t*>(), frameDuration);
+    config.atlas = atlas;
+    return config;
+}
+
 // Animation control methods
 void ImageSequenceAnimator::play()
 {
-    if (!imageObj_ || config_.frames.empty()) {
+    if (!imageObj_ || getFrameCount() == 0) {
         ESP_LOGW(TAG, "Cannot play: invalid object or no frames");
         return;
     }
@@ -149,17 +197,15 @@ void ImageSequenceAnimator::play()
         return;
     }
 
-    ESP_LOGI(TAG, "Starting animation with %zu frames", config_.frames.size());
+    ESP_LOGI(TAG, "Starting animation with %zu frames", getFrameCount());
 
     transitionToState(State::Playing);
 
-    // Create or restart timer
+    // Tick from the shared animation clock, first frame after one frame duration
     if (config_.threadSafe) {
-        animationTimer_ = std::make_unique<LvglTimer>(
-            [this]() { onTimerTick(); },
-            config_.frameDuration
-        );
-        animationTimer_->start();
+        registerWithScheduler();
+        nextFrameMs_ = AnimationScheduler::now() + config_.frameDuration;
+        AnimationScheduler::getInstance().start(schedulerHandle_);
     } else {
         // Direct update (caller must ensure thread safety)
         onTimerTick();
@@ -174,9 +220,7 @@ void ImageSequenceAnimator::pause()
 
     ESP_LOGD(TAG, "Pausing animation");
 
-    if (animationTimer_) {
-        animationTimer_->pause();
-    }
+    AnimationScheduler::getInstance().stop(schedulerHandle_);
 
     transitionToState(State::Paused);
 }
@@ -189,11 +233,8 @@ void ImageSequenceAnimator::stop()
 
     ESP_LOGD(TAG, "Stopping animation");
 
-    // Stop timer
-    if (animationTimer_) {
-        animationTimer_->destroy();
-        animationTimer_.reset();
-    }
+    // Stop ticking
+    AnimationScheduler::getInstance().stop(schedulerHandle_);
 
     // Reset state
     currentFrameIndex_ = 0;
@@ -204,9 +245,9 @@ void ImageSequenceAnimator::stop()
 
     // Show static image or first frame
     if (config_.staticImage) {
-        lv_image_set_src(imageObj_, config_.staticImage);
-    } else if (!config_.frames.empty()) {
-        lv_image_set_src(imageObj_, config_.frames[0]);
+        showStaticImage();
+    } else {
+        showFrame(0);
     }
 }
 
@@ -216,8 +257,8 @@ void ImageSequenceAnimator::reset()
     currentRepeatCount_ = 0;
     reverseDirection_ = false;
 
-    if (!config_.frames.empty()) {
-        lv_image_set_src(imageObj_, config_.frames[0]);
+    if (getFrameCount() > 0) {
+        showFrame(0);
 
         if (onFrameChange_) {
             onFrameChange_(0);
@@ -229,7 +270,7 @@ void ImageSequenceAnimator::showStatic()
 {
     if (config_.staticImage) {
         stop();
-        lv_image_set_src(imageObj_, config_.staticImage);
+        showStaticImage();
         ESP_LOGD(TAG, "Showing static image");
     } else {
         ESP_LOGW(TAG, "No static image configured");
@@ -239,12 +280,8 @@ void ImageSequenceAnimator::showStatic()
 // Configuration methods
 void ImageSequenceAnimator::setFrameDuration(uint32_t ms)
 {
+    // Applies from the next frame on
     config_.frameDuration = ms;
-
-    // Update timer period if currently running
-    if (animationTimer_ && currentState_ == State::Playing) {
-        animationTimer_->setPeriod(ms);
-    }
 }
 
 void ImageSequenceAnimator::setFrames(const std::vector<const lv_image_dsc_t*>& frames)
@@ -257,6 +294,7 @@ void ImageSequenceAnimator::setFrames(const std::vector<const lv_image_dsc_t*>&
     }
 
     config_.frames = frames;
+    config_.atlas = nullptr;
     reset();
 
     // Restart if was playing
@@ -273,13 +311,12 @@ void ImageSequenceAnimator::setStaticImage(const lv_image_dsc_t* image)
 // Private methods
 void ImageSequenceAnimator::updateFrame()
 {
-    if (!imageObj_ || config_.frames.empty() ||
-        currentFrameIndex_ < 0 || currentFrameIndex_ >= static_cast<int>(config_.frames.size())) {
+    if (!imageObj_ || currentFrameIndex_ < 0 || currentFrameIndex_ >= static_cast<int>(getFrameCount())) {
         return;
     }
 
     // Update LVGL image
-    lv_image_set_src(imageObj_, config_.frames[currentFrameIndex_]);
+    showFrame(currentFrameIndex_);
 
     // Trigger callback
     if (onFrameChange_) {
@@ -287,9 +324,40 @@ void ImageSequenceAnimator::updateFrame()
     }
 }
 
+void ImageSequenceAnimator::showFrame(int index)
+{
+    if (!config_.atlas) {
+        lv_image_set_src(imageObj_, config_.frames[index]);
+        return;
+    }
+
+    // The object is one frame large and clips the atlas, the offset selects
+    // the frame. The source only changes back after a static image.
+    if (lv_image_get_src(imageObj_) != config_.atlas->image) {
+        lv_image_set_src(imageObj_, config_.atlas->image);
+        lv_image_set_inner_align(imageObj_, LV_IMAGE_ALIGN_TOP_LEFT);
+    }
+
+    const lv_area_t& frame = config_.atlas->frames[index];
+    lv_image_set_offset_x(imageObj_, -frame.x1);
+    lv_image_set_offset_y(imageObj_, -frame.y1);
+}
+
+void ImageSequenceAnimator::showStaticImage()
+{
+    lv_image_set_src(imageObj_, config_.staticImage);
+
+    if (config_.atlas) {
+        lv_image_set_inner_align(imageObj_, LV_IMAGE_ALIGN_CENTER);
+        lv_image_set_offset_x(imageObj_, 0);
+        lv_image_set_offset_y(imageObj_, 0);
+    }
+}
+
 void ImageSequenceAnimator::onTimerTick()
 {
-    if (currentState_ != State::Playing || config_.frames.empty()) {
+    int frameCount = static_cast<int>(getFrameCount());
+    if (currentState_ != State::Playing || frameCount == 0) {
         return;
     }
 
@@ -308,15 +376,15 @@ void ImageSequenceAnimator::onTimerTick()
             }
         } else {
             currentFrameIndex_++;
-            if (currentFrameIndex_ >= static_cast<int>(config_.frames.size()) - 1) {
-                currentFrameIndex_ = static_cast<int>(config_.frames.size()) - 1;
+            if (currentFrameIndex_ >= frameCount - 1) {
+                currentFrameIndex_ = frameCount - 1;
                 reverseDirection_ = true;
             }
         }
     } else {
         // Normal forward animation
         currentFrameIndex_++;
-        if (currentFrameIndex_ >= static_cast<int>(config_.frames.size())) {
+        if (currentFrameIndex_ >= frameCount) {
             currentFrameIndex_ = 0;
             currentRepeatCount_++;
         }
@@ -326,12 +394,7 @@ void ImageSequenceAnimator::onTimerTick()
     if (config_.repeatCount > 0 && currentRepeatCount_ >= config_.repeatCount) {
         ESP_LOGI(TAG, "Animation completed after %d repeats", currentRepeatCount_);
 
-        // Stop timer
-        if (animationTimer_) {
-            animationTimer_->destroy();
-            animationTimer_.reset();
-        }
-
+        // The scheduler stops ticking once onSchedulerTick() sees the state change
         transitionToState(State::Completed);
 
         // Trigger completion callback
@@ -341,11 +404,48 @@ void ImageSequenceAnimator::onTimerTick()
 
         // Show static image if available
         if (config_.staticImage) {
-            lv_image_set_src(imageObj_, config_.staticImage);
+            showStaticImage();
         }
     }
 }
 
+bool ImageSequenceAnimator::onSchedulerTick(uint32_t nowMs)
+{
+    if (currentState_ != State::Playing) {
+        return false;
+    }
+
+    if (static_cast<int32_t>(nowMs - nextFrameMs_) < 0) {
+        return true;
+    }
+
+    // Late by more than a frame (stall, or time spent off-screen): show one
+    // frame and restart the cadence instead of catching up
+    nextFrameMs_ += config_.frameDuration;
+    if (static_cast<int32_t>(nowMs - nextFrameMs_) >= 0) {
+        nextFrameMs_ = nowMs + config_.frameDuration;
+    }
+
+    onTimerTick();
+
+    // onComplete_ may have restarted the animation
+    return currentState_ == State::Playing;
+}
+
+void ImageSequenceAnimator::registerWithScheduler()
+{
+    if (schedulerHandle_ == AnimationScheduler::INVALID_HANDLE) {
+        schedulerHandle_ = AnimationScheduler::getInstance().add(imageObj_,
+            [this](uint32_t nowMs) { return onSchedulerTick(nowMs); });
+    }
+}
+
+void ImageSequenceAnimator::unregisterFromScheduler()
+{
+    AnimationScheduler::getInstance().remove(schedulerHandle_);
+    schedulerHandle_ = AnimationScheduler::INVALID_HANDLE;
+}
+
 void ImageSequenceAnimator::transitionToState(State newState)
 {
     if (currentState_ != newState) {
@@ -356,17 +456,24 @@ void ImageSequenceAnimator::transitionToState(State newState)
 
 bool ImageSequenceAnimator::validateConfig() const
 {
-    if (config_.frames.empty()) {
-        ESP_LOGW(TAG, "No frames configured");
-        return false;
-    }
-
-    // Validate all frame pointers
-    for (size_t i = 0; i < config_.frames.size(); ++i) {
-        if (!config_.frames[i]) {
-            ESP_LOGW(TAG, "Invalid frame pointer at index %zu", i);
+    if (config_.atlas) {
+        if (!config_.atlas->image || !config_.atlas->frames || config_.atlas->frame_count == 0) {
+            ESP_LOGW(TAG, "Invalid image atlas");
+            return false;
+        }
+    } else {
+        if (config_.frames.empty()) {
+            ESP_LOGW(TAG, "No frames configured");
             return false;
         }
+
+        // Validate all frame pointers
+        for (size_t i = 0; i < config_.frames.size(); ++i) {
+            if (!config_.frames[i]) {
+                ESP_LOGW(TAG, "Invalid frame pointer at index %zu", i);
+                return false;
+            }
+        }
     }
 
     if (config_.frameDuration < 10) {
@@ -374,4 +481,4 @@ bool ImageSequenceAnimator::validateConfig() const
     }
 
     return true;
-}
\ No newline at end of file
+}
@@ -10,7 +10,8 @@
  */
 #pragma once
 #include "lvgl.h"
-#include "lvgl_timer.h"
+#include "animation_scheduler.h"
+#include "image_atlas.h"
 #include <vector>
 #include <functional>
 #include <memory>
@@ -32,11 +33,12 @@ public:
     struct Config
     {
         std::vector<const lv_image_dsc_t*> frames;  ///< Pointers to existing image frames (no copying)
+        const image_atlas_t* atlas = nullptr;         ///< Frames packed in one image, used instead of frames
         const lv_image_dsc_t* staticImage = nullptr;  ///< Static image to show when not animating
         uint32_t frameDuration = 100;                 ///< Duration per frame in milliseconds
         int32_t repeatCount = 1;                      ///< Number of repeats (0=once, -1=infinite)
         bool autoReverse = false;                     ///< Auto reverse animation (ping-pong effect)
-        bool threadSafe = true;                       ///< Use LVGL timer for thread safety
+        bool threadSafe = true;                       ///< Tick from the shared AnimationScheduler
     };
 
     /**
@@ -83,6 +85,22 @@ public:
     static Config createPingPong(const std::vector<const lv_image_dsc_t*>& frames,
                                 uint32_t frameDuration = 100);
 
+    /**
+     * @brief Same configurations with the frames of an atlas
+     *
+     * The image object is resized to one frame and only its offset changes
+     * from frame to frame, the atlas image stays the source.
+     */
+    static Config createOneShot(const image_atlas_t* atlas,
+                               const lv_image_dsc_t* staticImage = nullptr,
+                               uint32_t frameDuration = 100);
+
+    static Config createLoop(const image_atlas_t* atlas,
+                            uint32_t frameDuration = 100);
+
+    static Config createPingPong(const image_atlas_t* atlas,
+                                uint32_t frameDuration = 100);
+
     /**
      * @brief Animation control methods
      */
@@ -98,7 +116,7 @@ public:
     State getState() const { return currentState_; }
     bool isPlaying() const { return currentState_ == State::Playing; }
     int getCurrentFrame() const { return currentFrameIndex_; }
-    size_t getFrameCount() const { return config_.frames.size(); }
+    size_t getFrameCount() const { return config_.atlas ? config_.atlas->frame_count : config_.frames.size(); }
 
     /**
      * @brief Dynamic configuration methods
@@ -115,14 +133,20 @@ public:
 
 private:
     void updateFrame();
+    void showFrame(int index);
+    void showStaticImage();
     void onTimerTick();
+    bool onSchedulerTick(uint32_t nowMs);
+    void registerWithScheduler();
+    void unregisterFromScheduler();
     void transitionToState(State newState);
     bool validateConfig() const;
 
 private:
     lv_obj_t* imageObj_;                        ///< LVGL image object to animate
     Config config_;                             ///< Animation configuration
-    std::unique_ptr<LvglTimer> animationTimer_; ///< Timer for frame updates
+    AnimationScheduler::Handle schedulerHandle_ = AnimationScheduler::INVALID_HANDLE; ///< Frame updates
+    uint32_t nextFrameMs_ = 0;                  ///< Scheduler time of the next frame
 
     // Animation state
     State currentState_ = State::Idle;
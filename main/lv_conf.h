@@ -162,8 +162,11 @@
 
 	/* Set the number of draw unit.
      * > 1 requires an operating system enabled in `LV_USE_OS`
-     * > 1 means multiple threads will render the screen in parallel */
+     * > 1 means multiple threads will render the screen in parallel
+     * Linux builds set it in lv_conf_platform.h */
+    #ifndef LV_DRAW_SW_DRAW_UNIT_CNT
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #endif
 
     /* Use Arm-2D to accelerate the sw render */
     #define LV_USE_DRAW_ARM2D_SYNC      0
@@ -364,7 +367,13 @@
  *Used by image decoders such as `lv_lodepng` to keep the decoded image in the memory.
  *If size is not set to 0, the decoder will fail to decode when the cache is full.
  *If size is 0, the cache function is not enabled and the decoded mem will be released immediately after use.*/
-#define LV_CACHE_DEF_SIZE       0
+#if CALAOS_COMPRESSED_IMAGES
+    /*Compressed images are decompressed on first use and kept here, so animation frames are
+     *not decompressed again on every draw. Fits all the images of main/images (~470 KB decoded).*/
+    #define LV_CACHE_DEF_SIZE       (512 * 1024)
+#else
+    #define LV_CACHE_DEF_SIZE       0
+#endif
 
 /*Default number of image header cache entries. The cache is used to store the headers of images
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
@@ -517,34 +526,42 @@
 /*Optionally declare custom fonts here.
  *You can use these fonts as default font too and they will be available globally.
  *E.g. #define LV_FONT_CUSTOM_DECLARE   LV_FONT_DECLARE(my_font_1) LV_FONT_DECLARE(my_font_2)*/
-#define LV_FONT_CUSTOM_DECLARE LV_FONT_DECLARE(roboto_light_22) \
-   LV_FONT_DECLARE(roboto_light_24) \
-   LV_FONT_DECLARE(roboto_light_26) \
-   LV_FONT_DECLARE(roboto_light_28) \
-   LV_FONT_DECLARE(roboto_light_32) \
-   LV_FONT_DECLARE(roboto_light_48) \
-   LV_FONT_DECLARE(roboto_regular_22) \
-   LV_FONT_DECLARE(roboto_regular_24) \
-   LV_FONT_DECLARE(roboto_regular_26) \
-   LV_FONT_DECLARE(roboto_regular_28) \
-   LV_FONT_DECLARE(roboto_regular_32) \
-   LV_FONT_DECLARE(roboto_regular_48) \
-   LV_FONT_DECLARE(roboto_medium_22) \
-   LV_FONT_DECLARE(roboto_medium_24) \
-   LV_FONT_DECLARE(roboto_medium_26) \
-   LV_FONT_DECLARE(roboto_medium_28) \
-   LV_FONT_DECLARE(roboto_medium_32) \
-   LV_FONT_DECLARE(roboto_medium_48) \
-   LV_FONT_DECLARE(roboto_bold_22) \
-   LV_FONT_DECLARE(roboto_bold_24) \
-   LV_FONT_DECLARE(roboto_bold_26) \
-   LV_FONT_DECLARE(roboto_bold_28) \
-   LV_FONT_DECLARE(roboto_bold_32) \
-   LV_FONT_DECLARE(roboto_bold_48) \
-   LV_FONT_DECLARE(roboto_bold_50)
-
-/*Always set a default font*/
-#define LV_FONT_DEFAULT &roboto_regular_24
+#if CALAOS_RUNTIME_FONTS
+    /*Roboto rasterized at runtime from the TTF files, see main/font_engine.h*/
+    #define LV_FONT_CUSTOM_DECLARE const lv_font_t * font_engine_default(void);
+
+    /*Always set a default font*/
+    #define LV_FONT_DEFAULT font_engine_default()
+#else
+    #define LV_FONT_CUSTOM_DECLARE LV_FONT_DECLARE(roboto_light_22) \
+       LV_FONT_DECLARE(roboto_light_24) \
+       LV_FONT_DECLARE(roboto_light_26) \
+       LV_FONT_DECLARE(roboto_light_28) \
+       LV_FONT_DECLARE(roboto_light_32) \
+       LV_FONT_DECLARE(roboto_light_48) \
+       LV_FONT_DECLARE(roboto_regular_22) \
+       LV_FONT_DECLARE(roboto_regular_24) \
+       LV_FONT_DECLARE(roboto_regular_26) \
+       LV_FONT_DECLARE(roboto_regular_28) \
+       LV_FONT_DECLARE(roboto_regular_32) \
+       LV_FONT_DECLARE(roboto_regular_48) \
+       LV_FONT_DECLARE(roboto_medium_22) \
+       LV_FONT_DECLARE(roboto_medium_24) \
+       LV_FONT_DECLARE(roboto_medium_26) \
+       LV_FONT_DECLARE(roboto_medium_28) \
+       LV_FONT_DECLARE(roboto_medium_32) \
+       LV_FONT_DECLARE(roboto_medium_48) \
+       LV_FONT_DECLARE(roboto_bold_22) \
+       LV_FONT_DECLARE(roboto_bold_24) \
+       LV_FONT_DECLARE(roboto_bold_26) \
+       LV_FONT_DECLARE(roboto_bold_28) \
+       LV_FONT_DECLARE(roboto_bold_32) \
+       LV_FONT_DECLARE(roboto_bold_48) \
+       LV_FONT_DECLARE(roboto_bold_50)
+
+    /*Always set a default font*/
+    #define LV_FONT_DEFAULT &roboto_regular_24
+#endif
 
 /*Enable handling large font and/or fonts with a lot of characters.
  *The limit depends on the font size, font face and bpp.
@@ -820,11 +837,19 @@
 #endif
 
 
-/*Decode bin images to RAM*/
-#define LV_BIN_DECODER_RAM_LOAD 0
+/*Decode bin images to RAM, also needed to decompress images*/
+#if CALAOS_COMPRESSED_IMAGES
+    #define LV_BIN_DECODER_RAM_LOAD 1
+#else
+    #define LV_BIN_DECODER_RAM_LOAD 0
+#endif
 
 /*RLE decompress library*/
-#define LV_USE_RLE 0
+#if CALAOS_COMPRESSED_IMAGES
+    #define LV_USE_RLE 1
+#else
+    #define LV_USE_RLE 0
+#endif
 
 /*QR code library*/
 #define LV_USE_QRCODE 0
@@ -865,7 +890,11 @@
 #define LV_USE_THORVG_EXTERNAL 0
 
 /*Use lvgl built-in LZ4 lib*/
-#define LV_USE_LZ4_INTERNAL  0
+#if CALAOS_COMPRESSED_IMAGES
+    #define LV_USE_LZ4_INTERNAL  1
+#else
+    #define LV_USE_LZ4_INTERNAL  0
+#endif
 
 /*Use external LZ4 library*/
 #define LV_USE_LZ4_EXTERNAL  0
@@ -893,7 +922,7 @@
 
     /*1: Show CPU usage and FPS count
      * Requires `LV_USE_SYSMON = 1`*/
-    #define LV_USE_PERF_MONITOR 1
+    #define LV_USE_PERF_MONITOR 0
     #if LV_USE_PERF_MONITOR
         #define LV_USE_PERF_MONITOR_POS LV_ALIGN_BOTTOM_RIGHT
 
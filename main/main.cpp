@@ -6,6 +6,8 @@
 #include <cstring>
 #include <cstdlib>
 #include <vector>
+#include <string>
+#include <cctype>
 #include <signal.h>
 #endif
 
@@ -43,15 +45,30 @@ void printUsage(const char* progName)
     std::cout << "  --input-backend <backend>    Force specific input backend\n";
     std::cout << "  --server-ip <ip>            Force Calaos server IP (skip discovery)\n";
     std::cout << "  --list-backends             List available backends\n";
+    std::cout << "  --no-vsync                  Disable DRM/fbdev page flipping\n";
+    std::cout << "  --perf-hud                  Show the performance overlay\n";
+    std::cout << "  --perf-log <seconds>        Log frame statistics every <seconds>\n";
     std::cout << "  --help                      Show this help message\n";
-    std::cout << "\nSupported display backends: fbdev, drm, sdl, x11, gles\n";
+    std::cout << "\nHeadless backend options (--display-backend headless):\n";
+    std::cout << "  --headless-size <WxH>       Offscreen resolution (default 720x720)\n";
+    std::cout << "  --headless-depth <bits>     Color depth: 16, 24 or 32\n";
+    std::cout << "  --headless-frame-ms <ms>    Virtual time per frame (default: follow LVGL timers)\n";
+    std::cout << "  --headless-dump-dir <dir>   Write frames to this directory\n";
+    std::cout << "  --headless-dump-frames <l>  Frames to write: 1,30,120 / all / last (default last)\n";
+    std::cout << "  --headless-dump-format <f>  png or ppm (default png)\n";
+    std::cout << "\nSupported display backends: fbdev, drm, sdl, x11, gles, headless\n";
     std::cout << "Supported input backends: evdev, libinput\n";
     std::cout << "\nEnvironment variables:\n";
     std::cout << "  CALAOS_DISPLAY_BACKEND      Override display backend\n";
     std::cout << "  CALAOS_INPUT_BACKEND        Override input backend\n";
     std::cout << "  CALAOS_SERVER_IP            Force Calaos server IP (skip discovery)\n";
+    std::cout << "  CALAOS_PERF_HUD, CALAOS_PERF_LOG Same as --perf-hud / --perf-log\n";
+    std::cout << "  CALAOS_DISPLAY_VSYNC=0      Same as --no-vsync\n";
     std::cout << "  LV_LINUX_FBDEV_DEVICE       Override framebuffer device path\n";
     std::cout << "  LV_LINUX_DRM_CARD           Override DRM card path\n";
+    std::cout << "  CALAOS_HEADLESS_SIZE, CALAOS_HEADLESS_DEPTH, CALAOS_HEADLESS_FRAME_MS,\n";
+    std::cout << "  CALAOS_HEADLESS_DUMP_DIR, CALAOS_HEADLESS_DUMP_FRAMES, CALAOS_HEADLESS_DUMP_FORMAT\n";
+    std::cout << "                              Same as the --headless-* options\n";
     std::cout << "  LV_LINUX_EVDEV_POINTER_DEVICE Override evdev input device path\n";
 }
 
@@ -121,6 +138,53 @@ int main(int argc, char* argv[])
                 return 1;
             }
         }
+        else if (strcmp(argv[i], "--no-vsync") == 0)
+        {
+            setenv("CALAOS_DISPLAY_VSYNC", "0", 1);
+        }
+        else if (strcmp(argv[i], "--perf-hud") == 0)
+        {
+            setenv("CALAOS_PERF_HUD", "1", 1);
+        }
+        else if (strcmp(argv[i], "--perf-log") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Error: --perf-log requires a value\n";
+                return 1;
+            }
+            setenv("CALAOS_PERF_LOG", argv[++i], 1);
+        }
+        else if (strncmp(argv[i], "--headless-", 11) == 0)
+        {
+            // --headless-dump-dir -> CALAOS_HEADLESS_DUMP_DIR
+            static const char* headlessOptions[] = {
+                "size", "depth", "frame-ms", "dump-dir", "dump-frames", "dump-format"
+            };
+
+            std::string option = argv[i] + 11;
+            bool known = false;
+            for (const char* name : headlessOptions)
+                known = known || option == name;
+
+            if (!known)
+            {
+                std::cerr << "Unknown option: " << argv[i] << "\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Error: " << argv[i] << " requires a value\n";
+                return 1;
+            }
+
+            std::string envName = "CALAOS_HEADLESS_";
+            for (char c : option)
+                envName += (c == '-') ? '_' : static_cast<char>(toupper(c));
+            setenv(envName.c_str(), argv[++i], 1);
+        }
         else
         {
             std::cerr << "Unknown option: " << argv[i] << "\n";
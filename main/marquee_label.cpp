@@ -0,0 +1,277 @@
+#include "marquee_label.h"
+#include "logging.h"
+#include "misc/cache/instance/lv_image_cache.h"
+#include <algorithm>
+
+static const char* TAG = "marquee";
+
+// Cycles start on this grid of the animation clock, so marquees shown
+// together scroll in phase
+static const uint32_t SYNC_GRID_MS = 250;
+
+// A longer gap between two ticks means the marquee was off-screen
+static const uint32_t PAUSE_GAP_MS = 4 * LV_DEF_REFR_PERIOD;
+
+MarqueeLabel::MarqueeLabel(lv_obj_t* parent, int32_t cycles):
+    cycles_(cycles)
+{
+    obj_ = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj_);
+    lv_obj_remove_flag(obj_, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(obj_, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(obj_, LV_PCT(100), LV_SIZE_CONTENT);
+
+    label_ = lv_label_create(obj_);
+    lv_label_set_long_mode(label_, LV_LABEL_LONG_CLIP);
+    lv_label_set_text(label_, "");
+    lv_obj_set_width(label_, LV_PCT(100));
+
+    lv_obj_add_event_cb(obj_, eventCb, LV_EVENT_SIZE_CHANGED, this);
+    lv_obj_add_event_cb(obj_, eventCb, LV_EVENT_STYLE_CHANGED, this);
+    lv_obj_add_event_cb(obj_, eventCb, LV_EVENT_DELETE, this);
+
+    // The image is rasterized again when back on screen, so only visible
+    // marquees hold one
+    handle_ = AnimationScheduler::getInstance().add(
+        obj_, [this](uint32_t nowMs) { return tick(nowMs); }, [this]() { dropCache(); });
+}
+
+MarqueeLabel::~MarqueeLabel()
+{
+    AnimationScheduler::getInstance().remove(handle_);
+    dropCache();
+
+    if (obj_)
+    {
+        lv_obj_remove_event_cb_with_user_data(obj_, eventCb, this);
+        lv_obj_delete(obj_);
+    }
+}
+
+void MarqueeLabel::setText(const char* text)
+{
+    if (!obj_ || text_ == text)
+        return;
+
+    text_ = text;
+    lv_label_set_text(label_, text);
+    update();
+}
+
+bool MarqueeLabel::isScrolling() const
+{
+    return AnimationScheduler::getInstance().isStarted(handle_);
+}
+
+void MarqueeLabel::restart()
+{
+    if (!obj_)
+        return;
+
+    offset_ = 0;
+    if (image_)
+        lv_image_set_offset_x(image_, 0);
+
+    if (!overflows_)
+    {
+        AnimationScheduler::getInstance().stop(handle_);
+        dropCache();
+        return;
+    }
+
+    // Still on the start of the text until the next grid line
+    startMs_ = (AnimationScheduler::now() / SYNC_GRID_MS + 1) * SYNC_GRID_MS;
+    ticked_ = false;
+    AnimationScheduler::getInstance().start(handle_);
+}
+
+void MarqueeLabel::update()
+{
+    font_ = lv_obj_get_style_text_font(obj_, LV_PART_MAIN);
+    letterSpace_ = lv_obj_get_style_text_letter_space(obj_, LV_PART_MAIN);
+    contentWidth_ = lv_obj_get_content_width(obj_);
+
+    lv_point_t size;
+    lv_text_get_size(&size, text_.c_str(), font_, letterSpace_, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    textWidth_ = size.x;
+    overflows_ = contentWidth_ > 0 && textWidth_ > contentWidth_;
+
+    dropCache();
+
+    // Text that does not fit starts on its first character, like the
+    // scrolled image, whatever the alignment
+    if (overflows_)
+        lv_obj_set_style_text_align(label_, LV_TEXT_ALIGN_LEFT, LV_PART_MAIN);
+    else
+        lv_obj_remove_local_style_prop(label_, LV_STYLE_TEXT_ALIGN, LV_PART_MAIN);
+
+    // Same gap and default speed as LV_LABEL_LONG_SCROLL_CIRCULAR
+    distance_ = textWidth_ + lv_font_get_glyph_width(font_, ' ', ' ') * LV_LABEL_WAIT_CHAR_COUNT;
+    uint32_t speed = lv_obj_get_style_anim_duration(obj_, LV_PART_MAIN);
+    if (speed == 0)
+        speed = lv_anim_speed_clamped(40, 300, 10000);
+    periodMs_ = std::max<uint32_t>(1, lv_anim_resolve_speed(speed, 0, distance_));
+
+    restart();
+}
+
+bool MarqueeLabel::renderCache()
+{
+    int32_t height = lv_font_get_line_height(font_);
+    lv_draw_buf_t* buf = lv_draw_buf_create(distance_, height, LV_COLOR_FORMAT_L8, LV_STRIDE_AUTO);
+    if (!buf)
+    {
+        ESP_LOGW(TAG, "No memory to cache a %dx%d marquee", (int)distance_, (int)height);
+        return false;
+    }
+    lv_draw_buf_clear(buf, nullptr);
+
+    // Tiled image widget that scrolls the text, the canvas only adds drawing
+    if (!image_)
+    {
+        image_ = lv_canvas_create(obj_);
+        lv_obj_remove_flag(image_, LV_OBJ_FLAG_CLICKABLE);
+        lv_image_set_inner_align(image_, LV_IMAGE_ALIGN_TILE);
+    }
+    lv_canvas_set_draw_buf(image_, buf);
+
+    // White text on black: the L8 pixels are the coverage of the text, the
+    // buffer is then used as the A8 mask of the recolored image
+    lv_layer_t layer;
+    lv_canvas_init_layer(image_, &layer);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.text = text_.c_str();
+    dsc.font = font_;
+    dsc.color = lv_color_white();
+    dsc.letter_space = letterSpace_;
+
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, textWidth_ - 1, height - 1);
+    lv_draw_label(&layer, &dsc, &area);
+    lv_canvas_finish_layer(image_, &layer);
+
+    buf->header.cf = LV_COLOR_FORMAT_A8;
+    cache_ = buf;
+
+    // Set again so the image reads the A8 header
+    lv_image_cache_drop(cache_);
+    lv_image_set_src(image_, cache_);
+    lv_image_set_offset_x(image_, -offset_);
+    lv_obj_set_size(image_, LV_PCT(100), height);
+    updateColor();
+
+    lv_obj_add_flag(label_, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_remove_flag(image_, LV_OBJ_FLAG_HIDDEN);
+    return true;
+}
+
+void MarqueeLabel::dropCache()
+{
+    if (!cache_)
+        return;
+
+    if (image_)
+        lv_image_set_src(image_, nullptr);
+    lv_image_cache_drop(cache_);
+    lv_draw_buf_destroy(cache_);
+    cache_ = nullptr;
+
+    // The label shows the text until the image is rasterized again
+    showLabel();
+}
+
+void MarqueeLabel::showLabel()
+{
+    lv_obj_remove_flag(label_, LV_OBJ_FLAG_HIDDEN);
+    if (image_)
+        lv_obj_add_flag(image_, LV_OBJ_FLAG_HIDDEN);
+}
+
+void MarqueeLabel::updateColor()
+{
+    if (!image_)
+        return;
+
+    lv_obj_set_style_image_recolor(image_, lv_obj_get_style_text_color_filtered(obj_, LV_PART_MAIN), LV_PART_MAIN);
+    lv_obj_set_style_image_opa(image_, lv_obj_get_style_text_opa(obj_, LV_PART_MAIN), LV_PART_MAIN);
+}
+
+bool MarqueeLabel::tick(uint32_t nowMs)
+{
+    // Off-screen marquees are not ticked, resume where it was. One created
+    // off-screen, on a prewarmed tab, starts when first shown.
+    if (ticked_ && nowMs - lastTickMs_ > PAUSE_GAP_MS)
+        startMs_ += nowMs - lastTickMs_ - LV_DEF_REFR_PERIOD;
+    else if (!ticked_ && static_cast<int32_t>(nowMs - startMs_) > static_cast<int32_t>(PAUSE_GAP_MS))
+        startMs_ = (nowMs / SYNC_GRID_MS + 1) * SYNC_GRID_MS;
+    lastTickMs_ = nowMs;
+    ticked_ = true;
+
+    int32_t elapsed = static_cast<int32_t>(nowMs - startMs_);
+    if (elapsed < 0)
+        return true;
+
+    if (cycles_ >= 0 && static_cast<uint32_t>(elapsed) / periodMs_ >= static_cast<uint32_t>(cycles_))
+    {
+        // Back on the start of the text, a still label is enough
+        offset_ = 0;
+        dropCache();
+        return false;
+    }
+
+    // Only rasterized once visible, so pages never shown cost nothing
+    if (!cache_ && !renderCache())
+    {
+        showLabel();
+        return false;
+    }
+
+    int32_t offset = static_cast<int64_t>(distance_) * (elapsed % periodMs_) / periodMs_;
+    if (offset != offset_)
+    {
+        offset_ = offset;
+        lv_image_set_offset_x(image_, -offset_);
+    }
+    return true;
+}
+
+void MarqueeLabel::eventCb(lv_event_t* e)
+{
+    MarqueeLabel* marquee = static_cast<MarqueeLabel*>(lv_event_get_user_data(e));
+
+    switch (lv_event_get_code(e))
+    {
+    case LV_EVENT_SIZE_CHANGED:
+        if (lv_obj_get_content_width(marquee->obj_) != marquee->contentWidth_)
+            marquee->update();
+        break;
+
+    case LV_EVENT_STYLE_CHANGED:
+        if (lv_obj_get_style_text_font(marquee->obj_, LV_PART_MAIN) != marquee->font_ ||
+            lv_obj_get_style_text_letter_space(marquee->obj_, LV_PART_MAIN) != marquee->letterSpace_)
+            marquee->update();
+        else
+            marquee->updateColor();
+        break;
+
+    case LV_EVENT_DELETE:
+        // Deleted with its parent before the marquee itself
+        AnimationScheduler::getInstance().remove(marquee->handle_);
+        marquee->handle_ = AnimationScheduler::INVALID_HANDLE;
+        if (marquee->cache_)
+        {
+            lv_image_cache_drop(marquee->cache_);
+            lv_draw_buf_destroy(marquee->cache_);
+            marquee->cache_ = nullptr;
+        }
+        marquee->obj_ = nullptr;
+        marquee->label_ = nullptr;
+        marquee->image_ = nullptr;
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "lvgl.h"
+#include "animation_scheduler.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Single line label scrolling text that does not fit
+ *
+ * Replaces LV_LABEL_LONG_SCROLL_CIRCULAR, whose animation never stops and
+ * lays out and rasterizes the text again on every frame. Text that fits is a
+ * plain label. Text that does not is rasterized once into an A8 image, which
+ * is tiled and only moved while scrolling, the text color being the image
+ * recolor, so color animations do not rasterize it again either.
+ *
+ * Scrolling is ticked by the AnimationScheduler: it pauses while off-screen,
+ * dropping the image, and resumes where it was. Every marquee moves on the
+ * same ticks with cycles starting on a shared time grid, so marquees of a
+ * page redraw in the same frames. After a number of cycles the marquee stops
+ * on the start of the text, drops the image and is a still label until
+ * restart() or setText().
+ *
+ * Font, color and alignment come from the text styles of get(), inherited by
+ * the label. The speed is LVGL's label scroll speed, or the anim_duration
+ * style of get() when set. All methods must be called from the LVGL context.
+ */
+class MarqueeLabel
+{
+public:
+    /**
+     * @brief Default number of scroll cycles, -1 scrolls forever
+     */
+    static const int32_t DEFAULT_CYCLES = 3;
+
+    /**
+     * @brief Create the marquee object
+     * @param parent Parent object
+     * @param cycles Scroll cycles before stopping, -1 for infinite
+     */
+    explicit MarqueeLabel(lv_obj_t* parent, int32_t cycles = DEFAULT_CYCLES);
+    ~MarqueeLabel();
+
+    MarqueeLabel(const MarqueeLabel&) = delete;
+    MarqueeLabel& operator=(const MarqueeLabel&) = delete;
+
+    /**
+     * @brief Container to size, align and style, its width clips the text
+     */
+    lv_obj_t* get() const { return obj_; }
+
+    /**
+     * @brief Change the text, restarts scrolling only if it changed
+     */
+    void setText(const char* text);
+    const std::string& getText() const { return text_; }
+
+    /**
+     * @brief Scroll again from the start of the text, if it does not fit
+     */
+    void restart();
+
+    /**
+     * @brief true while the text is scrolling or waiting to
+     */
+    bool isScrolling() const;
+
+    /**
+     * @brief true while the rasterized text image exists
+     */
+    bool isCached() const { return cache_ != nullptr; }
+
+private:
+    void update();
+    bool renderCache();
+    void dropCache();
+    void showLabel();
+    void updateColor();
+    bool tick(uint32_t nowMs);
+
+    static void eventCb(lv_event_t* e);
+
+    lv_obj_t* obj_ = nullptr;
+    lv_obj_t* label_ = nullptr;
+    lv_obj_t* image_ = nullptr;     ///< Canvas rasterizing cache_, shows it while scrolling
+    lv_draw_buf_t* cache_ = nullptr;
+    AnimationScheduler::Handle handle_ = AnimationScheduler::INVALID_HANDLE;
+
+    std::string text_;
+    const lv_font_t* font_ = nullptr;
+    int32_t letterSpace_ = 0;
+    int32_t contentWidth_ = 0;
+    int32_t textWidth_ = 0;
+    int32_t distance_ = 0;          ///< Text width plus the gap before it repeats
+    uint32_t periodMs_ = 0;         ///< Duration of one cycle
+    int32_t cycles_;
+    bool overflows_ = false;
+
+    uint32_t startMs_ = 0;          ///< Start of the first cycle
+    uint32_t lastTickMs_ = 0;
+    bool ticked_ = false;           ///< lastTickMs_ is valid
+    int32_t offset_ = 0;
+};
@@ -0,0 +1,193 @@
+// NumberFlow rendering benchmark on an offscreen display.
+// Shows a grid of animated numbers, changes all of them at once and renders
+// the animation that follows, for NumberFlow/NumberFlowFloat, built from
+// child objects, and NumberFlowLabel/NumberFlowFloatLabel, drawn by a
+// single object. Reports per variant the LVGL object count, the heap used by
+// the numbers and, per value update, the CPU time of update() calls, the
+// frames rendered and the draw time.
+//
+// Time is virtual (60 Hz frames), so every variant renders the same
+// animation steps; only the measured CPU time varies.
+//
+// Usage: number_flow_bench [instances] [updates]
+
+#include "lvgl.h"
+#include "font_engine.h"
+#include "smooth_ui_toolkit.h"
+#include "lvgl/smooth_lvgl.h"
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace smooth_ui_toolkit;
+using namespace smooth_ui_toolkit::lvgl_cpp;
+
+static const int32_t DISPLAY_WIDTH = 720;
+static const int32_t DISPLAY_HEIGHT = 720;
+
+// Virtual time per frame (60 Hz)
+static const uint32_t FRAME_MS = 16;
+
+// Frames rendered after every value update, long enough for the springs to
+// settle
+static const int FRAMES_PER_UPDATE = 90;
+
+static uint32_t virtualMs = 0;
+static uint64_t renderStartUs = 0;
+static uint64_t renderUs = 0;
+static uint32_t renderedFrames = 0;
+
+static uint64_t nowUs()
+{
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+}
+
+static size_t heapInUse()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static uint32_t countObjects(lv_obj_t* obj)
+{
+    uint32_t count = 1;
+    uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; i++)
+        count += countObjects(lv_obj_get_child(obj, i));
+    return count;
+}
+
+static void flushCb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map)
+{
+    lv_display_flush_ready(disp);
+}
+
+static void renderEventCb(lv_event_t* e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START)
+    {
+        renderStartUs = nowUs();
+    }
+    else
+    {
+        renderUs += nowUs() - renderStartUs;
+        renderedFrames++;
+    }
+}
+
+// Same values for every variant: random walks of a few units with some
+// jumps across digit counts and signs
+static std::vector<float> makeValues(int updates)
+{
+    std::vector<float> values;
+    uint32_t seed = 12345;
+    float value = 21.5f;
+    for (int i = 0; i < updates; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int step = static_cast<int>((seed >> 16) % 2001) - 1000;
+        value = (i % 10 == 9) ? -value / 10.0f : value + step / 100.0f;
+        values.push_back(value);
+    }
+    return values;
+}
+
+template <typename Flow, typename Value>
+static void run(const char* name, int instances, const std::vector<float>& values)
+{
+    const lv_font_t* font = FontEngine::get(FontWeight::Medium, 48);
+
+    lv_obj_t* screen = lv_obj_create(nullptr);
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_ROW_WRAP);
+    lv_screen_load(screen);
+    lv_refr_now(nullptr);
+
+    size_t heapBefore = heapInUse();
+
+    std::vector<std::unique_ptr<Flow>> flows;
+    for (int i = 0; i < instances; i++)
+    {
+        auto flow = std::make_unique<Flow>(screen);
+        flow->setTextFont(font);
+        flow->setSuffix("°C");
+        flow->init();
+        flows.push_back(std::move(flow));
+    }
+
+    // Initial appearance, not measured
+    for (int f = 0; f < FRAMES_PER_UPDATE; f++)
+    {
+        virtualMs += FRAME_MS;
+        for (auto& flow : flows)
+            flow->update();
+        lv_refr_now(nullptr);
+    }
+
+    size_t heap = heapInUse() - heapBefore;
+    uint32_t objects = countObjects(screen) - 1;
+
+    uint64_t updateUs = 0;
+    renderUs = 0;
+    renderedFrames = 0;
+    for (float value : values)
+    {
+        for (auto& flow : flows)
+            flow->setValue(static_cast<Value>(value));
+
+        for (int f = 0; f < FRAMES_PER_UPDATE; f++)
+        {
+            virtualMs += FRAME_MS;
+            uint64_t start = nowUs();
+            for (auto& flow : flows)
+                flow->update();
+            updateUs += nowUs() - start;
+            lv_refr_now(nullptr);
+        }
+    }
+
+    printf("%-22s objects=%-4u heap=%-7zu update=%.3fms frames=%.1f draw=%.3fms per value update\n",
+           name, objects, heap,
+           updateUs / 1000.0 / values.size(),
+           static_cast<double>(renderedFrames) / values.size(),
+           renderUs / 1000.0 / values.size());
+
+    flows.clear();
+    lv_obj_delete(screen);
+}
+
+int main(int argc, char* argv[])
+{
+    int instances = argc > 1 ? atoi(argv[1]) : 12;
+    int updates = argc > 2 ? atoi(argv[2]) : 50;
+
+    lv_init();
+    lv_tick_set_cb([]() -> uint32_t { return virtualMs; });
+    ui_hal::on_get_tick([]() -> uint32_t { return virtualMs; });
+
+    lv_display_t* display = lv_display_create(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    uint32_t bufSize = DISPLAY_WIDTH * DISPLAY_HEIGHT / 10 * lv_color_format_get_size(lv_display_get_color_format(display));
+    std::vector<uint8_t> buf(bufSize + LV_DRAW_BUF_ALIGN);
+    lv_display_set_buffers(display, lv_draw_buf_align(buf.data(), lv_display_get_color_format(display)), nullptr,
+                           bufSize, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(display, flushCb);
+    lv_display_add_event_cb(display, renderEventCb, LV_EVENT_RENDER_START, nullptr);
+    lv_display_add_event_cb(display, renderEventCb, LV_EVENT_RENDER_READY, nullptr);
+
+    std::vector<float> values = makeValues(updates);
+
+    run<NumberFlow, int>("NumberFlow", instances, values);
+    run<NumberFlowLabel, int>("NumberFlowLabel", instances, values);
+    run<NumberFlowFloat, float>("NumberFlowFloat", instances, values);
+    run<NumberFlowFloatLabel, float>("NumberFlowFloatLabel", instances, values);
+
+    lv_display_delete(display);
+    lv_deinit();
+    return 0;
+}
@@ -11,6 +11,9 @@ public:
 
     virtual void render() = 0;
 
+    // True while render() has animations to advance
+    virtual bool hasRunningAnimations() { return false; }
+
 protected:
     void setupFullScreen();
 };
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "pages_config_diff.h"
+#include <algorithm>
+#include <map>
+#include <string>
+
+using CalaosProtocol::PageConfig;
+using CalaosProtocol::PagesConfig;
+using CalaosProtocol::WidgetConfig;
+
+static bool sameWidget(const WidgetConfig& a, const WidgetConfig& b)
+{
+    return a.io_id == b.io_id && a.type == b.type;
+}
+
+static bool sameGeometry(const WidgetConfig& a, const WidgetConfig& b)
+{
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+// Number of widgets two pages have in common
+static int sharedWidgets(const PageConfig& a, const PageConfig& b)
+{
+    std::map<std::string, int> counts;
+    for (const auto& widget : a.widgets)
+        counts[widget.io_id + '\n' + widget.type]++;
+
+    int shared = 0;
+    for (const auto& widget : b.widgets)
+    {
+        auto it = counts.find(widget.io_id + '\n' + widget.type);
+        if (it != counts.end() && it->second > 0)
+        {
+            it->second--;
+            shared++;
+        }
+    }
+    return shared;
+}
+
+static void diffWidgets(const PageConfig& from, const PageConfig& to, PageDiff& diff)
+{
+    std::vector<bool> oldUsed(from.widgets.size(), false);
+    std::vector<bool> newUsed(to.widgets.size(), false);
+
+    // Unchanged widgets first, so duplicates of an io pair up with their own geometry
+    for (size_t j = 0; j < to.widgets.size(); j++)
+    {
+        for (size_t i = 0; i < from.widgets.size(); i++)
+        {
+            if (!oldUsed[i] && sameWidget(from.widgets[i], to.widgets[j]) &&
+                sameGeometry(from.widgets[i], to.widgets[j]))
+            {
+                oldUsed[i] = newUsed[j] = true;
+                break;
+            }
+        }
+    }
+
+    for (size_t j = 0; j < to.widgets.size(); j++)
+    {
+        if (newUsed[j])
+            continue;
+
+        for (size_t i = 0; i < from.widgets.size(); i++)
+        {
+            if (oldUsed[i] || !sameWidget(from.widgets[i], to.widgets[j]))
+                continue;
+
+            const WidgetConfig& a = from.widgets[i];
+            const WidgetConfig& b = to.widgets[j];
+            if (a.w == b.w && a.h == b.h)
+                diff.moved.push_back({a, b});
+            else
+                diff.resized.push_back({a, b});
+
+            oldUsed[i] = newUsed[j] = true;
+            break;
+        }
+
+        if (!newUsed[j])
+            diff.added.push_back(to.widgets[j]);
+    }
+
+    for (size_t i = 0; i < from.widgets.size(); i++)
+    {
+        if (!oldUsed[i])
+            diff.removed.push_back(from.widgets[i]);
+    }
+}
+
+bool PageDiff::hasWidgetChanges() const
+{
+    return !added.empty() || !removed.empty() || !moved.empty() || !resized.empty();
+}
+
+bool PagesConfigDiff::isEmpty() const
+{
+    if (gridChanged || !removedPages.empty())
+        return false;
+
+    return std::all_of(pages.begin(), pages.end(), [](const PageDiff& page)
+    {
+        return page.oldIndex == page.newIndex && !page.hasWidgetChanges();
+    });
+}
+
+PagesConfigDiff PagesConfigDiff::compute(const PagesConfig& from, const PagesConfig& to)
+{
+    PagesConfigDiff diff;
+
+    // Cell sizes change with the grid, nothing can be kept
+    if (from.grid_width != to.grid_width || from.grid_height != to.grid_height)
+    {
+        diff.gridChanged = true;
+        return diff;
+    }
+
+    int n = from.pages.size();
+    int m = to.pages.size();
+
+    // Weighted LCS over pages: pairing two pages always beats inserting and
+    // removing one, and pages sharing more widgets are preferred
+    std::vector<std::vector<int>> score(n, std::vector<int>(m));
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < m; j++)
+            score[i][j] = 1 + 2 * sharedWidgets(from.pages[i], to.pages[j]);
+    }
+
+    std::vector<std::vector<int>> best(n + 1, std::vector<int>(m + 1, 0));
+    for (int i = 1; i <= n; i++)
+    {
+        for (int j = 1; j <= m; j++)
+        {
+            best[i][j] = std::max({best[i - 1][j],
+                                   best[i][j - 1],
+                                   best[i - 1][j - 1] + score[i - 1][j - 1]});
+        }
+    }
+
+    diff.pages.resize(m);
+    int i = n;
+    int j = m;
+    while (i > 0 || j > 0)
+    {
+        if (i > 0 && j > 0 && best[i][j] == best[i - 1][j - 1] + score[i - 1][j - 1])
+        {
+            PageDiff& page = diff.pages[j - 1];
+            page.oldIndex = i - 1;
+            page.newIndex = j - 1;
+            diffWidgets(from.pages[i - 1], to.pages[j - 1], page);
+            i--;
+            j--;
+        }
+        else if (i > 0 && best[i][j] == best[i - 1][j])
+        {
+            diff.removedPages.push_back(i - 1);
+            i--;
+        }
+        else
+        {
+            PageDiff& page = diff.pages[j - 1];
+            page.newIndex = j - 1;
+            page.added = to.pages[j - 1].widgets;
+            j--;
+        }
+    }
+
+    std::reverse(diff.removedPages.begin(), diff.removedPages.end());
+    return diff;
+}
+
+bool fitsGrid(const WidgetConfig& widget, int gridWidth, int gridHeight)
+{
+    return widget.x >= 0 && widget.y >= 0 &&
+           widget.x + widget.w <= gridWidth &&
+           widget.y + widget.h <= gridHeight;
+}
+
+WidgetPatch WidgetPatch::compute(const std::vector<WidgetConfig>& current,
+                                 const PageDiff& page,
+                                 int gridWidth, int gridHeight)
+{
+    WidgetPatch patch;
+
+    // Resolve every widget before touching any, a moved widget may take the
+    // place of another one with the same io
+    std::vector<bool> claimed(current.size(), false);
+    auto claim = [&](const WidgetConfig& config) -> int
+    {
+        for (size_t i = 0; i < current.size(); i++)
+        {
+            if (!claimed[i] && sameWidget(current[i], config) && sameGeometry(current[i], config))
+            {
+                claimed[i] = true;
+                return i;
+            }
+        }
+        return -1;
+    };
+
+    for (const auto& change : page.moved)
+    {
+        int index = claim(change.from);
+        if (index < 0)
+            patch.created.push_back(change.to);
+        else if (fitsGrid(change.to, gridWidth, gridHeight))
+            patch.moved.push_back({index, change.to});
+        else
+            patch.released.push_back(index);
+    }
+
+    for (const auto& config : page.removed)
+    {
+        int index = claim(config);
+        if (index >= 0)
+            patch.released.push_back(index);
+    }
+
+    // The factory picks the class per size: resized widgets are recreated
+    for (const auto& change : page.resized)
+    {
+        int index = claim(change.from);
+        if (index >= 0)
+            patch.released.push_back(index);
+        patch.created.push_back(change.to);
+    }
+
+    patch.created.insert(patch.created.end(), page.added.begin(), page.added.end());
+    return patch;
+}
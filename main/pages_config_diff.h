@@ -0,0 +1,86 @@
+#pragma once
+
+#include "calaos_protocol.h"
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A widget present in both configs with a different geometry
+ */
+struct WidgetChange
+{
+    CalaosProtocol::WidgetConfig from;
+    CalaosProtocol::WidgetConfig to;
+};
+
+/**
+ * @brief Changes between an old page and the page that replaces it
+ *
+ * Widgets are identified by io_id and type within a page: a widget that
+ * moves to another page is removed from one and added to the other.
+ */
+struct PageDiff
+{
+    int oldIndex = -1;  // Page reused from the old config, -1 for an inserted page
+    int newIndex = -1;  // Position in the new config
+
+    std::vector<CalaosProtocol::WidgetConfig> added;
+    std::vector<CalaosProtocol::WidgetConfig> removed;
+    std::vector<WidgetChange> moved;    // Same size, new position
+    std::vector<WidgetChange> resized;  // New size, possibly new position
+
+    bool isInserted() const { return oldIndex < 0; }
+    bool hasWidgetChanges() const;
+};
+
+/**
+ * @brief True when the widget lies inside a grid of the given size
+ */
+bool fitsGrid(const CalaosProtocol::WidgetConfig& widget, int gridWidth, int gridHeight);
+
+/**
+ * @brief Widget operations that apply a PageDiff to the widgets of a loaded page
+ *
+ * Indices refer to the current widgets, in the order they were given. A change
+ * whose old widget does not exist (it was skipped when the page was built) is
+ * turned into a creation, and a widget moved out of the grid is released, so
+ * the page ends up with the widgets a full rebuild would create.
+ */
+struct WidgetPatch
+{
+    std::vector<std::pair<int, CalaosProtocol::WidgetConfig>> moved;  // Widget index, new geometry
+    std::vector<int> released;  // Widgets to give back to the factory
+    std::vector<CalaosProtocol::WidgetConfig> created;
+
+    static WidgetPatch compute(const std::vector<CalaosProtocol::WidgetConfig>& current,
+                               const PageDiff& page,
+                               int gridWidth, int gridHeight);
+};
+
+/**
+ * @brief Layout diff between two PagesConfig
+ *
+ * Pages have no identity in the protocol, so old and new pages are paired by
+ * an order-preserving alignment that maximizes the widgets they share. Pages
+ * left out of the alignment are inserted or removed, the others are patched
+ * in place.
+ */
+struct PagesConfigDiff
+{
+    // The grid changed size, every widget has to be rebuilt
+    bool gridChanged = false;
+
+    // One entry per page of the new config, in order
+    std::vector<PageDiff> pages;
+
+    // Pages of the old config that are gone, in increasing order
+    std::vector<int> removedPages;
+
+    /**
+     * @brief True when both configs have the same layout
+     */
+    bool isEmpty() const;
+
+    static PagesConfigDiff compute(const CalaosProtocol::PagesConfig& from,
+                                   const CalaosProtocol::PagesConfig& to);
+};
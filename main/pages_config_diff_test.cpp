@@ -0,0 +1,243 @@
+// Checks PagesConfigDiff over pairs of layouts: unchanged configs, widgets
+// moved, resized, added, removed or sent to another page, pages inserted,
+// removed and reordered, duplicated IOs and grid changes, then the widget
+// operations a page patch turns into.
+//
+// Usage: pages_config_diff_test
+
+#include "pages_config_diff.h"
+#include "test_check.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+using CalaosProtocol::PageConfig;
+using CalaosProtocol::PagesConfig;
+using CalaosProtocol::WidgetConfig;
+
+static WidgetConfig light(const std::string& id, int x, int y, int w = 1, int h = 1)
+{
+    return WidgetConfig(id, "LightSwitch", x, y, w, h);
+}
+
+static PageConfig page(std::vector<WidgetConfig> widgets)
+{
+    PageConfig p;
+    p.widgets = std::move(widgets);
+    return p;
+}
+
+static PagesConfig config(std::vector<PageConfig> pages, int grid = 3)
+{
+    PagesConfig c;
+    c.grid_width = grid;
+    c.grid_height = grid;
+    c.pages = std::move(pages);
+    return c;
+}
+
+// Page of three lights, named after the page
+static PageConfig lights(const std::string& prefix)
+{
+    return page({light(prefix + "1", 0, 0), light(prefix + "2", 1, 0), light(prefix + "3", 2, 0)});
+}
+
+static bool inPlace(const PagesConfigDiff& diff)
+{
+    for (const auto& p : diff.pages)
+    {
+        if (p.oldIndex != p.newIndex)
+            return false;
+    }
+    return diff.removedPages.empty();
+}
+
+int main()
+{
+    PagesConfig base = config({lights("a"), lights("b"), lights("c")});
+
+    // 1. Same layout
+    {
+        auto diff = PagesConfigDiff::compute(base, base);
+        check(diff.isEmpty() && diff.pages.size() == 3, "identical configs");
+    }
+
+    // 2. One widget moved to a free cell
+    {
+        PagesConfig to = base;
+        to.pages[1].widgets[2].y = 2;
+        auto diff = PagesConfigDiff::compute(base, to);
+        const PageDiff& p = diff.pages[1];
+        check(!diff.isEmpty() && inPlace(diff) && p.moved.size() == 1 &&
+              p.moved[0].from.y == 0 && p.moved[0].to.y == 2 &&
+              p.added.empty() && p.removed.empty() && p.resized.empty() &&
+              !diff.pages[0].hasWidgetChanges() && !diff.pages[2].hasWidgetChanges(),
+              "widget moved");
+    }
+
+    // 3. One widget resized
+    {
+        PagesConfig to = base;
+        to.pages[0].widgets[0].h = 2;
+        auto diff = PagesConfigDiff::compute(base, to);
+        const PageDiff& p = diff.pages[0];
+        check(inPlace(diff) && p.resized.size() == 1 && p.moved.empty() &&
+              p.resized[0].to.h == 2, "widget resized");
+    }
+
+    // 4. Widgets added and removed
+    {
+        PagesConfig to = base;
+        to.pages[2].widgets.erase(to.pages[2].widgets.begin());
+        to.pages[2].widgets.push_back(WidgetConfig("t1", "Temperature", 0, 1, 1, 1));
+        auto diff = PagesConfigDiff::compute(base, to);
+        const PageDiff& p = diff.pages[2];
+        check(inPlace(diff) && p.added.size() == 1 && p.added[0].io_id == "t1" &&
+              p.removed.size() == 1 && p.removed[0].io_id == "c1" && p.moved.empty(),
+              "widget added and removed");
+    }
+
+    // 5. Same io, other type: a different widget
+    {
+        PagesConfig to = base;
+        to.pages[0].widgets[1].type = "Scenario";
+        auto diff = PagesConfigDiff::compute(base, to);
+        const PageDiff& p = diff.pages[0];
+        check(p.added.size() == 1 && p.removed.size() == 1 && p.moved.empty(), "type change replaces widget");
+    }
+
+    // 6. Widget sent to another page
+    {
+        PagesConfig to = base;
+        WidgetConfig w = to.pages[0].widgets[2];
+        to.pages[0].widgets.erase(to.pages[0].widgets.begin() + 2);
+        w.y = 1;
+        to.pages[1].widgets.push_back(w);
+        auto diff = PagesConfigDiff::compute(base, to);
+        check(inPlace(diff) && diff.pages[0].removed.size() == 1 && diff.pages[0].added.empty() &&
+              diff.pages[1].added.size() == 1 && diff.pages[1].removed.empty(),
+              "widget moved across pages");
+    }
+
+    // 7. Page inserted at the front
+    {
+        PagesConfig to = config({lights("n"), lights("a"), lights("b"), lights("c")});
+        auto diff = PagesConfigDiff::compute(base, to);
+        bool ok = diff.pages.size() == 4 && diff.removedPages.empty() &&
+                  diff.pages[0].isInserted() && diff.pages[0].added.size() == 3;
+        for (int i = 1; ok && i < 4; i++)
+            ok = diff.pages[i].oldIndex == i - 1 && !diff.pages[i].hasWidgetChanges();
+        check(ok, "page inserted");
+    }
+
+    // 8. Middle page removed
+    {
+        PagesConfig to = config({lights("a"), lights("c")});
+        auto diff = PagesConfigDiff::compute(base, to);
+        check(diff.removedPages == std::vector<int>{1} && diff.pages.size() == 2 &&
+              diff.pages[0].oldIndex == 0 && diff.pages[1].oldIndex == 2 &&
+              !diff.pages[0].hasWidgetChanges() && !diff.pages[1].hasWidgetChanges(),
+              "page removed");
+    }
+
+    // 9. Pages swapped: one keeps its tab, the other is recreated
+    {
+        PagesConfig from = config({lights("a"), lights("b")});
+        PagesConfig to = config({lights("b"), lights("a")});
+        auto diff = PagesConfigDiff::compute(from, to);
+        int kept = 0;
+        for (const auto& p : diff.pages)
+        {
+            if (!p.isInserted() && !p.hasWidgetChanges())
+                kept++;
+        }
+        check(kept == 1 && diff.removedPages.size() == 1 && !diff.isEmpty(), "pages swapped");
+    }
+
+    // 10. Page content replaced: the tab is reused
+    {
+        PagesConfig to = config({lights("a"), lights("x"), lights("c")});
+        auto diff = PagesConfigDiff::compute(base, to);
+        check(inPlace(diff) && diff.pages[1].added.size() == 3 && diff.pages[1].removed.size() == 3,
+              "page content replaced");
+    }
+
+    // 11. Same io twice on a page, positions swapped: nothing to do
+    {
+        PagesConfig from = config({page({light("d", 0, 0), light("d", 1, 0)})});
+        PagesConfig to = config({page({light("d", 1, 0), light("d", 0, 0)})});
+        auto diff = PagesConfigDiff::compute(from, to);
+        check(diff.isEmpty(), "duplicate io reordered");
+    }
+
+    // 12. Same io twice, one of them moved
+    {
+        PagesConfig from = config({page({light("d", 0, 0), light("d", 1, 0)})});
+        PagesConfig to = config({page({light("d", 1, 0), light("d", 2, 2)})});
+        auto diff = PagesConfigDiff::compute(from, to);
+        const PageDiff& p = diff.pages[0];
+        check(p.moved.size() == 1 && p.moved[0].from.x == 0 && p.moved[0].to.x == 2 &&
+              p.added.empty() && p.removed.empty(), "duplicate io moved");
+    }
+
+    // 13. Grid size changed
+    {
+        PagesConfig to = base;
+        to.grid_width = 4;
+        auto diff = PagesConfigDiff::compute(base, to);
+        check(diff.gridChanged && !diff.isEmpty(), "grid changed");
+    }
+
+    // 14. From and to no pages
+    {
+        PagesConfig empty = config({});
+        auto added = PagesConfigDiff::compute(empty, base);
+        auto removed = PagesConfigDiff::compute(base, empty);
+        check(added.pages.size() == 3 && added.pages[2].isInserted() && added.removedPages.empty() &&
+              removed.pages.empty() && removed.removedPages == std::vector<int>({0, 1, 2}),
+              "pages from and to nothing");
+    }
+
+    // 15. Patch: moved widgets are moved, resized ones recreated
+    {
+        PagesConfig to = base;
+        to.pages[0].widgets[0].y = 1;
+        to.pages[0].widgets[1].h = 2;
+        auto diff = PagesConfigDiff::compute(base, to);
+        auto patch = WidgetPatch::compute(base.pages[0].widgets, diff.pages[0], 3, 3);
+        check(patch.moved.size() == 1 && patch.moved[0].first == 0 && patch.moved[0].second.y == 1 &&
+              patch.released == std::vector<int>{1} &&
+              patch.created.size() == 1 && patch.created[0].h == 2,
+              "patch move and resize");
+    }
+
+    // 16. Patch: a widget skipped out of the grid moves into it
+    {
+        PagesConfig from = config({page({light("a1", 0, 0), light("a2", 3, 0)})});
+        PagesConfig to = config({page({light("a1", 0, 0), light("a2", 1, 1)})});
+        auto diff = PagesConfigDiff::compute(from, to);
+
+        // Only a1 was built, a2 did not fit
+        std::vector<WidgetConfig> built = {from.pages[0].widgets[0]};
+        auto patch = WidgetPatch::compute(built, diff.pages[0], 3, 3);
+        check(diff.pages[0].moved.size() == 1 && patch.moved.empty() && patch.released.empty() &&
+              patch.created.size() == 1 && patch.created[0].io_id == "a2" &&
+              patch.created[0].x == 1 && patch.created[0].y == 1,
+              "patch creates a widget missing from the page");
+    }
+
+    // 17. Patch: a widget moved out of the grid is released
+    {
+        PagesConfig from = config({page({light("a1", 0, 0), light("a2", 1, 0)})});
+        PagesConfig to = config({page({light("a1", 0, 0), light("a2", 2, 3)})});
+        auto diff = PagesConfigDiff::compute(from, to);
+        auto patch = WidgetPatch::compute(from.pages[0].widgets, diff.pages[0], 3, 3);
+        check(diff.pages[0].moved.size() == 1 && patch.moved.empty() &&
+              patch.released == std::vector<int>{1} && patch.created.empty(),
+              "patch releases a widget moved off the grid");
+    }
+
+    return testResult();
+}
@@ -0,0 +1,349 @@
+#include "perf_hud.h"
+#include "flux.h"
+#include "animation_scheduler.h"
+#include "font_engine.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#else
+#include <malloc.h>
+#include <chrono>
+#endif
+
+static const char* TAG = "perf";
+
+// Statistics window, also the overlay refresh rate
+static const uint32_t SAMPLE_PERIOD_MS = 1000;
+
+// Areas kept per frame, LVGL redraws the whole screen past as many (LV_INV_BUF_SIZE)
+static const size_t MAX_INVALIDATED_AREAS = 32;
+
+// Pixels covered by the union of the areas, each pixel counted once
+static uint32_t coveredPixels(const std::vector<lv_area_t>& areas)
+{
+    // Vertical slabs between the x edges, merged y spans in each slab
+    std::vector<int32_t> xs;
+    for (const lv_area_t& area : areas)
+    {
+        xs.push_back(area.x1);
+        xs.push_back(area.x2 + 1);
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+    uint32_t pixels = 0;
+    std::vector<std::pair<int32_t, int32_t>> spans;
+    for (size_t i = 0; i + 1 < xs.size(); i++)
+    {
+        spans.clear();
+        for (const lv_area_t& area : areas)
+        {
+            if (area.x1 <= xs[i] && area.x2 >= xs[i + 1] - 1)
+                spans.push_back({area.y1, area.y2 + 1});
+        }
+        std::sort(spans.begin(), spans.end());
+
+        int32_t height = 0;
+        int32_t end = INT32_MIN;
+        for (const auto& span : spans)
+        {
+            int32_t start = std::max(span.first, end);
+            if (span.second > start)
+                height += span.second - start;
+            end = std::max(end, span.second);
+        }
+        pixels += height * (xs[i + 1] - xs[i]);
+    }
+    return pixels;
+}
+
+static uint64_t nowUs()
+{
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+#endif
+}
+
+PerfHud& PerfHud::getInstance()
+{
+    static PerfHud instance;
+    return instance;
+}
+
+void PerfHud::init(lv_display_t* disp)
+{
+    display = disp;
+
+#ifndef ESP_PLATFORM
+    const char* hud = getenv("CALAOS_PERF_HUD");
+    if (hud && atoi(hud) > 0)
+        visible = true;
+
+    const char* log = getenv("CALAOS_PERF_LOG");
+    if (log && atoi(log) > 0)
+        logIntervalMs = atoi(log) * 1000;
+#endif
+
+    updateActive();
+}
+
+void PerfHud::setVisible(bool visible)
+{
+    this->visible = visible;
+    updateActive();
+    ESP_LOGI(TAG, "Performance overlay %s", visible ? "shown" : "hidden");
+}
+
+void PerfHud::setLogInterval(uint32_t intervalMs)
+{
+    logIntervalMs = intervalMs;
+    updateActive();
+}
+
+void PerfHud::recordHandlerTime(uint32_t us)
+{
+    if (!active)
+        return;
+
+    window.handlerUs += us;
+    window.handlerMaxUs = std::max(window.handlerMaxUs, us);
+    window.handlerCalls++;
+}
+
+void PerfHud::updateActive()
+{
+    if (!display)
+        return;
+
+    bool wanted = visible || logIntervalMs > 0;
+
+    if (wanted && !active)
+    {
+        lv_display_add_event_cb(display, displayEventCb, LV_EVENT_INVALIDATE_AREA, this);
+        lv_display_add_event_cb(display, displayEventCb, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(display, displayEventCb, LV_EVENT_RENDER_START, this);
+        lv_display_add_event_cb(display, displayEventCb, LV_EVENT_RENDER_READY, this);
+        lv_display_add_event_cb(display, displayEventCb, LV_EVENT_REFR_READY, this);
+        timer = lv_timer_create(timerCb, SAMPLE_PERIOD_MS, this);
+
+        window = Window();
+        invalidated.clear();
+        rendering = false;
+        windowStartUs = nowUs();
+        lastLogUs = windowStartUs;
+        lv_timer_get_idle();  // restart LVGL's idle measurement
+        active = true;
+    }
+    else if (!wanted && active)
+    {
+        lv_display_remove_event_cb_with_user_data(display, displayEventCb, this);
+        lv_timer_delete(timer);
+        timer = nullptr;
+        active = false;
+    }
+
+    if (visible && !label)
+    {
+        createLabel();
+    }
+    else if (!visible && label)
+    {
+        lv_obj_delete(label);
+        label = nullptr;
+    }
+}
+
+void PerfHud::createLabel()
+{
+    // System layer: above every page and unaffected by screen changes
+    label = lv_label_create(lv_display_get_layer_sys(display));
+    lv_obj_set_style_text_font(label, FontEngine::get(FontWeight::Regular, 22), LV_PART_MAIN);
+    lv_obj_set_style_text_color(label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(label, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(label, LV_OPA_70, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(label, 6, LV_PART_MAIN);
+    lv_obj_align(label, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_label_set_text(label, "perf: sampling...");
+}
+
+void PerfHud::displayEventCb(lv_event_t* e)
+{
+    PerfHud* self = static_cast<PerfHud*>(lv_event_get_user_data(e));
+    uint64_t now = nowUs();
+
+    switch (lv_event_get_code(e))
+    {
+        case LV_EVENT_REFR_START:
+            self->refreshStartUs = now;
+            break;
+
+        case LV_EVENT_INVALIDATE_AREA:
+        {
+            // Also sent while rendering to probe the buffer rounding, not a redraw
+            if (self->rendering)
+                break;
+
+            // Clipped to the screen already. Like LVGL, skip areas already covered
+            // and redraw the whole screen when too many are pending.
+            const lv_area_t* area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+            auto& areas = self->invalidated;
+            bool covered = std::any_of(areas.begin(), areas.end(), [area](const lv_area_t& other)
+            {
+                return area->x1 >= other.x1 && area->y1 >= other.y1 &&
+                       area->x2 <= other.x2 && area->y2 <= other.y2;
+            });
+            if (covered)
+                break;
+
+            if (areas.size() >= MAX_INVALIDATED_AREAS)
+            {
+                lv_area_t screen;
+                lv_area_set(&screen, 0, 0,
+                            lv_display_get_horizontal_resolution(self->display) - 1,
+                            lv_display_get_vertical_resolution(self->display) - 1);
+                areas.assign(1, screen);
+            }
+            else
+            {
+                areas.push_back(*area);
+            }
+            break;
+        }
+
+        case LV_EVENT_RENDER_START:
+        {
+            uint32_t pixels = coveredPixels(self->invalidated);
+            self->invalidated.clear();
+            self->rendering = true;
+
+            self->window.invalidatedPx += pixels;
+            self->window.invalidatedMaxPx = std::max(self->window.invalidatedMaxPx, pixels);
+            self->renderStartUs = now;
+            break;
+        }
+
+        case LV_EVENT_RENDER_READY:
+            self->window.frames++;
+            self->window.renderUs += now - self->renderStartUs;
+            break;
+
+        case LV_EVENT_REFR_READY:
+        {
+            self->rendering = false;
+            uint32_t elapsed = now - self->refreshStartUs;
+            self->window.refreshUs += elapsed;
+            self->window.refreshMaxUs = std::max(self->window.refreshMaxUs, elapsed);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void PerfHud::timerCb(lv_timer_t* timer)
+{
+    static_cast<PerfHud*>(lv_timer_get_user_data(timer))->sample();
+}
+
+void PerfHud::sample()
+{
+    uint64_t now = nowUs();
+    uint64_t elapsedUs = std::max<uint64_t>(now - windowStartUs, 1);
+    const Window& w = window;
+
+    uint32_t fps = (w.frames * 1000000ULL + elapsedUs / 2) / elapsedUs;
+    uint32_t cpu = 100 - lv_timer_get_idle();
+    uint32_t refreshAvgUs = w.frames ? w.refreshUs / w.frames : 0;
+    uint32_t renderAvgUs = w.frames ? w.renderUs / w.frames : 0;
+    uint32_t handlerAvgUs = w.handlerCalls ? w.handlerUs / w.handlerCalls : 0;
+
+    uint32_t screenPx = lv_display_get_horizontal_resolution(display) *
+                        lv_display_get_vertical_resolution(display);
+    float invAvgPct = w.frames ? 100.0f * w.invalidatedPx / w.frames / screenPx : 0.0f;
+    float invMaxPct = 100.0f * w.invalidatedMaxPx / screenPx;
+
+    size_t queue = AppDispatcher::getInstance().getQueueDepth();
+    size_t queueMax = AppDispatcher::getInstance().takeQueueHighWater();
+
+    const AnimationScheduler& scheduler = AnimationScheduler::getInstance();
+    size_t anims = scheduler.getActiveCount();
+    size_t animsVisible = scheduler.getVisibleCount();
+
+    FontEngine::Stats fonts = FontEngine::getInstance().getStats();
+
+    // Heap figures differ per platform, format them once for both outputs
+    char heapLabel[64];
+    char heapLog[96];
+#ifdef ESP_PLATFORM
+    size_t heapFree = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    size_t heapMinFree = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    size_t psramFree = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    snprintf(heapLabel, sizeof(heapLabel), "heap %zu KB  psram %zu KB", heapFree / 1024, psramFree / 1024);
+    snprintf(heapLog, sizeof(heapLog), "heap_free=%zu heap_min_free=%zu psram_free=%zu",
+             heapFree, heapMinFree, psramFree);
+#else
+    struct mallinfo2 info = mallinfo2();
+    size_t heapUsed = info.uordblks + info.hblkhd;
+    snprintf(heapLabel, sizeof(heapLabel), "heap %zu KB", heapUsed / 1024);
+    snprintf(heapLog, sizeof(heapLog), "heap_used=%zu", heapUsed);
+#endif
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+    size_t heapLen = strlen(heapLabel);
+    snprintf(heapLabel + heapLen, sizeof(heapLabel) - heapLen, "\nlv_mem %u%%  frag %u%%",
+             mem.used_pct, mem.frag_pct);
+    heapLen = strlen(heapLog);
+    snprintf(heapLog + heapLen, sizeof(heapLog) - heapLen, " lv_mem_used=%u lv_mem_frag_pct=%u",
+             (unsigned)mem.total_size - (unsigned)mem.free_size, mem.frag_pct);
+#endif
+
+    if (label)
+    {
+        char text[256];
+        int len = snprintf(text, sizeof(text), "FPS %u  CPU %u%%\n", fps, cpu);
+
+        // Only render loops that run the LVGL timers themselves report this
+        if (w.handlerCalls)
+            len += snprintf(text + len, sizeof(text) - len, "timer %.1f / %.1f ms\n",
+                            handlerAvgUs / 1000.0f, w.handlerMaxUs / 1000.0f);
+
+        snprintf(text + len, sizeof(text) - len,
+                 "refr %.1f / %.1f ms\n"
+                 "inv %.0f%% / %.0f%%\n"
+                 "%s\n"
+                 "queue %zu / %zu\n"
+                 "anim %zu / %zu\n"
+                 "glyphs %zu KB / %zu KB",
+                 refreshAvgUs / 1000.0f, w.refreshMaxUs / 1000.0f,
+                 invAvgPct, invMaxPct, heapLabel, queue, queueMax, animsVisible, anims,
+                 fonts.cacheBytes / 1024, fonts.cacheLimit / 1024);
+        lv_label_set_text(label, text);
+    }
+
+    if (logIntervalMs && now - lastLogUs >= logIntervalMs * 1000ULL)
+    {
+        lastLogUs = now;
+        ESP_LOGI(TAG, "fps=%u cpu_pct=%u timer_avg_us=%u timer_max_us=%u refr_avg_us=%u refr_max_us=%u "
+                 "render_avg_us=%u inv_avg_pct=%.1f inv_max_pct=%.1f queue=%zu queue_max=%zu "
+                 "anims=%zu anims_visible=%zu glyphs=%zu glyph_cache=%zu glyph_misses=%llu %s",
+                 fps, cpu, handlerAvgUs, w.handlerMaxUs, refreshAvgUs, w.refreshMaxUs,
+                 renderAvgUs, invAvgPct, invMaxPct, queue, queueMax, anims, animsVisible,
+                 fonts.glyphs, fonts.cacheBytes, (unsigned long long)fonts.misses, heapLog);
+    }
+
+    window = Window();
+    windowStartUs = now;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Runtime performance overlay and frame statistics
+ *
+ * Collects FPS, render loop CPU load, lv_timer_handler() time, refresh time,
+ * invalidated area per frame, heap use, dispatcher queue depth and running
+ * animations (visible / started) over one second windows. The numbers can be shown in an overlay on the system layer
+ * and/or written as a periodic key=value log line for panels nobody looks at.
+ *
+ * Nothing is measured while both the overlay and the log are off.
+ * On Linux, CALAOS_PERF_HUD=1 shows the overlay at startup and
+ * CALAOS_PERF_LOG=<seconds> enables the log (see --perf-hud / --perf-log).
+ * A long press on the page indicator toggles the overlay at runtime.
+ *
+ * All methods must be called from the LVGL context (display lock held).
+ */
+class PerfHud
+{
+public:
+    /**
+     * @brief Get singleton instance
+     */
+    static PerfHud& getInstance();
+
+    /**
+     * @brief Attach to a display and apply the startup settings
+     * @param disp Display to measure and draw the overlay on
+     */
+    void init(lv_display_t* disp);
+
+    /**
+     * @brief Show or hide the overlay
+     */
+    void setVisible(bool visible);
+    bool isVisible() const { return visible; }
+    void toggle() { setVisible(!visible); }
+
+    /**
+     * @brief Log the statistics every intervalMs milliseconds, 0 disables
+     */
+    void setLogInterval(uint32_t intervalMs);
+
+    /**
+     * @brief Report the duration of one lv_timer_handler() call
+     * @param us Duration in microseconds
+     *
+     * Called by render loops that run the LVGL timers themselves.
+     */
+    void recordHandlerTime(uint32_t us);
+
+private:
+    PerfHud() = default;
+
+    PerfHud(const PerfHud&) = delete;
+    PerfHud& operator=(const PerfHud&) = delete;
+
+    struct Window
+    {
+        uint32_t frames = 0;
+        uint64_t refreshUs = 0;
+        uint32_t refreshMaxUs = 0;
+        uint64_t renderUs = 0;
+        uint64_t handlerUs = 0;
+        uint32_t handlerMaxUs = 0;
+        uint32_t handlerCalls = 0;
+        uint64_t invalidatedPx = 0;
+        uint32_t invalidatedMaxPx = 0;
+    };
+
+    /**
+     * @brief Start or stop measuring depending on overlay and log state
+     */
+    void updateActive();
+
+    /**
+     * @brief Close the current window, refresh the overlay and log if due
+     */
+    void sample();
+
+    void createLabel();
+
+    static void displayEventCb(lv_event_t* e);
+    static void timerCb(lv_timer_t* timer);
+
+    lv_display_t* display = nullptr;
+    lv_obj_t* label = nullptr;
+    lv_timer_t* timer = nullptr;
+    bool visible = false;
+    bool active = false;
+    uint32_t logIntervalMs = 0;
+    uint64_t lastLogUs = 0;
+
+    Window window;
+    std::vector<lv_area_t> invalidated;  // Areas to redraw in the next frame
+    bool rendering = false;
+    uint64_t windowStartUs = 0;
+    uint64_t refreshStartUs = 0;
+    uint64_t renderStartUs = 0;
+};
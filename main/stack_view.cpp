@@ -103,6 +103,12 @@ void StackView::render()
         current->render();
 }
 
+bool StackView::hasRunningAnimations()
+{
+    PageBase* current = currentPage();
+    return animating || (current && current->hasRunningAnimations());
+}
+
 void StackView::hideAllPages()
 {
     for (auto& page : pageStack)
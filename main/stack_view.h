@@ -29,6 +29,7 @@ public:
     PageBase* currentPage() const;
     
     void render();
+    bool hasRunningAnimations();
 
 private:
     lv_obj_t *parentObj;
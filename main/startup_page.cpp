@@ -1,10 +1,10 @@
 #include "startup_page.h"
 #include "theme.h"
+#include "font_engine.h"
 #include "images_generated.h"
 #include "calaos_page.h"
 #include "app_main.h"
 #include "logging.h"
-#include "../hal/hal.h"
 #include "provisioning_manager.h"
 #include "../flux/app_dispatcher.h"
 
@@ -14,7 +14,8 @@ static const char* TAG = "StartupPage";
 extern AppMain* g_appMain;
 
 StartupPage::StartupPage(lv_obj_t *parent):
-    PageBase(parent)
+    PageBase(parent),
+    uiGuard_(UiQueue::makeGuard())
 {
     // Initialize Calaos discovery and provisioning requester
     calaosDiscovery = std::make_unique<CalaosDiscovery>();
@@ -38,7 +39,7 @@ StartupPage::StartupPage(lv_obj_t *parent):
     networkStatusLabel = std::make_unique<lvgl_cpp::Label>(*this);
     networkStatusLabel->setText("Initializing network...");
     networkStatusLabel->align(LV_ALIGN_BOTTOM_MID, 0, -120);
-    networkStatusLabel->setTextFont(&roboto_light_26);
+    networkStatusLabel->setTextFont(FontEngine::get(FontWeight::Light, 26));
 
     lv_obj_set_style_text_color(networkStatusLabel->get(), lv_color_white(), LV_PART_MAIN);
 
@@ -65,7 +66,7 @@ StartupPage::StartupPage(lv_obj_t *parent):
     // Subscribe to state changes from AppStore
     subscriptionId_ = AppStore::getInstance().subscribe([this](const AppState& state)
     {
-        onStateChanged(state);
+        postStateChange(state);
     });
 
     // Get initial state
@@ -133,7 +134,7 @@ void StartupPage::createProvisioningUI()
     provisioningCodeLabel->setText("------");
     lv_obj_align(provisioningCodeLabel->get(), LV_ALIGN_CENTER, 0, -50);
     lv_obj_set_style_text_color(provisioningCodeLabel->get(), theme_color_white, LV_PART_MAIN);
-    lv_obj_set_style_text_font(provisioningCodeLabel->get(), &roboto_bold_50, LV_PART_MAIN);
+    lv_obj_set_style_text_font(provisioningCodeLabel->get(), FontEngine::get(FontWeight::Bold, 50), LV_PART_MAIN);
     lv_obj_set_style_text_align(provisioningCodeLabel->get(), LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
     lv_obj_add_flag(provisioningCodeLabel->get(), LV_OBJ_FLAG_HIDDEN); // Initially hidden
 
@@ -142,7 +143,7 @@ void StartupPage::createProvisioningUI()
     provisioningInstructionLabel->setText("Add this code in\nCalaos Installer");
     lv_obj_align(provisioningInstructionLabel->get(), LV_ALIGN_CENTER, 0, 150);
     lv_obj_set_style_text_color(provisioningInstructionLabel->get(), theme_color_white, LV_PART_MAIN);
-    lv_obj_set_style_text_font(provisioningInstructionLabel->get(), &roboto_medium_24, LV_PART_MAIN);
+    lv_obj_set_style_text_font(provisioningInstructionLabel->get(), FontEngine::get(FontWeight::Medium, 24), LV_PART_MAIN);
     lv_obj_set_style_text_align(provisioningInstructionLabel->get(), LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
     lv_obj_add_flag(provisioningInstructionLabel->get(), LV_OBJ_FLAG_HIDDEN); // Initially hidden
 }
@@ -353,6 +354,46 @@ void StartupPage::render()
     }
 }
 
+bool StartupPage::hasRunningAnimations()
+{
+    bool networkStatusShown = (!lastNetworkState.isReady || lastCalaosServerState.isDiscovering) &&
+                              !lastProvisioningState.needsCodeDisplay();
+
+    return logoDropAnimation.isRunning() ||
+           logoMoveUpAnimation.isRunning() ||
+           codeBoxAppearAnimation.isRunning() ||
+           codeBoxFadeInAnimation.isRunning() ||
+           codeTextAppearAnimation.isRunning() ||
+           instructionTextAppearAnimation.isRunning() ||
+           (networkStatusShown && networkStatusAnimation.isRunning());
+}
+
+void StartupPage::postStateChange(const AppState& state)
+{
+    // Dispatcher thread: copy the parts of the state this page shows, the
+    // IO states and the config are not used here and can be large
+    AppState snapshot;
+    snapshot.network = state.network;
+    snapshot.ntp = state.ntp;
+    snapshot.calaosServer = state.calaosServer;
+    snapshot.provisioning = state.provisioning;
+    snapshot.websocket = state.websocket;
+
+    // IO state updates after connection don't concern this page
+    if (snapshot == postedState_ &&
+        snapshot.websocket.authErrorType == postedState_.websocket.authErrorType &&
+        snapshot.websocket.authHttpCode == postedState_.websocket.authHttpCode &&
+        snapshot.websocket.authErrorString == postedState_.websocket.authErrorString)
+        return;
+
+    postedState_ = snapshot;
+
+    UiQueue::getInstance().post(uiGuard_, [this, snapshot]()
+    {
+        onStateChanged(snapshot);
+    });
+}
+
 void StartupPage::onStateChanged(const AppState& state)
 {
     // Check if application is shutting down to avoid deadlock
@@ -367,18 +408,6 @@ void StartupPage::onStateChanged(const AppState& state)
              state.calaosServer.isDiscovering, state.calaosServer.hasServers(),
              static_cast<int>(state.provisioning.status));
 
-    // Lock LVGL display for thread-safe UI updates
-    // Use a timeout loop to avoid deadlock during shutdown
-    while (!HAL::getInstance().getDisplay().tryLock(100))
-    {
-        // Check if we should abort due to shutdown
-        if (AppDispatcher::getInstance().isStopping())
-        {
-            ESP_LOGD(TAG, "Aborting state change - application is shutting down");
-            return;
-        }
-    }
-
     // Check if network state has changed
     bool networkStateChanged = (state.network.isReady != lastNetworkState.isReady ||
                                state.network.hasTimeout != lastNetworkState.hasTimeout ||
@@ -421,7 +450,7 @@ void StartupPage::onStateChanged(const AppState& state)
             networkStatusLabel->setText("Network connection failed\nPlease connect WiFi or Ethernet\nand restart the device");
             lv_obj_set_style_text_color(networkStatusLabel->get(), theme_color_red, LV_PART_MAIN);
             lv_obj_set_style_opa(networkStatusLabel->get(), LV_OPA_COVER, LV_PART_MAIN);
-            networkStatusLabel->setTextFont(&roboto_regular_26);
+            networkStatusLabel->setTextFont(FontEngine::get(FontWeight::Regular, 26));
 
             // Hide the spinner on timeout
             lv_obj_add_flag(networkSpinner->get(), LV_OBJ_FLAG_HIDDEN);
@@ -898,9 +927,6 @@ void StartupPage::onStateChanged(const AppState& state)
     lastCalaosServerState = state.calaosServer;
     lastProvisioningState = state.provisioning;
     lastWebSocketState = state.websocket;
-
-    // Unlock LVGL display
-    HAL::getInstance().getDisplay().unlock();
 }
 
 // void StartupPage::testButtonCb(lv_event_t* e)
@@ -8,6 +8,7 @@
 #include "provisioning_requester.h"
 #include "calaos_websocket_manager.h"
 #include "lvgl_timer.h"
+#include "ui_queue.h"
 #include <memory>
 
 class StartupPage: public PageBase
@@ -16,6 +17,7 @@ public:
     StartupPage(lv_obj_t *parent);
     ~StartupPage();
     void render() override;
+    bool hasRunningAnimations() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> logo;
@@ -55,6 +57,7 @@ private:
     void hideProvisioningUI();
     void showVerifyingUI();
     void hideVerifyingUI();
+    void postStateChange(const AppState& state);
     void onStateChanged(const AppState& state);
 
     NetworkState lastNetworkState;
@@ -63,4 +66,10 @@ private:
     ProvisioningState lastProvisioningState;
     CalaosWebSocketState lastWebSocketState;
     SubscriptionId subscriptionId_;
+
+    // Last state posted to the render thread, owned by the dispatcher thread
+    AppState postedState_;
+
+    // Drops posted state changes once the page is destroyed
+    UiQueue::Guard uiGuard_;
 };
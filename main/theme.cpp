@@ -1,4 +1,5 @@
 #include "theme.h"
+#include "font_engine.h"
 
 const lv_color_t theme_color_blue = LV_COLOR_MAKE(0x3A, 0xB4, 0xD7);
 const lv_color_t theme_color_yellow = LV_COLOR_MAKE(0xFF, 0xDA, 0x5A);
@@ -9,4 +10,119 @@ const lv_color_t theme_color_black = LV_COLOR_MAKE(0x17, 0x17, 0x17);
 const lv_color_t theme_color_widget_bg_off = LV_COLOR_MAKE(0x1A, 0x1A, 0x1A);
 const lv_color_t theme_color_widget_bg_on = LV_COLOR_MAKE(0x0f, 0x1f, 0x2a);
 const lv_color_t theme_color_widget_border_off = LV_COLOR_MAKE(0x2A, 0x2A, 0x2A);
-const lv_color_t theme_color_widget_border_on = LV_COLOR_MAKE(0x3A, 0xB4, 0xD7);
\ No newline at end of file
+const lv_color_t theme_color_widget_border_on = LV_COLOR_MAKE(0x3A, 0xB4, 0xD7);
+
+static void initStyles(ThemeStyles& s)
+{
+    lv_style_init(&s.widget);
+    lv_style_set_bg_color(&s.widget, theme_color_widget_bg_off);
+    lv_style_set_bg_opa(&s.widget, LV_OPA_COVER);
+    lv_style_set_border_color(&s.widget, theme_color_widget_border_off);
+    lv_style_set_border_width(&s.widget, 2);
+    lv_style_set_radius(&s.widget, 20);
+    lv_style_set_pad_all(&s.widget, 16);
+
+    lv_style_init(&s.widgetOn);
+    lv_style_set_bg_color(&s.widgetOn, theme_color_widget_bg_on);
+    lv_style_set_border_color(&s.widgetOn, theme_color_widget_border_on);
+
+    lv_style_init(&s.widgetError);
+    lv_style_set_bg_color(&s.widgetError, lv_color_make(0x40, 0x20, 0x20));
+    lv_style_set_border_color(&s.widgetError, theme_color_red);
+    lv_style_set_radius(&s.widgetError, 8);
+    lv_style_set_pad_all(&s.widgetError, 8);
+
+    lv_style_init(&s.textCenter);
+    lv_style_set_text_align(&s.textCenter, LV_TEXT_ALIGN_CENTER);
+
+    // Thin track with horizontal padding so the knob stays inside the widget
+    lv_style_init(&s.sliderTrack);
+    lv_style_set_bg_color(&s.sliderTrack, theme_color_widget_bg_off);
+    lv_style_set_bg_opa(&s.sliderTrack, LV_OPA_COVER);
+    lv_style_set_radius(&s.sliderTrack, 7);
+    lv_style_set_border_width(&s.sliderTrack, 1);
+    lv_style_set_border_color(&s.sliderTrack, theme_color_widget_border_off);
+    lv_style_set_pad_left(&s.sliderTrack, 15);
+    lv_style_set_pad_right(&s.sliderTrack, 15);
+
+    lv_style_init(&s.sliderIndicator);
+    lv_style_set_bg_color(&s.sliderIndicator, theme_color_blue);
+    lv_style_set_radius(&s.sliderIndicator, 7);
+
+    lv_style_init(&s.sliderKnob);
+    lv_style_set_bg_color(&s.sliderKnob, theme_color_white);
+    lv_style_set_radius(&s.sliderKnob, LV_RADIUS_CIRCLE);
+    lv_style_set_pad_all(&s.sliderKnob, 6);
+    lv_style_set_shadow_width(&s.sliderKnob, 4);
+    lv_style_set_shadow_color(&s.sliderKnob, theme_color_blue);
+    lv_style_set_shadow_opa(&s.sliderKnob, 100);
+
+    lv_style_init(&s.page);
+    lv_style_set_bg_color(&s.page, theme_color_black);
+    lv_style_set_bg_opa(&s.page, LV_OPA_COVER);
+    lv_style_set_pad_all(&s.page, 0);
+
+    lv_style_init(&s.pageDot);
+    lv_style_set_radius(&s.pageDot, LV_RADIUS_CIRCLE);
+    lv_style_set_border_width(&s.pageDot, 0);
+    lv_style_set_bg_color(&s.pageDot, lv_color_make(0x66, 0x66, 0x66));
+    lv_style_set_bg_opa(&s.pageDot, LV_OPA_COVER);
+
+    lv_style_init(&s.pageDotActive);
+    lv_style_set_bg_color(&s.pageDotActive, theme_color_blue);
+}
+
+const ThemeStyles& theme_styles()
+{
+    static ThemeStyles styles;
+    static bool initialized = false;
+
+    if (!initialized)
+    {
+        initStyles(styles);
+        initialized = true;
+    }
+
+    return styles;
+}
+
+struct TextStyleDef
+{
+    FontWeight weight;
+    int size;
+    lv_color_t color;
+};
+
+// Indexed by ThemeText
+static const TextStyleDef textStyleDefs[] =
+{
+    { FontWeight::Regular, 24, theme_color_blue },
+    { FontWeight::Light, 48, theme_color_yellow },
+    { FontWeight::Regular, 22, theme_color_white },
+    { FontWeight::Regular, 24, theme_color_red },
+    { FontWeight::Medium, 28, theme_color_white },
+    { FontWeight::Regular, 24, theme_color_yellow },
+    { FontWeight::Light, 22, LV_COLOR_MAKE(0xAA, 0xAA, 0xAA) },
+    { FontWeight::Medium, 24, theme_color_white },
+};
+
+static_assert(sizeof(textStyleDefs) / sizeof(textStyleDefs[0]) == static_cast<size_t>(ThemeText::Count),
+              "textStyleDefs must list every ThemeText");
+
+const lv_style_t* theme_text_style(ThemeText text)
+{
+    static lv_style_t styles[static_cast<size_t>(ThemeText::Count)];
+    static bool initialized[static_cast<size_t>(ThemeText::Count)] = {};
+
+    size_t index = static_cast<size_t>(text);
+    if (!initialized[index])
+    {
+        const TextStyleDef& def = textStyleDefs[index];
+        lv_style_init(&styles[index]);
+        lv_style_set_text_font(&styles[index], FontEngine::get(def.weight, def.size));
+        lv_style_set_text_color(&styles[index], def.color);
+        initialized[index] = true;
+    }
+
+    return &styles[index];
+}
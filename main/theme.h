@@ -12,4 +12,54 @@ extern const lv_color_t theme_color_black;
 extern const lv_color_t theme_color_widget_bg_off;
 extern const lv_color_t theme_color_widget_bg_on;
 extern const lv_color_t theme_color_widget_border_off;
-extern const lv_color_t theme_color_widget_border_on;
\ No newline at end of file
+extern const lv_color_t theme_color_widget_border_on;
+
+/**
+ * @brief Styles shared by all widgets and pages
+ *
+ * Objects attach them by reference with lv_obj_add_style() instead of
+ * carrying their own local styles, so a page of widgets shares one copy of
+ * each property. The ON state of a widget is LV_STATE_CHECKED. Local styles
+ * are only used for properties that are animated.
+ *
+ * The styles are created on the first call of theme_styles(), from the LVGL
+ * thread, and never change afterwards.
+ */
+struct ThemeStyles
+{
+    lv_style_t widget;          ///< Widget card, OFF colors
+    lv_style_t widgetOn;        ///< Widget card ON colors, with LV_STATE_CHECKED
+    lv_style_t widgetError;     ///< Card of a widget that cannot be displayed
+    lv_style_t textCenter;      ///< Centered text, combined with a text style
+
+    lv_style_t sliderTrack;     ///< LV_PART_MAIN of the dimmer sliders
+    lv_style_t sliderIndicator; ///< LV_PART_INDICATOR
+    lv_style_t sliderKnob;      ///< LV_PART_KNOB
+
+    lv_style_t page;            ///< Page tab: black, no padding
+    lv_style_t pageDot;         ///< Page indicator dot
+    lv_style_t pageDotActive;   ///< Dot of the visible page, with LV_STATE_CHECKED
+};
+
+const ThemeStyles& theme_styles();
+
+enum class ThemeText
+{
+    Title,          ///< Widget name: Regular 24, blue
+    Value,          ///< Main value: Light 48, yellow
+    Caption,        ///< Secondary text: Regular 22, white
+    ErrorIcon,      ///< Regular 24, red
+    ErrorTitle,     ///< Medium 28, white
+    ErrorDetail,    ///< Regular 24, yellow
+    ErrorHint,      ///< Light 22, grey
+    PageMessage,    ///< Message on an empty page: Medium 24, white
+    Count
+};
+
+/**
+ * @brief Shared font and color style of a kind of text
+ *
+ * Each style is created the first time it is asked for, so the font it
+ * uses is only created once a label needs it.
+ */
+const lv_style_t* theme_text_style(ThemeText text);
@@ -0,0 +1,1045 @@
+// Scripted UI benchmark on the headless display.
+// Builds a synthetic remote_ui_config_update with N pages of M widgets, feeds
+// it through CalaosWebSocketManager as if it came from the server and drives
+// the real StackView/CalaosPage/widget code through page swipes, light toggle
+// bursts, full config reloads, layout edits, grid size changes, an IO state
+// storm, the light animation frames on their own, full style refreshes and
+// an idle screen.
+// Time is virtual (60 Hz frames), so every run renders the same frames; only
+// the measured CPU time varies. Results are written as JSON: frame time
+// percentiles, LVGL refresh, render and flush time, event apply latency, page
+// rebuild time, style refresh time, object and style counts, style memory,
+// pooled widgets, peak heap and glyph cache usage.
+// Exits with status 2 when objects pile up across grid reloads: each reload
+// back to the original grid must leave as many objects as the previous one.
+//
+// Usage: ui_bench [--pages N] [--widgets M] [--swipes N] [--bursts N]
+//                 [--reloads N] [--edits N] [--grid-reloads N] [--storm N]
+//                 [--image-loops N] [--style-refreshes N] [--long-names N]
+//                 [--idle-frames N] [--output file.json] [--verbose]
+
+#include "hal.h"
+#include "flux.h"
+#include "stack_view.h"
+#include "calaos_page.h"
+#include "calaos_websocket_manager.h"
+#include "widget_factory.h"
+#include "font_engine.h"
+#include "image_sequence_animator.h"
+#include "images_generated.h"
+#include "ui_queue.h"
+#include "linux/virtual_clock.h"
+#include "logging.h"
+#include "core/lv_obj_private.h"
+#include "core/lv_obj_style_private.h"
+#include <nlohmann/json.hpp>
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+static const char* TAG = "ui_bench";
+
+// Virtual time per frame (60 Hz)
+static const uint32_t FRAME_MS = 16;
+
+// Frames spent dragging a swipe and letting the tabview snap afterwards
+static const int SWIPE_DRAG_FRAMES = 12;
+static const int SWIPE_SETTLE_FRAMES = 40;
+
+// Frames rendered after toggles/reloads/storms so animations run to the end
+static const int SETTLE_FRAMES = 30;
+
+// Sentinel IO dispatched after a batch of messages; once the dispatcher has
+// delivered it, every earlier event has been applied to the UI
+static const char* SYNC_IO = "ui_bench_sync";
+
+static uint64_t nowUs()
+{
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+}
+
+static size_t heapInUse()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static uint32_t countObjects(lv_obj_t* obj)
+{
+    if (!obj)
+        return 0;
+
+    uint32_t count = 1;
+    uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; i++)
+        count += countObjects(lv_obj_get_child(obj, i));
+    return count;
+}
+
+// Style list entries of a tree, how many of them are local styles and the
+// heap they use: the style lists plus the local styles and their properties
+static void countStyles(lv_obj_t* obj, uint32_t& styles, uint32_t& localStyles, size_t& bytes)
+{
+    if (!obj)
+        return;
+
+    styles += obj->style_cnt;
+    bytes += obj->style_cnt * sizeof(lv_obj_style_t);
+    for (uint32_t i = 0; i < obj->style_cnt; i++)
+    {
+        if (!obj->styles[i].is_local)
+            continue;
+
+        const lv_style_t* style = obj->styles[i].style;
+        localStyles++;
+        bytes += sizeof(lv_style_t) + style->prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+    }
+
+    uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; i++)
+        countStyles(lv_obj_get_child(obj, i), styles, localStyles, bytes);
+}
+
+struct Options
+{
+    int pages = 12;
+    int widgets = 9;
+    int swipes = 20;
+    int bursts = 20;
+    int reloads = 5;
+    int edits = 5;
+    int gridReloads = 10;
+    int storm = 100;
+    int imageLoops = 20;
+    int styleRefreshes = 20;
+    int longNames = 3;
+    int idleFrames = 2400;
+    std::string output;
+    bool verbose = false;
+};
+
+// Millisecond samples reduced to percentiles
+class Samples
+{
+public:
+    void add(double ms) { values_.push_back(ms); }
+    bool empty() const { return values_.empty(); }
+    double last() const { return values_.back(); }
+
+    json summary() const
+    {
+        json j;
+        j["count"] = values_.size();
+        if (values_.empty())
+            return j;
+
+        std::vector<double> sorted = values_;
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0;
+        for (double v : sorted)
+            sum += v;
+
+        j["avg_ms"] = round3(sum / sorted.size());
+        j["p50_ms"] = round3(percentile(sorted, 50));
+        j["p90_ms"] = round3(percentile(sorted, 90));
+        j["p99_ms"] = round3(percentile(sorted, 99));
+        j["max_ms"] = round3(sorted.back());
+        return j;
+    }
+
+private:
+    // Nearest-rank percentile
+    static double percentile(const std::vector<double>& sorted, int p)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::max<size_t>(rank, 1) - 1];
+    }
+
+    static double round3(double v) { return std::round(v * 1000.0) / 1000.0; }
+
+    std::vector<double> values_;
+};
+
+struct Scenario
+{
+    std::string name;
+    Samples frame;      // UI command drain + stackView->render() + lv_timer_handler()
+    Samples refresh;    // LVGL refresh cycle (layout + render + flush)
+    Samples render;     // drawing only
+    Samples flush;      // flush callbacks
+    Samples apply;      // message injection until the dispatcher has handled it
+    Samples rebuild;    // first frame after a config, where the pages are rebuilt
+    Samples styles;     // lv_obj_report_style_change() over the whole screen
+    uint32_t renderedFrames = 0;
+    size_t heapPeak = 0;
+    uint32_t objects = 0;
+    uint32_t styleEntries = 0;
+    uint32_t localStyles = 0;
+    size_t styleBytes = 0;
+    size_t pooledWidgets = 0;
+    int32_t objectGrowth = 0;   // objects left over by rebuilds, should stay 0
+};
+
+// Times the LVGL refresh phases from display events
+class FrameProbe
+{
+public:
+    void attach(lv_display_t* disp)
+    {
+        lv_display_add_event_cb(disp, eventCb, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(disp, eventCb, LV_EVENT_RENDER_START, this);
+        lv_display_add_event_cb(disp, eventCb, LV_EVENT_FLUSH_START, this);
+        lv_display_add_event_cb(disp, eventCb, LV_EVENT_FLUSH_FINISH, this);
+        lv_display_add_event_cb(disp, eventCb, LV_EVENT_RENDER_READY, this);
+        lv_display_add_event_cb(disp, eventCb, LV_EVENT_REFR_READY, this);
+    }
+
+    void reset()
+    {
+        refreshUs = renderUs = flushUs = 0;
+        rendered = false;
+    }
+
+    uint64_t refreshUs = 0;
+    uint64_t renderUs = 0;
+    uint64_t flushUs = 0;
+    bool rendered = false;
+
+private:
+    static void eventCb(lv_event_t* e)
+    {
+        FrameProbe* self = static_cast<FrameProbe*>(lv_event_get_user_data(e));
+        uint64_t now = nowUs();
+
+        switch (lv_event_get_code(e))
+        {
+            case LV_EVENT_REFR_START: self->refreshStart = now; break;
+            case LV_EVENT_RENDER_START: self->renderStart = now; break;
+            case LV_EVENT_FLUSH_START: self->flushStart = now; break;
+            case LV_EVENT_FLUSH_FINISH: self->flushUs += now - self->flushStart; break;
+            case LV_EVENT_RENDER_READY:
+                // Flushing happens inside the render phase, keep drawing alone
+                self->renderUs += now - self->renderStart;
+                self->rendered = true;
+                break;
+            case LV_EVENT_REFR_READY: self->refreshUs += now - self->refreshStart; break;
+            default: break;
+        }
+    }
+
+    uint64_t refreshStart = 0;
+    uint64_t renderStart = 0;
+    uint64_t flushStart = 0;
+};
+
+class UiBench
+{
+public:
+    explicit UiBench(const Options& options):
+        options(options)
+    {
+    }
+
+    bool init();
+    json run();
+    void deinit();
+
+    // True when a scenario left objects behind
+    bool leaked() const;
+
+private:
+    // Synthetic server payloads
+    void buildConfig();
+    json configMessage(int revision, const std::function<void(json& pages)>& edit = nullptr) const;
+    json ioChangedMessage(const std::string& id, const std::string& state) const;
+    std::string toggledState(size_t ioIndex);
+
+    // Driving the UI
+    uint64_t requestSync();
+    bool isSynced(uint64_t seq) const { return syncDone.load() >= seq; }
+    void waitSync(uint64_t seq);
+    void applyAndSync(Scenario& scenario, const std::vector<json>& messages);
+    void frame();
+    void frames(int count);
+    void rebuildFrame(Scenario& scenario);
+    void swipe(bool forward);
+
+    // Scenarios
+    Scenario& begin(const std::string& name);
+    void end();
+    void runInitialLoad();
+    void runSwipes();
+    void runToggleBursts();
+    void runReloads();
+    void runEdits();
+    void runGridReloads();
+    void runStorm();
+    void runImageFrames();
+    void runStyleRefreshes();
+    void runIdle();
+
+    json report() const;
+
+    static void pointerRead(lv_indev_t* indev, lv_indev_data_t* data);
+
+    Options options;
+    HAL* hal = nullptr;
+    lv_display_t* display = nullptr;
+    lv_indev_t* pointer = nullptr;
+    std::unique_ptr<StackView> stackView;
+    std::unique_ptr<CalaosWebSocketManager> wsManager;
+    FrameProbe probe;
+
+    // Generated configuration
+    int gridWidth = 3;
+    int gridHeight = 3;
+    struct Io
+    {
+        std::string id;
+        std::string type;
+        std::string name;
+        int page;
+        bool on;
+        int value;
+    };
+    std::vector<Io> ios;
+    int currentPage = 0;
+    bool swipeForward = true;
+
+    // Scripted pointer
+    static bool pointerPressed;
+    static lv_point_t pointerPos;
+
+    // Dispatcher drain tracking
+    uint64_t syncSent = 0;
+    std::atomic<uint64_t> syncDone{0};
+    std::mutex syncMutex;
+    std::condition_variable syncCv;
+
+    std::vector<Scenario> scenarios;
+    Scenario* current = nullptr;
+    size_t heapBaseline = 0;
+    size_t heapPeak = 0;
+};
+
+bool UiBench::pointerPressed = false;
+lv_point_t UiBench::pointerPos = {0, 0};
+
+bool UiBench::init()
+{
+    // The benchmark always renders offscreen on virtual time
+    setenv("CALAOS_DISPLAY_BACKEND", "headless", 1);
+
+    hal = &HAL::getInstance();
+
+    // Per-widget info logs would dominate the measurements
+    if (!options.verbose)
+        esp_log_level_set("*", ESP_LOG_ERROR);
+
+    if (hal->initEssentials() != HalResult::OK)
+    {
+        ESP_LOGE(TAG, "Failed to init HAL");
+        return false;
+    }
+
+    smooth_ui_toolkit::ui_hal::on_get_tick([]() -> uint32_t {
+        return static_cast<uint32_t>(VirtualClock::getInstance().nowMs());
+    });
+
+    display = hal->getDisplay().getLvglDisplay();
+    probe.attach(display);
+
+    pointer = lv_indev_create();
+    lv_indev_set_type(pointer, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(pointer, pointerRead);
+    lv_indev_set_display(pointer, display);
+
+    AppDispatcher::getInstance().subscribe(AppEventType::IoStateReceived, [this](const AppEvent& event)
+    {
+        auto* data = event.getData<IoStateReceivedData>();
+        if (!data || data->ioState.id != SYNC_IO)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(syncMutex);
+            syncDone.store(std::stoull(data->ioState.state));
+        }
+        syncCv.notify_all();
+    });
+
+    // Message parsing goes through the real manager, it is never connected
+    wsManager = std::make_unique<CalaosWebSocketManager>();
+
+    hal->getDisplay().lock(0);
+    stackView = std::make_unique<StackView>(lv_screen_active());
+    stackView->push(std::make_unique<CalaosPage>(lv_screen_active()));
+    hal->getDisplay().unlock();
+
+    buildConfig();
+    frames(2);
+    heapBaseline = heapInUse();
+    heapPeak = heapBaseline;
+
+    return true;
+}
+
+void UiBench::deinit()
+{
+    hal->getDisplay().lock(0);
+    stackView.reset();
+    hal->getDisplay().unlock();
+
+    AppStore::getInstance().shutdown();
+    AppDispatcher::getInstance().shutdown();
+    wsManager.reset();
+
+    if (pointer)
+        lv_indev_delete(pointer);
+    hal->deinit();
+}
+
+void UiBench::buildConfig()
+{
+    // Smallest square grid that fits M 1x1 widgets
+    gridWidth = std::max(1, static_cast<int>(std::ceil(std::sqrt(options.widgets))));
+    gridHeight = std::max(1, (options.widgets + gridWidth - 1) / gridWidth);
+
+    for (int p = 0; p < options.pages; p++)
+    {
+        for (int w = 0; w < options.widgets; w++)
+        {
+            Io io;
+            io.id = "io_" + std::to_string(p) + "_" + std::to_string(w);
+            // Mostly lights, like a real installation, with some sensors and scenarios
+            io.type = w % 4 == 3 ? "Temperature" : w % 7 == 6 ? "Scenario" : "LightSwitch";
+            // The first widgets of a page have names too long for their card
+            io.name = "Bench " + io.id;
+            if (w < options.longNames)
+                io.name += " by the living room window";
+            io.page = p;
+            io.on = false;
+            io.value = 20;
+            ios.push_back(io);
+        }
+    }
+}
+
+json UiBench::configMessage(int revision, const std::function<void(json& pages)>& edit) const
+{
+    json pages = json::array();
+    json ioItems = json::array();
+
+    for (int p = 0; p < options.pages; p++)
+    {
+        json widgets = json::array();
+        for (int w = 0; w < options.widgets; w++)
+        {
+            const Io& io = ios[p * options.widgets + w];
+            widgets.push_back({
+                {"io_id", io.id},
+                {"type", io.type},
+                {"x", w % gridWidth},
+                {"y", w / gridWidth},
+                {"w", 1},
+                {"h", 1},
+            });
+
+            const char* guiType = io.type == "Temperature" ? "temp" :
+                                  io.type == "Scenario" ? "scenario" : "light";
+            ioItems.push_back({
+                {"id", io.id},
+                {"type", io.type == "Temperature" ? "InputTemp" : "OutputLight"},
+                {"gui_type", guiType},
+                {"name", io.name},
+                {"visible", "true"},
+                {"rw", io.type == "Temperature" ? "false" : "true"},
+            });
+        }
+
+        // The revision changes pages_json so every reload is applied, the
+        // layout itself stays the same
+        pages.push_back({{"name", "Page " + std::to_string(p + 1) + " r" + std::to_string(revision)},
+                         {"widgets", widgets}});
+    }
+
+    if (edit)
+        edit(pages);
+
+    return {
+        {"msg", CalaosProtocol::MSG_CONFIG_UPDATE},
+        {"data", {
+            {"name", "ui_bench"},
+            {"room", "Bench"},
+            {"theme", "dark"},
+            {"brightness", 80},
+            {"timeout", 30},
+            {"grid_width", gridWidth},
+            {"grid_height", gridHeight},
+            {"pages", pages},
+            {"io_items", ioItems},
+        }},
+    };
+}
+
+json UiBench::ioChangedMessage(const std::string& id, const std::string& state) const
+{
+    return {
+        {"msg", CalaosProtocol::MSG_EVENT},
+        {"data", {
+            {"type_str", "io_changed"},
+            {"data", {{"id", id}, {"state", state}}},
+        }},
+    };
+}
+
+std::string UiBench::toggledState(size_t ioIndex)
+{
+    Io& io = ios[ioIndex];
+    if (io.type == "Temperature")
+    {
+        io.value = io.value >= 25 ? 18 : io.value + 1;
+        return std::to_string(io.value) + ".5";
+    }
+
+    io.on = !io.on;
+    return io.on ? "true" : "false";
+}
+
+uint64_t UiBench::requestSync()
+{
+    CalaosProtocol::IoState sync;
+    sync.id = SYNC_IO;
+    sync.state = std::to_string(++syncSent);
+    AppDispatcher::getInstance().dispatch(AppEvent(AppEventType::IoStateReceived, IoStateReceivedData{sync}));
+    return syncSent;
+}
+
+void UiBench::waitSync(uint64_t seq)
+{
+    std::unique_lock<std::mutex> lock(syncMutex);
+    syncCv.wait(lock, [this, seq]() { return syncDone.load() >= seq; });
+}
+
+void UiBench::applyAndSync(Scenario& scenario, const std::vector<json>& messages)
+{
+    // Serialize up front so only parsing and applying are measured
+    std::vector<std::string> payloads;
+    payloads.reserve(messages.size());
+    for (const auto& message : messages)
+        payloads.push_back(message.dump());
+
+    uint64_t start = nowUs();
+    for (const auto& payload : payloads)
+        wsManager->injectMessage(payload);
+    waitSync(requestSync());
+    scenario.apply.add((nowUs() - start) / 1000.0);
+
+    heapPeak = std::max(heapPeak, heapInUse());
+    scenario.heapPeak = std::max(scenario.heapPeak, heapInUse());
+}
+
+void UiBench::frame()
+{
+    VirtualClock::getInstance().advance(FRAME_MS);
+
+    hal->getDisplay().lock(0);
+    probe.reset();
+
+    uint64_t start = nowUs();
+    UiQueue::getInstance().drain();
+    stackView->render();
+    lv_timer_handler();
+    uint64_t elapsed = nowUs() - start;
+
+    hal->getDisplay().unlock();
+
+    size_t heap = heapInUse();
+    heapPeak = std::max(heapPeak, heap);
+
+    if (!current)
+        return;
+
+    current->heapPeak = std::max(current->heapPeak, heap);
+    current->frame.add(elapsed / 1000.0);
+    current->refresh.add(probe.refreshUs / 1000.0);
+    if (probe.rendered)
+    {
+        current->renderedFrames++;
+        current->render.add((probe.renderUs - probe.flushUs) / 1000.0);
+        current->flush.add(probe.flushUs / 1000.0);
+    }
+}
+
+void UiBench::frames(int count)
+{
+    for (int i = 0; i < count; i++)
+        frame();
+}
+
+void UiBench::rebuildFrame(Scenario& scenario)
+{
+    // The config was posted to the UI queue, this frame drains it
+    frame();
+    scenario.rebuild.add(scenario.frame.last());
+}
+
+void UiBench::pointerRead(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    data->point = pointerPos;
+    data->state = pointerPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void UiBench::swipe(bool forward)
+{
+    int32_t width = lv_display_get_horizontal_resolution(display);
+    int32_t height = lv_display_get_vertical_resolution(display);
+    int32_t from = forward ? width * 4 / 5 : width / 5;
+    int32_t to = forward ? width / 5 : width * 4 / 5;
+
+    pointerPos = {from, height / 2};
+    pointerPressed = true;
+    frame();
+
+    for (int i = 1; i <= SWIPE_DRAG_FRAMES; i++)
+    {
+        pointerPos.x = from + (to - from) * i / SWIPE_DRAG_FRAMES;
+        frame();
+    }
+
+    pointerPressed = false;
+    frames(SWIPE_SETTLE_FRAMES);
+}
+
+Scenario& UiBench::begin(const std::string& name)
+{
+    ESP_LOGI(TAG, "Scenario: %s", name.c_str());
+    scenarios.emplace_back();
+    current = &scenarios.back();
+    current->name = name;
+    return *current;
+}
+
+void UiBench::end()
+{
+    current->objects = countObjects(lv_screen_active());
+    countStyles(lv_screen_active(), current->styleEntries, current->localStyles, current->styleBytes);
+    current->pooledWidgets = WidgetFactory::getInstance().getPooledCount();
+    current = nullptr;
+}
+
+void UiBench::runInitialLoad()
+{
+    Scenario& s = begin("initial_load");
+    applyAndSync(s, {configMessage(0)});
+    rebuildFrame(s);
+    frames(SETTLE_FRAMES);
+    end();
+}
+
+void UiBench::runSwipes()
+{
+    begin("page_swipes");
+    for (int i = 0; i < options.swipes && options.pages > 1; i++)
+    {
+        // Ping-pong across all pages
+        if (swipeForward && currentPage == options.pages - 1)
+            swipeForward = false;
+        else if (!swipeForward && currentPage == 0)
+            swipeForward = true;
+
+        swipe(swipeForward);
+        currentPage += swipeForward ? 1 : -1;
+    }
+    end();
+}
+
+void UiBench::runToggleBursts()
+{
+    Scenario& s = begin("light_toggle_bursts");
+    for (int b = 0; b < options.bursts; b++)
+    {
+        // Every light of the visible page flips at once, like a "all off" scene
+        std::vector<json> messages;
+        for (size_t i = 0; i < ios.size(); i++)
+        {
+            if (ios[i].page == currentPage && ios[i].type == "LightSwitch")
+                messages.push_back(ioChangedMessage(ios[i].id, toggledState(i)));
+        }
+
+        applyAndSync(s, messages);
+        frames(SETTLE_FRAMES);
+    }
+    end();
+}
+
+void UiBench::runReloads()
+{
+    Scenario& s = begin("config_reloads");
+    for (int r = 1; r <= options.reloads; r++)
+    {
+        // io_items reset every IO to off
+        for (auto& io : ios)
+            io.on = false;
+
+        applyAndSync(s, {configMessage(r)});
+        rebuildFrame(s);
+        frames(SETTLE_FRAMES);
+    }
+    end();
+}
+
+void UiBench::runEdits()
+{
+    Scenario& s = begin("config_edits");
+    for (int e = 1; e <= options.edits; e++)
+    {
+        // Two widgets of the visible page trade places, and every other edit
+        // drops the last page, like a user rearranging the layout
+        auto edit = [this, e](json& pages)
+        {
+            json& widgets = pages[currentPage]["widgets"];
+            if (widgets.size() > 1)
+            {
+                json& a = widgets[e % widgets.size()];
+                json& b = widgets[(e + 1) % widgets.size()];
+                std::swap(a["x"], b["x"]);
+                std::swap(a["y"], b["y"]);
+            }
+            if (e % 2 && pages.size() > static_cast<size_t>(currentPage + 1))
+                pages.erase(pages.size() - 1);
+        };
+
+        applyAndSync(s, {configMessage(options.reloads + e, edit)});
+        rebuildFrame(s);
+        frames(SETTLE_FRAMES);
+    }
+    end();
+}
+
+void UiBench::runGridReloads()
+{
+    Scenario& s = begin("grid_reloads");
+    int baseHeight = gridHeight;
+    uint32_t baseObjects = 0;
+    for (int r = 1; r <= options.gridReloads; r++)
+    {
+        // A grid size change rebuilds every page, the same widgets on a
+        // taller grid and back
+        gridHeight = r % 2 ? baseHeight + 1 : baseHeight;
+        applyAndSync(s, {configMessage(options.reloads + options.edits + r)});
+        rebuildFrame(s);
+        frames(SETTLE_FRAMES);
+
+        // Every rebuild of the same layout must leave the same objects
+        if (gridHeight == baseHeight)
+        {
+            uint32_t objects = countObjects(lv_screen_active());
+            if (baseObjects == 0)
+                baseObjects = objects;
+            s.objectGrowth = static_cast<int32_t>(objects) - static_cast<int32_t>(baseObjects);
+        }
+    }
+
+    if (gridHeight != baseHeight)
+    {
+        gridHeight = baseHeight;
+        applyAndSync(s, {configMessage(options.reloads + options.edits + options.gridReloads + 1)});
+        frames(SETTLE_FRAMES);
+    }
+    end();
+}
+
+void UiBench::runStorm()
+{
+    Scenario& s = begin("io_state_storm");
+    if (ios.empty())
+    {
+        end();
+        return;
+    }
+
+    std::vector<std::string> payloads;
+    for (int i = 0; i < options.storm; i++)
+    {
+        size_t index = i % ios.size();
+        payloads.push_back(ioChangedMessage(ios[index].id, toggledState(index)).dump());
+    }
+
+    // Keep rendering while the dispatcher works through the storm, as the
+    // main loop would
+    uint64_t start = nowUs();
+    for (const auto& payload : payloads)
+        wsManager->injectMessage(payload);
+    uint64_t seq = requestSync();
+    while (!isSynced(seq))
+        frame();
+    s.apply.add((nowUs() - start) / 1000.0);
+
+    frames(SETTLE_FRAMES);
+    end();
+}
+
+void UiBench::runImageFrames()
+{
+    begin("light_frames");
+
+    // One animation frame per display frame on the top layer, so every
+    // rendered frame is the blit of a new frame over the page
+    hal->getDisplay().lock(0);
+    lv_obj_t* image = lv_image_create(lv_layer_top());
+    lv_obj_center(image);
+    auto animator = std::make_unique<ImageSequenceAnimator>(
+        image, ImageSequenceAnimator::createLoop(&light_on_atlas, FRAME_MS));
+    animator->play();
+    hal->getDisplay().unlock();
+
+    frames(options.imageLoops * static_cast<int>(animator->getFrameCount()));
+
+    hal->getDisplay().lock(0);
+    animator.reset();
+    lv_obj_delete(image);
+    hal->getDisplay().unlock();
+    frame();
+    end();
+}
+
+void UiBench::runStyleRefreshes()
+{
+    Scenario& s = begin("style_refresh");
+    for (int i = 0; i < options.styleRefreshes; i++)
+    {
+        // What a theme change costs: every object recomputes its styles,
+        // the next frame lays out and redraws the screen
+        hal->getDisplay().lock(0);
+        uint64_t start = nowUs();
+        lv_obj_report_style_change(nullptr);
+        s.styles.add((nowUs() - start) / 1000.0);
+        hal->getDisplay().unlock();
+
+        frame();
+    }
+    end();
+}
+
+void UiBench::runIdle()
+{
+    // Nothing happens: only animations that never end keep rendering
+    begin("idle");
+    frames(options.idleFrames);
+    end();
+}
+
+json UiBench::run()
+{
+    runInitialLoad();
+    runSwipes();
+    runToggleBursts();
+    runReloads();
+    runEdits();
+    runGridReloads();
+    runStorm();
+    runImageFrames();
+    runStyleRefreshes();
+    runIdle();
+    return report();
+}
+
+bool UiBench::leaked() const
+{
+    for (const auto& s : scenarios)
+    {
+        if (s.objectGrowth > 0)
+            return true;
+    }
+    return false;
+}
+
+json UiBench::report() const
+{
+    json j;
+    j["config"] = {
+        {"pages", options.pages},
+        {"widgets_per_page", options.widgets},
+        {"grid", std::to_string(gridWidth) + "x" + std::to_string(gridHeight)},
+        {"display", std::to_string(lv_display_get_horizontal_resolution(display)) + "x" +
+                    std::to_string(lv_display_get_vertical_resolution(display))},
+        {"frame_ms", FRAME_MS},
+        {"render_threads", LV_DRAW_SW_DRAW_UNIT_CNT},
+        {"swipes", options.swipes},
+        {"bursts", options.bursts},
+        {"reloads", options.reloads},
+        {"edits", options.edits},
+        {"grid_reloads", options.gridReloads},
+        {"storm_ios", options.storm},
+        {"image_loops", options.imageLoops},
+        {"style_refreshes", options.styleRefreshes},
+        {"long_names", options.longNames},
+        {"idle_frames", options.idleFrames},
+    };
+
+    Samples allFrames;
+    json list = json::array();
+    for (const auto& s : scenarios)
+    {
+        json entry;
+        entry["name"] = s.name;
+        entry["frame"] = s.frame.summary();
+        entry["refresh"] = s.refresh.summary();
+        entry["render"] = s.render.summary();
+        entry["flush"] = s.flush.summary();
+        if (!s.apply.empty())
+            entry["apply"] = s.apply.summary();
+        if (!s.rebuild.empty())
+            entry["rebuild"] = s.rebuild.summary();
+        if (!s.styles.empty())
+            entry["style_refresh"] = s.styles.summary();
+        entry["rendered_frames"] = s.renderedFrames;
+        entry["objects"] = s.objects;
+        entry["style_entries"] = s.styleEntries;
+        entry["local_styles"] = s.localStyles;
+        entry["style_bytes"] = s.styleBytes;
+        entry["pooled_widgets"] = s.pooledWidgets;
+        entry["object_growth"] = s.objectGrowth;
+        entry["heap_peak_bytes"] = s.heapPeak;
+        list.push_back(entry);
+    }
+    j["scenarios"] = list;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    j["memory"] = {
+        {"heap_baseline_bytes", heapBaseline},
+        {"heap_peak_bytes", heapPeak},
+        {"heap_final_bytes", heapInUse()},
+        {"max_rss_kb", usage.ru_maxrss},
+    };
+
+    FontEngine::Stats fonts = FontEngine::getInstance().getStats();
+    j["fonts"] = {
+        {"fonts", fonts.fonts},
+        {"glyphs", fonts.glyphs},
+        {"cache_bytes", fonts.cacheBytes},
+        {"cache_limit_bytes", fonts.cacheLimit},
+        {"hits", fonts.hits},
+        {"misses", fonts.misses},
+    };
+    return j;
+}
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [options]\n", name);
+    printf("  --pages <n>        Pages in the synthetic config (default 12)\n");
+    printf("  --widgets <n>      Widgets per page (default 9)\n");
+    printf("  --swipes <n>       Page swipes (default 20)\n");
+    printf("  --bursts <n>       Light toggle bursts on the visible page (default 20)\n");
+    printf("  --reloads <n>      Full config reloads (default 5)\n");
+    printf("  --edits <n>        Layout edits on the visible page (default 5)\n");
+    printf("  --grid-reloads <n> Configs alternating the grid height (default 10)\n");
+    printf("  --storm <n>        IO state changes in the storm (default 100)\n");
+    printf("  --image-loops <n>  Loops of the light animation frames (default 20)\n");
+    printf("  --style-refreshes <n> Style refreshes of the whole screen (default 20)\n");
+    printf("  --long-names <n>   Widgets per page with a name longer than their card (default 3)\n");
+    printf("  --idle-frames <n>  Frames without any input at the end (default 2400)\n");
+    printf("  --output <file>    Write the JSON report to a file instead of stdout\n");
+    printf("  --verbose          Keep application logging\n");
+    printf("CALAOS_HEADLESS_SIZE and CALAOS_HEADLESS_DEPTH select the display format.\n");
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        auto intArg = [&](int& value) {
+            if (i + 1 >= argc)
+            {
+                fprintf(stderr, "%s requires a value\n", argv[i]);
+                exit(1);
+            }
+            value = std::max(0, atoi(argv[++i]));
+        };
+
+        if (strcmp(argv[i], "--pages") == 0)
+            intArg(options.pages);
+        else if (strcmp(argv[i], "--widgets") == 0)
+            intArg(options.widgets);
+        else if (strcmp(argv[i], "--swipes") == 0)
+            intArg(options.swipes);
+        else if (strcmp(argv[i], "--bursts") == 0)
+            intArg(options.bursts);
+        else if (strcmp(argv[i], "--reloads") == 0)
+            intArg(options.reloads);
+        else if (strcmp(argv[i], "--edits") == 0)
+            intArg(options.edits);
+        else if (strcmp(argv[i], "--grid-reloads") == 0)
+            intArg(options.gridReloads);
+        else if (strcmp(argv[i], "--storm") == 0)
+            intArg(options.storm);
+        else if (strcmp(argv[i], "--image-loops") == 0)
+            intArg(options.imageLoops);
+        else if (strcmp(argv[i], "--style-refreshes") == 0)
+            intArg(options.styleRefreshes);
+        else if (strcmp(argv[i], "--long-names") == 0)
+            intArg(options.longNames);
+        else if (strcmp(argv[i], "--idle-frames") == 0)
+            intArg(options.idleFrames);
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+            options.output = argv[++i];
+        else if (strcmp(argv[i], "--verbose") == 0)
+            options.verbose = true;
+        else
+        {
+            usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    UiBench bench(options);
+    if (!bench.init())
+        return 1;
+
+    json report = bench.run();
+    bool leaked = bench.leaked();
+    bench.deinit();
+
+    if (leaked)
+        fprintf(stderr, "Objects left behind by page rebuilds, see object_growth\n");
+    int status = leaked ? 2 : 0;
+
+    std::string text = report.dump(2);
+    if (options.output.empty())
+    {
+        printf("%s\n", text.c_str());
+        return status;
+    }
+
+    FILE* f = fopen(options.output.c_str(), "w");
+    if (!f)
+    {
+        fprintf(stderr, "Failed to open %s\n", options.output.c_str());
+        return 1;
+    }
+    fprintf(f, "%s\n", text.c_str());
+    fclose(f);
+    return status;
+}
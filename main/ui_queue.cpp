@@ -0,0 +1,104 @@
+#include "ui_queue.h"
+#include "logging.h"
+
+static const char* TAG = "ui.queue";
+
+UiQueue& UiQueue::getInstance()
+{
+    static UiQueue instance;
+    return instance;
+}
+
+UiQueue::~UiQueue()
+{
+    Node* node = head.exchange(nullptr);
+    while (node)
+    {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+UiQueue::Guard UiQueue::makeGuard()
+{
+    return std::make_shared<char>(0);
+}
+
+void UiQueue::post(Command command)
+{
+    push(new Node{nullptr, {}, false, std::move(command)});
+}
+
+void UiQueue::post(const Guard& guard, Command command)
+{
+    push(new Node{nullptr, guard, true, std::move(command)});
+}
+
+void UiQueue::push(Node* node)
+{
+    // seq_cst pairs with the idle check of the render loop, see empty()
+    node->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(node->next, node,
+                                       std::memory_order_seq_cst,
+                                       std::memory_order_relaxed))
+    {
+    }
+
+    void (*wakeup)() = wakeupCb.load(std::memory_order_acquire);
+    if (wakeup)
+        wakeup();
+}
+
+size_t UiQueue::drain()
+{
+    // Take everything posted so far, commands posted while draining go to the next frame
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);
+    if (!node)
+        return 0;
+
+    // The list is newest first, restore posting order
+    Node* ordered = nullptr;
+    while (node)
+    {
+        Node* next = node->next;
+        node->next = ordered;
+        ordered = node;
+        node = next;
+    }
+
+    size_t count = 0;
+    while (ordered)
+    {
+        Node* next = ordered->next;
+
+        // The guard is only released on this thread, it cannot expire while the command runs
+        if (!ordered->guarded || !ordered->guard.expired())
+        {
+            try
+            {
+                ordered->command();
+            }
+            catch (const std::exception& e)
+            {
+                ESP_LOGE(TAG, "Exception in UI command: %s", e.what());
+            }
+            count++;
+        }
+
+        delete ordered;
+        ordered = next;
+    }
+
+    return count;
+}
+
+bool UiQueue::empty() const
+{
+    return head.load(std::memory_order_seq_cst) == nullptr;
+}
+
+void UiQueue::setWakeup(void (*wakeup)())
+{
+    wakeupCb.store(wakeup, std::memory_order_release);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief Commands for the render thread
+ *
+ * Only the render thread (the one running AppMain::run) touches LVGL objects.
+ * Other threads - the flux dispatcher, WebSocket callbacks, discovery - post
+ * closures here instead of taking the display lock. The render loop drains
+ * the queue at the start of every frame, in posting order.
+ *
+ * Posting is lock-free and never blocks on rendering: commands are pushed on
+ * an atomic list that the render thread takes as a whole.
+ *
+ * A command that captures a UI object should be posted with the object's
+ * Guard: commands whose guard is gone when they are drained are dropped, so
+ * they cannot run on a page or widget destroyed in the meantime.
+ */
+class UiQueue
+{
+public:
+    using Command = std::function<void()>;
+
+    /**
+     * @brief Lifetime token of a UI object, see makeGuard()
+     */
+    using Guard = std::shared_ptr<void>;
+
+    /**
+     * @brief Get singleton instance
+     */
+    static UiQueue& getInstance();
+
+    /**
+     * @brief Create a guard, to be kept as a member of the object it protects
+     */
+    static Guard makeGuard();
+
+    /**
+     * @brief Queue a command for the next frame (any thread)
+     */
+    void post(Command command);
+
+    /**
+     * @brief Queue a command that is dropped if guard has been destroyed
+     */
+    void post(const Guard& guard, Command command);
+
+    /**
+     * @brief Run all queued commands (render thread, display lock held)
+     * @return Number of commands run
+     */
+    size_t drain();
+
+    /**
+     * @brief True when nothing is queued (any thread)
+     *
+     * Sequentially consistent with post(): a render loop that announces it
+     * is going idle and then sees an empty queue is woken up by the next post.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Called after each post() to wake up an idle render loop
+     */
+    void setWakeup(void (*wakeup)());
+
+private:
+    UiQueue() = default;
+    ~UiQueue();
+
+    UiQueue(const UiQueue&) = delete;
+    UiQueue& operator=(const UiQueue&) = delete;
+
+    struct Node
+    {
+        Node* next;
+        std::weak_ptr<void> guard;
+        bool guarded;
+        Command command;
+    };
+
+    void push(Node* node);
+
+    // Most recently posted first
+    std::atomic<Node*> head{nullptr};
+    std::atomic<void (*)()> wakeupCb{nullptr};
+};
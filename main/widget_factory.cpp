@@ -9,6 +9,9 @@
 
 static const char* TAG = "factory";
 
+// Widgets of each type and size kept for reuse, one page of a 3x3 grid
+static const size_t MAX_POOLED_PER_KEY = 9;
+
 WidgetFactory& WidgetFactory::getInstance()
 {
     static WidgetFactory instance;
@@ -26,22 +29,30 @@ void WidgetFactory::registerWidget(const std::string& typeName,
                                   int height,
                                   WidgetCreator creator)
 {
-    std::string key = makeKey(typeName, width, height);
+    if (width < 1 || width > 0xff || height < 1 || height > 0xff)
+    {
+        ESP_LOGE(TAG, "Invalid widget size: %s %dx%d", typeName.c_str(), width, height);
+        return;
+    }
+
+    auto type = typeIds.emplace(typeName, typeIds.size() + 1).first;
+    WidgetKey key = type->second << 16 | width << 8 | height;
     creators[key] = creator;
-    ESP_LOGI(TAG, "Registered widget: %s", key.c_str());
+    ESP_LOGI(TAG, "Registered widget: %s %dx%d", typeName.c_str(), width, height);
 }
 
 bool WidgetFactory::isRegistered(const std::string& typeName, int width, int height) const
 {
-    std::string key = makeKey(typeName, width, height);
-    return creators.find(key) != creators.end();
+    return creators.count(findKey(typeName, width, height)) > 0;
 }
 
-std::string WidgetFactory::makeKey(const std::string& type, int w, int h) const
+WidgetFactory::WidgetKey WidgetFactory::findKey(const std::string& type, int w, int h) const
 {
-    std::ostringstream oss;
-    oss << type << "_" << w << "x" << h;
-    return oss.str();
+    auto it = typeIds.find(type);
+    if (it == typeIds.end() || w < 1 || w > 0xff || h < 1 || h > 0xff)
+        return INVALID_KEY;
+
+    return it->second << 16 | w << 8 | h;
 }
 
 std::unique_ptr<CalaosWidget> WidgetFactory::createWidget(
@@ -49,23 +60,77 @@ std::unique_ptr<CalaosWidget> WidgetFactory::createWidget(
     const CalaosProtocol::WidgetConfig& config,
     const GridLayoutInfo& gridInfo)
 {
-    std::string key = makeKey(config.type, config.w, config.h);
-
-    ESP_LOGI(TAG, "Creating widget: %s (io_id=%s)", key.c_str(), config.io_id.c_str());
+    WidgetKey key = findKey(config.type, config.w, config.h);
 
     // Look up creator
     auto it = creators.find(key);
-    if (it != creators.end())
+    if (it == creators.end())
     {
-        // Found - create the widget
-        return it->second(parent, config, gridInfo);
+        // Not found - create WidgetError
+        std::ostringstream oss;
+        oss << config.type << "_" << config.w << "x" << config.h;
+        ESP_LOGW(TAG, "Widget type/size not supported: %s - creating WidgetError", oss.str().c_str());
+
+        std::string errorMsg = "Unsupported: " + oss.str();
+        return std::make_unique<WidgetError>(parent, config, gridInfo, errorMsg);
+    }
+
+    // Reuse a released widget of the same type and size
+    auto pooled = pool.find(key);
+    if (pooled != pool.end() && !pooled->second.empty())
+    {
+        ESP_LOGI(TAG, "Reusing widget: %s %dx%d (io_id=%s)",
+                config.type.c_str(), config.w, config.h, config.io_id.c_str());
+
+        std::unique_ptr<CalaosWidget> widget = std::move(pooled->second.back());
+        pooled->second.pop_back();
+        widget->rebind(parent, config, gridInfo);
+        return widget;
     }
 
-    // Not found - create WidgetError
-    ESP_LOGW(TAG, "Widget type/size not supported: %s - creating WidgetError", key.c_str());
+    ESP_LOGI(TAG, "Creating widget: %s %dx%d (io_id=%s)",
+            config.type.c_str(), config.w, config.h, config.io_id.c_str());
+
+    std::unique_ptr<CalaosWidget> widget = it->second(parent, config, gridInfo);
+    if (widget)
+        widget->factoryKey_ = key;
+    return widget;
+}
+
+void WidgetFactory::releaseWidget(std::unique_ptr<CalaosWidget> widget)
+{
+    // Error widgets are not pooled
+    if (!widget || widget->factoryKey_ == INVALID_KEY)
+        return;
+
+    auto& pooled = pool[widget->factoryKey_];
+    if (pooled.size() >= MAX_POOLED_PER_KEY)
+        return;
+
+    // A screen never loaded: parked widgets are neither drawn nor animated
+    if (!poolScreen)
+        poolScreen = lv_obj_create(nullptr);
+
+    widget->release(poolScreen);
+    pooled.push_back(std::move(widget));
+}
+
+void WidgetFactory::clearPool()
+{
+    size_t count = getPooledCount();
+    if (count == 0)
+        return;
 
-    std::string errorMsg = "Unsupported: " + key;
-    return std::make_unique<WidgetError>(parent, config, gridInfo, errorMsg);
+    ESP_LOGI(TAG, "Destroying %zu pooled widget(s)", count);
+    pool.clear();
+}
+
+size_t WidgetFactory::getPooledCount() const
+{
+    size_t count = 0;
+    for (const auto& pooled : pool)
+        count += pooled.second.size();
+    return count;
 }
 
 void WidgetFactory::registerBuiltinWidgets()
@@ -5,12 +5,19 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /**
  * @brief Factory for creating widgets based on type and size
  *
  * Uses the Factory pattern with registration mechanism.
  * If a widget type/size is not registered, creates a WidgetError instead.
+ *
+ * Widgets given back with releaseWidget() are kept in a pool per type and
+ * size, parked on a screen that is never shown, and createWidget() rebinds
+ * them to the new configuration and IO instead of building new LVGL objects.
+ * All methods must be called from the LVGL context.
  */
 class WidgetFactory
 {
@@ -63,6 +70,25 @@ public:
      */
     bool isRegistered(const std::string& typeName, int width, int height) const;
 
+    /**
+     * @brief Give back a widget that is no longer shown
+     *
+     * The widget is detached from its parent and IO and kept for the next
+     * createWidget() of the same type and size, or destroyed if the pool of
+     * that type and size is full.
+     */
+    void releaseWidget(std::unique_ptr<CalaosWidget> widget);
+
+    /**
+     * @brief Destroy all pooled widgets, to free their memory
+     */
+    void clearPool();
+
+    /**
+     * @brief Number of widgets waiting in the pool
+     */
+    size_t getPooledCount() const;
+
 private:
     WidgetFactory();
 
@@ -78,15 +104,28 @@ private:
     void registerBuiltinWidgets();
 
     /**
-     * @brief Create a key for the creators map
+     * @brief Key of a widget type and size: type id, width and height packed
+     * in an integer, so lookups don't build strings
+     */
+    using WidgetKey = uint32_t;
+    static const WidgetKey INVALID_KEY = 0;
+
+    /**
+     * @brief Find the key of a registered type
      * @param type Widget type
      * @param w Width in grid units
      * @param h Height in grid units
-     * @return Key string (format: "Type_WxH")
+     * @return Key, INVALID_KEY if the type was never registered
      */
-    std::string makeKey(const std::string& type, int w, int h) const;
+    WidgetKey findKey(const std::string& type, int w, int h) const;
+
+    // Registered type names, ids start at 1
+    std::map<std::string, uint32_t, std::less<>> typeIds;
 
     // Map of widget creators
-    // Key format: "LightSwitch_1x1", "Temperature_1x1", etc.
-    std::map<std::string, WidgetCreator> creators;
+    std::unordered_map<WidgetKey, WidgetCreator> creators;
+
+    // Released widgets per type and size, parked on poolScreen
+    std::unordered_map<WidgetKey, std::vector<std::unique_ptr<CalaosWidget>>> pool;
+    lv_obj_t* poolScreen = nullptr;
 };
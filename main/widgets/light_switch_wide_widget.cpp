@@ -13,7 +13,6 @@ LightSwitchWideWidget::LightSwitchWideWidget(lv_obj_t* parent,
     topContainer(nullptr),
     iconImage(nullptr),
     textContainer(nullptr),
-    nameLabel(nullptr),
     stateLabel(nullptr),
     slider(nullptr),
     lightAnimator(nullptr),
@@ -43,13 +42,6 @@ LightSwitchWideWidget::~LightSwitchWideWidget()
 
 void LightSwitchWideWidget::createUI()
 {
-    // Container styling
-    setBgColor(theme_color_widget_bg_off);
-    setBorderColor(theme_color_widget_border_off);
-    setRadius(20);
-    setBorderWidth(2);
-    setPadding(16, 16, 16, 16);
-
     // Main container uses column flex layout
     lv_obj_set_flex_flow(get(), LV_FLEX_FLOW_COLUMN);
     lv_obj_set_flex_align(get(), LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
@@ -71,14 +63,10 @@ void LightSwitchWideWidget::createUI()
     iconImage = lv_image_create(topContainer);
     lv_obj_add_flag(iconImage, LV_OBJ_FLAG_EVENT_BUBBLE);
 
-    // Create animation configuration for light switch
-    std::vector<const lv_image_dsc_t*> lightOnFrames = {
-        &light_on_00, &light_on_01, &light_on_02, &light_on_03,
-        &light_on_04, &light_on_05, &light_on_06, &light_on_07, &light_on_08
-    };
-
+    // Create animation configuration for light switch, the light_on frames
+    // are packed in one atlas image
     auto animConfig = ImageSequenceAnimator::createOneShot(
-        lightOnFrames, nullptr, 40  // 40ms per frame
+        &light_on_atlas, nullptr, 40  // 40ms per frame
     );
 
     lightAnimator = std::make_unique<ImageSequenceAnimator>(
@@ -103,61 +91,81 @@ void LightSwitchWideWidget::createUI()
     lv_obj_add_flag(textContainer, LV_OBJ_FLAG_EVENT_BUBBLE);
 
     // Name label
-    nameLabel = lv_label_create(textContainer);
+    nameLabel = std::make_unique<MarqueeLabel>(textContainer);
     const char* displayName = currentState.name.empty() ?
                               config.io_id.c_str() :
                               currentState.name.c_str();
-    lv_label_set_text(nameLabel, displayName);
-    lv_obj_set_style_text_font(nameLabel, &roboto_regular_24, 0);
-    lv_obj_set_style_text_color(nameLabel, theme_color_blue, 0);
-    lv_label_set_long_mode(nameLabel, LV_LABEL_LONG_SCROLL_CIRCULAR);
-    lv_obj_set_width(nameLabel, LV_PCT(100));
-    lv_obj_add_flag(nameLabel, LV_OBJ_FLAG_EVENT_BUBBLE);
+    nameLabel->setText(displayName);
+    lv_obj_add_style(nameLabel->get(), theme_text_style(ThemeText::Title), 0);
+    lv_obj_set_width(nameLabel->get(), LV_PCT(100));
+    lv_obj_add_flag(nameLabel->get(), LV_OBJ_FLAG_EVENT_BUBBLE);
 
     // State label
     stateLabel = lv_label_create(textContainer);
     lv_label_set_text(stateLabel, "Off");
-    lv_obj_set_style_text_font(stateLabel, &roboto_regular_22, 0);
-    lv_obj_set_style_text_color(stateLabel, theme_color_white, 0);
+    lv_obj_add_style(stateLabel, theme_text_style(ThemeText::Caption), 0);
     lv_obj_add_flag(stateLabel, LV_OBJ_FLAG_EVENT_BUBBLE);
 
     // Slider (only for dimmers)
     if (isDimmer())
+        createSlider();
+}
+
+void LightSwitchWideWidget::createSlider()
+{
+    slider = lv_slider_create(get());
+    lv_obj_set_width(slider, LV_PCT(100));
+    lv_obj_set_height(slider, 14);
+    lv_slider_set_range(slider, 0, 100);
+    lv_slider_set_value(slider, 0, LV_ANIM_OFF);
+    // Allow knob to overflow the thin track
+    lv_obj_add_flag(slider, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+
+    // Style the slider: track, filled part and knob
+    const ThemeStyles& styles = theme_styles();
+    lv_obj_add_style(slider, &styles.sliderTrack, LV_PART_MAIN);
+    lv_obj_add_style(slider, &styles.sliderIndicator, LV_PART_INDICATOR);
+    lv_obj_add_style(slider, &styles.sliderKnob, LV_PART_KNOB);
+
+    // Add released event callback
+    lv_obj_add_event_cb(slider, sliderReleasedCb, LV_EVENT_RELEASED, this);
+}
+
+void LightSwitchWideWidget::onRelease()
+{
+    lightAnimator->stop();
+}
+
+void LightSwitchWideWidget::onRebind()
+{
+    const char* displayName = currentState.name.empty() ?
+                              config.io_id.c_str() :
+                              currentState.name.c_str();
+
+    // Scrolls from the start like a new name
+    nameLabel->setText(displayName);
+    nameLabel->restart();
+
+    // The new IO may not be of the same kind
+    if (isDimmer() && !slider)
     {
-        slider = lv_slider_create(get());
-        lv_obj_set_width(slider, LV_PCT(100));
-        lv_obj_set_height(slider, 14);
-        lv_slider_set_range(slider, 0, 100);
-        lv_slider_set_value(slider, 0, LV_ANIM_OFF);
-        // Allow knob to overflow the thin track
-        lv_obj_add_flag(slider, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
-
-        // Style the slider
-        // Main track (background)
-        lv_obj_set_style_bg_color(slider, theme_color_widget_bg_off, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(slider, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_radius(slider, 7, LV_PART_MAIN);
-        lv_obj_set_style_border_width(slider, 1, LV_PART_MAIN);
-        lv_obj_set_style_border_color(slider, theme_color_widget_border_off, LV_PART_MAIN);
-        // Add horizontal padding so knob doesn't overflow parent
-        lv_obj_set_style_pad_left(slider, 15, LV_PART_MAIN);
-        lv_obj_set_style_pad_right(slider, 15, LV_PART_MAIN);
-
-        // Indicator (filled part)
-        lv_obj_set_style_bg_color(slider, theme_color_blue, LV_PART_INDICATOR);
-        lv_obj_set_style_radius(slider, 7, LV_PART_INDICATOR);
-
-        // Knob
-        lv_obj_set_style_bg_color(slider, theme_color_white, LV_PART_KNOB);
-        lv_obj_set_style_radius(slider, LV_RADIUS_CIRCLE, LV_PART_KNOB);
-        lv_obj_set_style_pad_all(slider, 6, LV_PART_KNOB);
-        lv_obj_set_style_shadow_width(slider, 4, LV_PART_KNOB);
-        lv_obj_set_style_shadow_color(slider, theme_color_blue, LV_PART_KNOB);
-        lv_obj_set_style_shadow_opa(slider, 100, LV_PART_KNOB);
-
-        // Add released event callback
-        lv_obj_add_event_cb(slider, sliderReleasedCb, LV_EVENT_RELEASED, this);
+        createSlider();
     }
+    else if (!isDimmer() && slider)
+    {
+        lv_obj_delete(slider);
+        slider = nullptr;
+    }
+
+    // Same as a new widget
+    bool isOn = parseIsOn(currentState.state);
+    int brightness = getBrightness(currentState.state);
+    wasOn = false;
+    updateVisualState(isOn);
+    updateStateLabel(isOn, brightness);
+
+    if (slider)
+        lv_slider_set_value(slider, brightness, LV_ANIM_OFF);
 }
 
 bool LightSwitchWideWidget::isDimmer() const
@@ -204,8 +212,7 @@ void LightSwitchWideWidget::updateVisualState(bool isOn)
 {
     if (isOn)
     {
-        setBgColor(theme_color_widget_bg_on);
-        setBorderColor(theme_color_widget_border_on);
+        lv_obj_add_state(get(), LV_STATE_CHECKED);
 
         // Only play animation when transitioning from OFF to ON
         if (!wasOn && lightAnimator)
@@ -213,8 +220,7 @@ void LightSwitchWideWidget::updateVisualState(bool isOn)
     }
     else
     {
-        setBgColor(theme_color_widget_bg_off);
-        setBorderColor(theme_color_widget_border_off);
+        lv_obj_remove_state(get(), LV_STATE_CHECKED);
 
         if (lightAnimator)
             lightAnimator->stop();
@@ -301,7 +307,7 @@ void LightSwitchWideWidget::onStateUpdate(const CalaosProtocol::IoState& state)
 
     // Update name label if name changed
     if (!state.name.empty())
-        lv_label_set_text(nameLabel, state.name.c_str());
+        nameLabel->setText(state.name.c_str());
 
     // Update visual state
     bool isOn = parseIsOn(state.state);
@@ -2,6 +2,7 @@
 
 #include "../calaos_widget.h"
 #include "../calaos_protocol.h"
+#include "../marquee_label.h"
 #include "lvgl.h"
 #include <memory>
 
@@ -33,12 +34,20 @@ protected:
      */
     void onStateUpdate(const CalaosProtocol::IoState& state) override;
 
+    void onRelease() override;
+    void onRebind() override;
+
 private:
     /**
      * @brief Create UI elements
      */
     void createUI();
 
+    /**
+     * @brief Create the brightness slider (dimmers only)
+     */
+    void createSlider();
+
     /**
      * @brief Check if this widget controls a dimmer
      */
@@ -88,7 +97,7 @@ private:
     lv_obj_t* topContainer;     // Container for icon and text
     lv_obj_t* iconImage;        // Animated icon image
     lv_obj_t* textContainer;    // Container for name and state labels
-    lv_obj_t* nameLabel;        // IO name
+    std::unique_ptr<MarqueeLabel> nameLabel;    // IO name
     lv_obj_t* stateLabel;       // State text (Off or XX%)
     lv_obj_t* slider;           // Brightness slider (only for dimmers)
     std::unique_ptr<ImageSequenceAnimator> lightAnimator;
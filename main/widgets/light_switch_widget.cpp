@@ -11,7 +11,6 @@ LightSwitchWidget::LightSwitchWidget(lv_obj_t* parent,
                                    const GridLayoutInfo& gridInfo):
     CalaosWidget(parent, config, gridInfo),
     iconImage(nullptr),
-    nameLabel(nullptr),
     lightAnimator(nullptr),
     updatingFromServer(false),
     wasOn(false)
@@ -32,13 +31,6 @@ LightSwitchWidget::~LightSwitchWidget()
 
 void LightSwitchWidget::createUI()
 {
-    // Container styling
-    setBgColor(theme_color_widget_bg_off);
-    setBorderColor(theme_color_widget_border_off);
-    setRadius(20);
-    setBorderWidth(2);
-    setPadding(16, 16, 16, 16);
-
     // Make clickable
     lv_obj_add_flag(get(), LV_OBJ_FLAG_CLICKABLE);
     lv_obj_add_event_cb(get(), clickEventCb, LV_EVENT_CLICKED, this);
@@ -47,14 +39,10 @@ void LightSwitchWidget::createUI()
     iconImage = lv_image_create(get());
     lv_obj_align(iconImage, LV_ALIGN_TOP_MID, 0, 20);
 
-    // Create animation configuration for light switch
-    std::vector<const lv_image_dsc_t*> lightOnFrames = {
-        &light_on_00, &light_on_01, &light_on_02, &light_on_03,
-        &light_on_04, &light_on_05, &light_on_06, &light_on_07, &light_on_08
-    };
-
+    // Create animation configuration for light switch, the light_on frames
+    // are packed in one atlas image
     auto animConfig = ImageSequenceAnimator::createOneShot(
-        lightOnFrames, nullptr, 40  // 40ms per frame, no static image
+        &light_on_atlas, nullptr, 40  // 40ms per frame, no static image
     );
 
     // Create the animator
@@ -68,23 +56,40 @@ void LightSwitchWidget::createUI()
     });
 
     // Name label (centered bottom)
-    nameLabel = lv_label_create(get());
+    nameLabel = std::make_unique<MarqueeLabel>(get());
 
     // Use IO name from state, or io_id as fallback
     const char* displayName = currentState.name.empty() ?
                              config.io_id.c_str() :
                              currentState.name.c_str();
 
-    lv_label_set_text(nameLabel, displayName);
-    lv_obj_set_style_text_font(nameLabel, &roboto_regular_24, 0);
-    lv_obj_set_style_text_color(nameLabel, theme_color_blue, 0);
-    lv_obj_set_style_text_align(nameLabel, LV_TEXT_ALIGN_CENTER, 0);
+    // Long names scroll
+    nameLabel->setText(displayName);
+    lv_obj_add_style(nameLabel->get(), theme_text_style(ThemeText::Title), 0);
+    lv_obj_add_style(nameLabel->get(), &theme_styles().textCenter, 0);
+    lv_obj_set_width(nameLabel->get(), LV_PCT(100));
+
+    lv_obj_align(nameLabel->get(), LV_ALIGN_BOTTOM_MID, 0, -10);
+}
+
+void LightSwitchWidget::onRelease()
+{
+    lightAnimator->stop();
+}
+
+void LightSwitchWidget::onRebind()
+{
+    const char* displayName = currentState.name.empty() ?
+                             config.io_id.c_str() :
+                             currentState.name.c_str();
 
-    // Enable text scrolling for long names
-    lv_label_set_long_mode(nameLabel, LV_LABEL_LONG_SCROLL_CIRCULAR);
-    lv_obj_set_width(nameLabel, LV_PCT(100));
+    // Scrolls from the start like a new name
+    nameLabel->setText(displayName);
+    nameLabel->restart();
 
-    lv_obj_align(nameLabel, LV_ALIGN_BOTTOM_MID, 0, -10);
+    // Same as a new widget
+    wasOn = false;
+    updateVisualState(parseIsOn(currentState.state));
 }
 
 void LightSwitchWidget::updateVisualState(bool isOn)
@@ -92,8 +97,7 @@ void LightSwitchWidget::updateVisualState(bool isOn)
     if (isOn)
     {
         // ON state: Blue background with opacity, animated icon
-        setBgColor(theme_color_widget_bg_on);
-        setBorderColor(theme_color_widget_border_on);
+        lv_obj_add_state(get(), LV_STATE_CHECKED);
 
         // Only play animation when transitioning from OFF to ON
         if (!wasOn && lightAnimator)
@@ -102,8 +106,7 @@ void LightSwitchWidget::updateVisualState(bool isOn)
     else
     {
         // OFF state: Dark gray background, static off icon
-        setBgColor(theme_color_widget_bg_off);
-        setBorderColor(theme_color_widget_border_off);
+        lv_obj_remove_state(get(), LV_STATE_CHECKED);
 
         // Stop animation and directly show light_off image
         if (lightAnimator)
@@ -155,7 +158,7 @@ void LightSwitchWidget::onStateUpdate(const CalaosProtocol::IoState& state)
     // Update name label if name changed
     if (!state.name.empty())
     {
-        lv_label_set_text(nameLabel, state.name.c_str());
+        nameLabel->setText(state.name.c_str());
     }
 
     // Update visual state
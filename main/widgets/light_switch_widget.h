@@ -2,6 +2,7 @@
 
 #include "../calaos_widget.h"
 #include "../calaos_protocol.h"
+#include "../marquee_label.h"
 #include "lvgl.h"
 #include <memory>
 
@@ -32,6 +33,9 @@ protected:
      */
     void onStateUpdate(const CalaosProtocol::IoState& state) override;
 
+    void onRelease() override;
+    void onRebind() override;
+
 private:
     /**
      * @brief Create UI elements
@@ -64,7 +68,7 @@ private:
 
     // UI elements
     lv_obj_t* iconImage;    // Animated icon image
-    lv_obj_t* nameLabel;    // IO name
+    std::unique_ptr<MarqueeLabel> nameLabel;    // IO name
     std::unique_ptr<ImageSequenceAnimator> lightAnimator;
 
     bool updatingFromServer = false;  // Prevent feedback loop
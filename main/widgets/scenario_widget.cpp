@@ -12,12 +12,12 @@ ScenarioWidget::ScenarioWidget(lv_obj_t* parent,
                                const GridLayoutInfo& gridInfo):
     CalaosWidget(parent, config, gridInfo),
     iconImage(nullptr),
-    nameLabel(nullptr),
     labelColorAnim(std::make_unique<smooth_ui_toolkit::color::AnimateRgb_t>()),
     bgColorAnim(std::make_unique<smooth_ui_toolkit::color::AnimateRgb_t>()),
     isAnimating(false),
     animationPhase(0),
-    delayTimer(nullptr)
+    delayEndMs(0),
+    animationHandle(AnimationScheduler::INVALID_HANDLE)
 {
     ESP_LOGI(TAG, "Creating scenario widget: %s", config.io_id.c_str());
     createUI();
@@ -27,23 +27,11 @@ ScenarioWidget::~ScenarioWidget()
 {
     ESP_LOGI(TAG, "Destroying scenario widget: %s", config.io_id.c_str());
 
-    // Clean up timer if active
-    if (delayTimer)
-    {
-        lv_timer_delete(delayTimer);
-        delayTimer = nullptr;
-    }
+    AnimationScheduler::getInstance().remove(animationHandle);
 }
 
 void ScenarioWidget::createUI()
 {
-    // Container styling - OFF state (same as LightSwitch OFF)
-    setBgColor(theme_color_widget_bg_off);
-    setBorderColor(theme_color_widget_border_off);
-    setRadius(20);
-    setBorderWidth(2);
-    setPadding(16, 16, 16, 16);
-
     // Make clickable
     lv_obj_add_flag(get(), LV_OBJ_FLAG_CLICKABLE);
     lv_obj_add_event_cb(get(), pressEventCb, LV_EVENT_PRESSED, this);
@@ -58,21 +46,18 @@ void ScenarioWidget::createUI()
     lv_image_set_src(iconImage, &icon_scenario);
 
     // Name label (blue color)
-    nameLabel = lv_label_create(get());
+    nameLabel = std::make_unique<MarqueeLabel>(get());
 
     // Use IO name from state, or io_id as fallback
     const char* displayName = currentState.name.empty() ?
                              config.io_id.c_str() :
                              currentState.name.c_str();
 
-    lv_label_set_text(nameLabel, displayName);
-    lv_obj_set_style_text_font(nameLabel, &roboto_regular_24, 0);
-    lv_obj_set_style_text_color(nameLabel, theme_color_blue, 0);
-    lv_obj_set_style_text_align(nameLabel, LV_TEXT_ALIGN_CENTER, 0);
-
-    // Enable text scrolling for long names
-    lv_label_set_long_mode(nameLabel, LV_LABEL_LONG_SCROLL_CIRCULAR);
-    lv_obj_set_width(nameLabel, LV_PCT(100));
+    // Long names scroll
+    nameLabel->setText(displayName);
+    lv_obj_add_style(nameLabel->get(), theme_text_style(ThemeText::Title), 0);
+    lv_obj_add_style(nameLabel->get(), &theme_styles().textCenter, 0);
+    lv_obj_set_width(nameLabel->get(), LV_PCT(100));
 
     // Initialize color animations to blue
     labelColorAnim->duration = 0.15f; // 150ms for bump
@@ -82,6 +67,11 @@ void ScenarioWidget::createUI()
     bgColorAnim->duration = 0.15f;
     bgColorAnim->begin();
     bgColorAnim->teleport(lv_color_to_u32(theme_color_widget_bg_off));
+
+    animationHandle = AnimationScheduler::getInstance().add(get(), [this](uint32_t nowMs)
+    {
+        return tickAnimation(nowMs);
+    });
 }
 
 void ScenarioWidget::pressEventCb(lv_event_t* e)
@@ -101,8 +91,7 @@ void ScenarioWidget::onPressed()
     ESP_LOGI(TAG, "Scenario pressed: %s", config.io_id.c_str());
 
     // Set background to ON state immediately
-    setBgColor(theme_color_widget_bg_on);
-    setBorderColor(theme_color_widget_border_on);
+    lv_obj_add_state(get(), LV_STATE_CHECKED);
 }
 
 void ScenarioWidget::clickEventCb(lv_event_t* e)
@@ -147,6 +136,8 @@ void ScenarioWidget::startAnimation()
     bgColorAnim->duration = 0.15f;
     bgColorAnim->begin();
     bgColorAnim->teleport(lv_color_to_u32(theme_color_widget_bg_on));
+
+    AnimationScheduler::getInstance().start(animationHandle);
 }
 
 void ScenarioWidget::onBumpComplete()
@@ -155,19 +146,8 @@ void ScenarioWidget::onBumpComplete()
 
     animationPhase = 2;
 
-    // Create timer for 400ms delay
-    delayTimer = lv_timer_create(delayTimerCb, 400, this);
-    lv_timer_set_repeat_count(delayTimer, 1); // Run once
-}
-
-void ScenarioWidget::delayTimerCb(lv_timer_t* timer)
-{
-    ScenarioWidget* widget = static_cast<ScenarioWidget*>(lv_timer_get_user_data(timer));
-    if (widget)
-    {
-        widget->delayTimer = nullptr; // Timer will auto-delete
-        widget->startFadeAnimation();
-    }
+    // The fade starts from tickAnimation() 400ms from now
+    delayEndMs = AnimationScheduler::now() + 400;
 }
 
 void ScenarioWidget::startFadeAnimation()
@@ -192,27 +172,41 @@ void ScenarioWidget::onFadeComplete()
 
     isAnimating = false;
     animationPhase = 0;
+    resetStyle();
+}
 
-    // Ensure widget is back to OFF state
-    setBgColor(theme_color_widget_bg_off);
-    setBorderColor(theme_color_widget_border_off);
+void ScenarioWidget::resetStyle()
+{
+    lv_obj_remove_state(get(), LV_STATE_CHECKED);
+    lv_obj_remove_local_style_prop(get(), LV_STYLE_BG_COLOR, LV_PART_MAIN);
+    lv_obj_remove_local_style_prop(get(), LV_STYLE_BORDER_COLOR, LV_PART_MAIN);
+    lv_obj_remove_local_style_prop(nameLabel->get(), LV_STYLE_TEXT_COLOR, 0);
 }
 
-void ScenarioWidget::render()
+bool ScenarioWidget::tickAnimation(uint32_t nowMs)
 {
     if (!isAnimating)
-        return;
+        return false;
+
+    // Phase 2: hold the yellow label
+    if (animationPhase == 2)
+    {
+        if (static_cast<int32_t>(nowMs - delayEndMs) >= 0)
+            startFadeAnimation();
+        return true;
+    }
 
     // Update animations
-    labelColorAnim->update();
+    float nowS = nowMs / 1000.0f;
+    labelColorAnim->update(nowS);
 
     // Apply label color
-    lv_obj_set_style_text_color(nameLabel, lv_color_hex(labelColorAnim->toHex()), 0);
+    lv_obj_set_style_text_color(nameLabel->get(), lv_color_hex(labelColorAnim->toHex()), 0);
 
     // Apply background color only during fade phase (phase 3)
     if (animationPhase == 3)
     {
-        bgColorAnim->update();
+        bgColorAnim->update(nowS);
         uint32_t currentBgColor = bgColorAnim->toHex();
         lv_obj_set_style_bg_color(get(), lv_color_hex(currentBgColor), LV_PART_MAIN);
 
@@ -232,6 +226,28 @@ void ScenarioWidget::render()
     {
         onFadeComplete();
     }
+
+    return isAnimating;
+}
+
+void ScenarioWidget::onRelease()
+{
+    // An animation in progress is dropped
+    AnimationScheduler::getInstance().stop(animationHandle);
+    isAnimating = false;
+    animationPhase = 0;
+    resetStyle();
+}
+
+void ScenarioWidget::onRebind()
+{
+    const char* displayName = currentState.name.empty() ?
+                             config.io_id.c_str() :
+                             currentState.name.c_str();
+
+    // Scrolls from the start like a new name
+    nameLabel->setText(displayName);
+    nameLabel->restart();
 }
 
 void ScenarioWidget::onStateUpdate(const CalaosProtocol::IoState& state)
@@ -242,6 +258,6 @@ void ScenarioWidget::onStateUpdate(const CalaosProtocol::IoState& state)
     {
         ESP_LOGI(TAG, "Updating name for %s: %s", config.io_id.c_str(), state.name.c_str());
         currentState = state;
-        lv_label_set_text(nameLabel, state.name.c_str());
+        nameLabel->setText(state.name.c_str());
     }
 }
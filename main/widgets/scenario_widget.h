@@ -2,10 +2,11 @@
 
 #include "../calaos_widget.h"
 #include "../calaos_protocol.h"
+#include "../animation_scheduler.h"
+#include "../marquee_label.h"
 #include <memory>
 
 // Forward declarations
-struct _lv_timer_t;
 
 namespace smooth_ui_toolkit {
 namespace color {
@@ -32,17 +33,15 @@ public:
 
     ~ScenarioWidget() override;
 
-    /**
-     * @brief Called from page render loop to update animations
-     */
-    void render() override;
-
 protected:
     /**
      * @brief Update UI when IO state changes (scenarios don't receive events)
      */
     void onStateUpdate(const CalaosProtocol::IoState& state) override;
 
+    void onRelease() override;
+    void onRebind() override;
+
 private:
     /**
      * @brief Create UI elements
@@ -80,9 +79,10 @@ private:
     void onBumpComplete();
 
     /**
-     * @brief Delay timer callback for phase 2
+     * @brief Advance the animation, called by the AnimationScheduler
+     * @return false once the sequence is over
      */
-    static void delayTimerCb(lv_timer_t* timer);
+    bool tickAnimation(uint32_t nowMs);
 
     /**
      * @brief Start fade animation (phase 2)
@@ -94,14 +94,20 @@ private:
      */
     void onFadeComplete();
 
+    /**
+     * @brief Back to the shared OFF style, dropping the animated overrides
+     */
+    void resetStyle();
+
     // UI elements
     lv_obj_t* iconImage;    // Static scenario icon
-    lv_obj_t* nameLabel;    // IO name
+    std::unique_ptr<MarqueeLabel> nameLabel;    // IO name
 
     // Animation state
     std::unique_ptr<smooth_ui_toolkit::color::AnimateRgb_t> labelColorAnim;
     std::unique_ptr<smooth_ui_toolkit::color::AnimateRgb_t> bgColorAnim;
     bool isAnimating;
     int animationPhase;     // 0=idle, 1=bump, 2=waiting, 3=fade
-    lv_timer_t* delayTimer; // Timer for 400ms delay between phases
+    uint32_t delayEndMs;    // End of the 400ms delay between phases
+    AnimationScheduler::Handle animationHandle;
 };
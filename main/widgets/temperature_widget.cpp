@@ -13,8 +13,7 @@ TemperatureWidget::TemperatureWidget(lv_obj_t* parent,
                                    const GridLayoutInfo& gridInfo):
     CalaosWidget(parent, config, gridInfo),
     iconImage(nullptr),
-    tempLabel(nullptr),
-    nameLabel(nullptr)
+    tempLabel(nullptr)
 {
     ESP_LOGI(TAG, "Creating temperature widget: %s", config.io_id.c_str());
     createUI();
@@ -26,13 +25,6 @@ TemperatureWidget::TemperatureWidget(lv_obj_t* parent,
 
 void TemperatureWidget::createUI()
 {
-    // Container styling - same as LightSwitch OFF state
-    setBgColor(theme_color_widget_bg_off);
-    setBorderColor(theme_color_widget_border_off);
-    setRadius(20);
-    setBorderWidth(2);
-    setPadding(16, 16, 16, 16);
-
     // Not clickable (read-only widget)
     lv_obj_clear_flag(get(), LV_OBJ_FLAG_CLICKABLE);
 
@@ -47,19 +39,16 @@ void TemperatureWidget::createUI()
     // Temperature label (yellow color)
     tempLabel = lv_label_create(get());
     lv_label_set_text(tempLabel, "-- °C");
-    lv_obj_set_style_text_font(tempLabel, &roboto_light_48, 0);
-    lv_obj_set_style_text_color(tempLabel, theme_color_yellow, 0);
+    lv_obj_add_style(tempLabel, theme_text_style(ThemeText::Value), 0);
 
     // Name label at bottom (blue color)
-    nameLabel = lv_label_create(get());
+    nameLabel = std::make_unique<MarqueeLabel>(get());
     const char* displayName = currentState.name.empty() ?
                              config.io_id.c_str() :
                              currentState.name.c_str();
-    lv_label_set_text(nameLabel, displayName);
-    lv_obj_set_style_text_font(nameLabel, &roboto_regular_24, 0);
-    lv_obj_set_style_text_color(nameLabel, theme_color_blue, 0);
-    lv_label_set_long_mode(nameLabel, LV_LABEL_LONG_SCROLL_CIRCULAR);
-    lv_obj_set_width(nameLabel, lv_pct(90));
+    nameLabel->setText(displayName);
+    lv_obj_add_style(nameLabel->get(), theme_text_style(ThemeText::Title), 0);
+    lv_obj_set_width(nameLabel->get(), lv_pct(90));
 }
 
 void TemperatureWidget::onStateUpdate(const CalaosProtocol::IoState& state)
@@ -75,7 +64,15 @@ void TemperatureWidget::onStateUpdate(const CalaosProtocol::IoState& state)
     const char* displayName = state.name.empty() ?
                              config.io_id.c_str() :
                              state.name.c_str();
-    lv_label_set_text(nameLabel, displayName);
+    nameLabel->setText(displayName);
+}
+
+void TemperatureWidget::onRebind()
+{
+    onStateUpdate(currentState);
+
+    // Scrolls from the start like a new name
+    nameLabel->restart();
 }
 
 std::string TemperatureWidget::formatTemperature(const std::string& tempStr)
@@ -2,6 +2,7 @@
 
 #include "../calaos_widget.h"
 #include "../calaos_protocol.h"
+#include "../marquee_label.h"
 #include "lvgl.h"
 
 /**
@@ -29,6 +30,8 @@ protected:
      */
     void onStateUpdate(const CalaosProtocol::IoState& state) override;
 
+    void onRebind() override;
+
 private:
     /**
      * @brief Create UI elements
@@ -45,5 +48,5 @@ private:
     // UI elements
     lv_obj_t* iconImage;
     lv_obj_t* tempLabel;
-    lv_obj_t* nameLabel;
+    std::unique_ptr<MarqueeLabel> nameLabel;
 };
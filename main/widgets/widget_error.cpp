@@ -27,33 +27,27 @@ WidgetError::~WidgetError()
 
 void WidgetError::createUI()
 {
+    const ThemeStyles& styles = theme_styles();
+
     // Dark red background to indicate error
-    setBgColor(lv_color_make(0x40, 0x20, 0x20));
-    setBgOpa(LV_OPA_COVER);
-    setRadius(8);
-    setBorderWidth(2);
-    setBorderColor(theme_color_red);
-    setPadding(8, 8, 8, 8);
+    lv_obj_add_style(get(), &styles.widgetError, LV_PART_MAIN);
 
     // Warning icon at top
     warningIcon = lv_label_create(get());
     lv_label_set_text(warningIcon, LV_SYMBOL_WARNING);
-    lv_obj_set_style_text_font(warningIcon, &roboto_regular_24, 0);
-    lv_obj_set_style_text_color(warningIcon, theme_color_red, 0);
+    lv_obj_add_style(warningIcon, theme_text_style(ThemeText::ErrorIcon), 0);
     lv_obj_align(warningIcon, LV_ALIGN_TOP_MID, 0, 10);
 
     // "Unsupported" text
     errorLabel = lv_label_create(get());
     lv_label_set_text(errorLabel, "Unsupported");
-    lv_obj_set_style_text_font(errorLabel, &roboto_medium_28, 0);
-    lv_obj_set_style_text_color(errorLabel, theme_color_white, 0);
+    lv_obj_add_style(errorLabel, theme_text_style(ThemeText::ErrorTitle), 0);
     lv_obj_align(errorLabel, LV_ALIGN_CENTER, 0, -20);
 
     // Widget type
     typeLabel = lv_label_create(get());
     lv_label_set_text(typeLabel, config.type.c_str());
-    lv_obj_set_style_text_font(typeLabel, &roboto_regular_24, 0);
-    lv_obj_set_style_text_color(typeLabel, theme_color_yellow, 0);
+    lv_obj_add_style(typeLabel, theme_text_style(ThemeText::ErrorDetail), 0);
     lv_obj_align(typeLabel, LV_ALIGN_CENTER, 0, 15);
 
     // Widget size
@@ -61,8 +55,7 @@ void WidgetError::createUI()
     std::ostringstream oss;
     oss << config.w << "x" << config.h;
     lv_label_set_text(sizeLabel, oss.str().c_str());
-    lv_obj_set_style_text_font(sizeLabel, &roboto_light_22, 0);
-    lv_obj_set_style_text_color(sizeLabel, lv_color_make(0xAA, 0xAA, 0xAA), 0);
+    lv_obj_add_style(sizeLabel, theme_text_style(ThemeText::ErrorHint), 0);
     lv_obj_align(sizeLabel, LV_ALIGN_BOTTOM_MID, 0, -10);
 }
 
@@ -48,6 +48,18 @@ struct NetworkBuffer
     NetworkBuffer(const std::string& str) : data(str.begin(), str.end()), size(str.size()) {}
 };
 
+// Non-owning view on received data. Points into a pooled receive buffer and is
+// only valid for the duration of the callback it is passed to.
+struct NetworkBufferView
+{
+    const uint8_t* data;
+    size_t size;
+
+    NetworkBufferView() : data(nullptr), size(0) {}
+    NetworkBufferView(const uint8_t* ptr, size_t len) : data(ptr), size(len) {}
+};
+
 using NetworkCallback = std::function<void(NetworkResult result, const NetworkBuffer& data)>;
+using NetworkViewCallback = std::function<void(NetworkResult result, const NetworkBufferView& data)>;
 using NetworkConnectionCallback = std::function<void(NetworkResult result)>;
 using NetworkErrorCallback = std::function<void(NetworkResult error, const std::string& message)>;
\ No newline at end of file
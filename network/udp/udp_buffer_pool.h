@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../network_types.h"
+#include <vector>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <string.h>
+#endif
+
+// Fixed set of receive slots allocated once per receive thread. Each slot holds
+// one datagram; received data is handed out as NetworkBufferView pointing
+// directly into the slot, so no per-packet allocation happens.
+// On Linux the slots are pre-wired into mmsghdr/iovec arrays for recvmmsg().
+class UdpBufferPool
+{
+public:
+    UdpBufferPool(size_t slot_count, size_t slot_size):
+        slot_count_(slot_count ? slot_count : 1),
+        slot_size_(slot_size),
+        storage_(slot_count_ * slot_size_)
+    {
+#ifdef __linux__
+        headers_.resize(slot_count_);
+        iovecs_.resize(slot_count_);
+        addresses_.resize(slot_count_);
+
+        for (size_t i = 0; i < slot_count_; i++)
+        {
+            iovecs_[i].iov_base = slot(i);
+            iovecs_[i].iov_len = slot_size_;
+
+            memset(&headers_[i], 0, sizeof(headers_[i]));
+            headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+            headers_[i].msg_hdr.msg_iovlen = 1;
+            headers_[i].msg_hdr.msg_name = &addresses_[i];
+        }
+        reset();
+#endif
+    }
+
+    UdpBufferPool(const UdpBufferPool&) = delete;
+    UdpBufferPool& operator=(const UdpBufferPool&) = delete;
+
+    size_t slotCount() const { return slot_count_; }
+    size_t slotSize() const { return slot_size_; }
+
+    uint8_t* slot(size_t index) { return storage_.data() + index * slot_size_; }
+
+    NetworkBufferView view(size_t index, size_t length)
+    {
+        return NetworkBufferView(slot(index), length < slot_size_ ? length : slot_size_);
+    }
+
+#ifdef __linux__
+    struct mmsghdr* headers() { return headers_.data(); }
+    const struct sockaddr_in& address(size_t index) const { return addresses_[index]; }
+
+    // Must be called before each recvmmsg(), the kernel overwrites these fields
+    void reset()
+    {
+        for (size_t i = 0; i < slot_count_; i++)
+        {
+            headers_[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            headers_[i].msg_hdr.msg_flags = 0;
+            headers_[i].msg_len = 0;
+        }
+    }
+#endif
+
+private:
+    size_t slot_count_;
+    size_t slot_size_;
+    std::vector<uint8_t> storage_;
+
+#ifdef __linux__
+    std::vector<struct mmsghdr> headers_;
+    std::vector<struct iovec> iovecs_;
+    std::vector<struct sockaddr_in> addresses_;
+#endif
+};
@@ -1,4 +1,5 @@
 #include "udp_client.h"
+#include "udp_buffer_pool.h"
 #include "logging.h"
 
 #include <string.h>
@@ -10,6 +11,8 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #elif defined(ESP_PLATFORM)
 #include "lwip/sockets.h"
 #include "lwip/netdb.h"
@@ -17,11 +20,20 @@
 
 static const char *TAG = "net.udp";
 
+// Datagrams pulled per recvmmsg() call and size of each pooled slot
+static const size_t RECV_BATCH_SIZE = 16;
+static const size_t RECV_SLOT_SIZE = 4096;
+
 UdpClient::UdpClient():
     socket_(-1),
     receiving_(false),
     listen_port_(0),
     receive_timeout_ms_(5000)
+#ifdef __linux__
+    ,
+    epoll_fd_(-1),
+    wake_fd_(-1)
+#endif
 {
 }
 
@@ -77,7 +89,11 @@ NetworkResult UdpClient::createSocket()
 void UdpClient::closeSocket()
 {
     std::lock_guard<std::mutex> lock(socket_mutex_);
+    releaseSocket();
+}
 
+void UdpClient::releaseSocket()
+{
     if (socket_ != -1)
     {
         close(socket_);
@@ -137,18 +153,40 @@ NetworkResult UdpClient::sendBroadcast(uint16_t port, const NetworkBuffer& data)
 
 NetworkResult UdpClient::startReceiving(uint16_t port, NetworkCallback callback)
 {
+    if (!callback)
+    {
+        ESP_LOGE(TAG, "Invalid callback provided");
+        return NetworkResult::INVALID_PARAMETER;
+    }
+
     if (receiving_.load())
     {
         ESP_LOGE(TAG, "UDP client already receiving");
         return NetworkResult::ALREADY_CONNECTED;
     }
 
+    return startReceivingInternal(port, callback, nullptr);
+}
+
+NetworkResult UdpClient::startReceivingViews(uint16_t port, NetworkViewCallback callback)
+{
     if (!callback)
     {
         ESP_LOGE(TAG, "Invalid callback provided");
         return NetworkResult::INVALID_PARAMETER;
     }
 
+    if (receiving_.load())
+    {
+        ESP_LOGE(TAG, "UDP client already receiving");
+        return NetworkResult::ALREADY_CONNECTED;
+    }
+
+    return startReceivingInternal(port, nullptr, callback);
+}
+
+NetworkResult UdpClient::startReceivingInternal(uint16_t port, NetworkCallback callback, NetworkViewCallback view_callback)
+{
     std::lock_guard<std::mutex> lock(socket_mutex_);
 
     if (socket_ == -1)
@@ -168,11 +206,23 @@ NetworkResult UdpClient::startReceiving(uint16_t port, NetworkCallback callback)
     if (bind(socket_, (struct sockaddr*)&listen_addr, sizeof(listen_addr)) < 0)
     {
         ESP_LOGE(TAG, "Failed to bind UDP socket to port %d: %s", port, strerror(errno));
+        releaseSocket();
         return NetworkResult::ERROR;
     }
 
-    listen_port_ = port;
+#ifdef __linux__
+    NetworkResult poller_result = createPoller();
+    if (poller_result != NetworkResult::OK)
+    {
+        releaseSocket();
+        return poller_result;
+    }
+#endif
+
+    // Only a started client holds a callback
     receive_callback_ = callback;
+    view_callback_ = view_callback;
+    listen_port_ = port;
     receiving_.store(true);
 
     receive_thread_ = std::thread(&UdpClient::receiveThread, this);
@@ -187,11 +237,27 @@ void UdpClient::stopReceiving()
     {
         receiving_.store(false);
 
+#ifdef __linux__
+        // Wake the receive thread out of epoll_wait()
+        if (wake_fd_ != -1)
+        {
+            uint64_t one = 1;
+            if (write(wake_fd_, &one, sizeof(one)) < 0)
+            {
+                ESP_LOGW(TAG, "Failed to wake UDP receive thread: %s", strerror(errno));
+            }
+        }
+#endif
+
         if (receive_thread_.joinable())
         {
             receive_thread_.join();
         }
 
+#ifdef __linux__
+        closePoller();
+#endif
+
         ESP_LOGI(TAG, "Stopped UDP receiving");
     }
 }
@@ -211,10 +277,167 @@ void UdpClient::setErrorCallback(NetworkErrorCallback callback)
     error_callback_ = callback;
 }
 
+void UdpClient::deliver(const NetworkBufferView& data)
+{
+    if (view_callback_)
+    {
+        view_callback_(NetworkResult::OK, data);
+    }
+    else if (receive_callback_)
+    {
+        NetworkBuffer received_data(data.data, data.size);
+        receive_callback_(NetworkResult::OK, received_data);
+    }
+}
+
+#ifdef __linux__
+
+NetworkResult UdpClient::createPoller()
+{
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0)
+    {
+        ESP_LOGE(TAG, "Failed to create UDP poller: %s", strerror(errno));
+        closePoller();
+        return NetworkResult::ERROR;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = socket_;
+    int socket_result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, socket_, &ev);
+
+    ev.data.fd = wake_fd_;
+    int wake_result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+
+    if (socket_result < 0 || wake_result < 0)
+    {
+        ESP_LOGE(TAG, "Failed to register UDP poller fds: %s", strerror(errno));
+        closePoller();
+        return NetworkResult::ERROR;
+    }
+
+    return NetworkResult::OK;
+}
+
+void UdpClient::closePoller()
+{
+    if (epoll_fd_ != -1)
+    {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    if (wake_fd_ != -1)
+    {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+}
+
+void UdpClient::drainSocket(UdpBufferPool& pool)
+{
+    // Pull datagrams in batches until the socket queue is empty
+    while (receiving_.load())
+    {
+        pool.reset();
+
+        int count;
+        {
+            std::lock_guard<std::mutex> lock(socket_mutex_);
+            if (socket_ == -1)
+            {
+                return;
+            }
+
+            count = recvmmsg(socket_, pool.headers(), pool.slotCount(), MSG_DONTWAIT, nullptr);
+        }
+
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                ESP_LOGE(TAG, "Failed to receive UDP data: %s", strerror(errno));
+                if (error_callback_)
+                {
+                    error_callback_(NetworkResult::ERROR, "Receive failed");
+                }
+            }
+            return;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            const struct mmsghdr& msg = pool.headers()[i];
+            if (msg.msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                ESP_LOGW(TAG, "UDP datagram truncated to %zu bytes", pool.slotSize());
+            }
+
+            if (msg.msg_len > 0)
+            {
+                deliver(pool.view(i, msg.msg_len));
+            }
+        }
+
+        if ((size_t)count < pool.slotCount())
+        {
+            return;
+        }
+    }
+}
+
 void UdpClient::receiveThread()
 {
-    const size_t BUFFER_SIZE = 4096;
-    std::vector<uint8_t> buffer(BUFFER_SIZE);
+    UdpBufferPool pool(RECV_BATCH_SIZE, RECV_SLOT_SIZE);
+    struct epoll_event events[2];
+
+    while (receiving_.load())
+    {
+        int ready = epoll_wait(epoll_fd_, events, 2, -1);
+
+        if (!receiving_.load())
+        {
+            break;
+        }
+
+        if (ready < 0)
+        {
+            if (errno != EINTR)
+            {
+                ESP_LOGE(TAG, "epoll_wait failed in UDP receive thread: %s", strerror(errno));
+                if (error_callback_)
+                {
+                    error_callback_(NetworkResult::ERROR, "Poll failed");
+                }
+                break;
+            }
+            continue;
+        }
+
+        for (int i = 0; i < ready; i++)
+        {
+            if (events[i].data.fd != wake_fd_)
+            {
+                drainSocket(pool);
+            }
+        }
+    }
+
+    ESP_LOGD(TAG, "UDP receive thread terminated");
+}
+
+#else
+
+void UdpClient::receiveThread()
+{
+    UdpBufferPool pool(1, RECV_SLOT_SIZE);
 
     while (receiving_.load())
     {
@@ -272,7 +495,7 @@ void UdpClient::receiveThread()
                 break;
             }
 
-            bytes_received = recvfrom(socket_, buffer.data(), BUFFER_SIZE, 0,
+            bytes_received = recvfrom(socket_, pool.slot(0), pool.slotSize(), 0,
                                     (struct sockaddr*)&sender_addr, &addr_len);
         }
 
@@ -289,15 +512,13 @@ void UdpClient::receiveThread()
             continue;
         }
 
-        if (bytes_received > 0 && receive_callback_)
+        if (bytes_received > 0)
         {
-            NetworkBuffer received_data(buffer.data(), bytes_received);
-            receive_callback_(NetworkResult::OK, received_data);
-
-            char sender_ip[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &sender_addr.sin_addr, sender_ip, INET_ADDRSTRLEN);
+            deliver(pool.view(0, bytes_received));
         }
     }
 
     ESP_LOGD(TAG, "UDP receive thread terminated");
-}
\ No newline at end of file
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include <thread>
 #include <mutex>
 
+class UdpBufferPool;
+
 class UdpClient
 {
 public:
@@ -18,6 +20,8 @@ public:
     NetworkResult sendBroadcast(uint16_t port, const NetworkBuffer& data);
     
     NetworkResult startReceiving(uint16_t port, NetworkCallback callback);
+    // Zero-copy variant: data points into a pooled buffer valid only during the callback
+    NetworkResult startReceivingViews(uint16_t port, NetworkViewCallback callback);
     void stopReceiving();
     
     bool isReceiving() const;
@@ -26,10 +30,19 @@ public:
     void setErrorCallback(NetworkErrorCallback callback);
 
 private:
+    NetworkResult startReceivingInternal(uint16_t port, NetworkCallback callback, NetworkViewCallback view_callback);
     void receiveThread();
+    void deliver(const NetworkBufferView& data);
     NetworkResult createSocket();
     void closeSocket();
-    
+    // socket_mutex_ must be held
+    void releaseSocket();
+#ifdef __linux__
+    NetworkResult createPoller();
+    void closePoller();
+    void drainSocket(UdpBufferPool& pool);
+#endif
+
     int socket_;
     std::atomic<bool> receiving_;
     std::thread receive_thread_;
@@ -39,5 +52,11 @@ private:
     uint32_t receive_timeout_ms_;
     
     NetworkCallback receive_callback_;
+    NetworkViewCallback view_callback_;
     NetworkErrorCallback error_callback_;
+
+#ifdef __linux__
+    int epoll_fd_;
+    int wake_fd_;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,241 @@
+// Loopback throughput benchmark for UdpServer.
+// Blasts datagrams at a local UdpServer and reports packets per second and
+// CPU time per packet, for both the copying and the zero-copy receive paths.
+//
+// Usage: udp_loopback_bench [packets] [payload_bytes] [port]
+
+#include "udp_server.h"
+#include "logging.h"
+
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Max datagrams in flight, lowered for large payloads so the window fits in
+// the receive buffer of the server socket
+static const size_t SEND_WINDOW = 128;
+static const size_t SEND_BATCH = 32;
+
+// Receive slot of UdpServer, larger datagrams would be truncated
+static const size_t MAX_PAYLOAD = 4096;
+
+// Kernel accounting per queued datagram on top of its payload buffer
+static const size_t DATAGRAM_OVERHEAD = 1024;
+
+// Outstanding datagrams are counted as dropped after this long without any
+// arriving, which also ends the wait for the tail of the stream
+static const auto STALL_TIMEOUT = std::chrono::milliseconds(200);
+
+static double cpuSeconds()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+           usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+static size_t sendWindow(size_t payload)
+{
+    // The server socket is created with the default receive buffer size
+    int probe = socket(AF_INET, SOCK_DGRAM, 0);
+    int rcvbuf = 0;
+    socklen_t len = sizeof(rcvbuf);
+    if (probe < 0 || getsockopt(probe, SOL_SOCKET, SO_RCVBUF, &rcvbuf, &len) < 0)
+        rcvbuf = 212992;
+    if (probe >= 0)
+        close(probe);
+
+    // Payload buffers are allocated in powers of two. Keep half of the
+    // receive buffer free for scheduling hiccups of the receiver.
+    size_t buffer = 512;
+    while (buffer < payload + 512)
+        buffer *= 2;
+    size_t window = rcvbuf / 2 / (buffer + DATAGRAM_OVERHEAD);
+    return std::max<size_t>(1, std::min(SEND_WINDOW, window));
+}
+
+static bool runBench(const char* name, bool zero_copy, size_t packets, size_t payload, uint16_t port)
+{
+    UdpServer server;
+    std::atomic<size_t> received(0);
+    std::atomic<size_t> bytes(0);
+
+    NetworkResult result;
+    if (zero_copy)
+    {
+        result = server.startListeningViews(port, [&](NetworkResult, const NetworkBufferView& data)
+        {
+            bytes.fetch_add(data.size, std::memory_order_relaxed);
+            received.fetch_add(1, std::memory_order_release);
+        });
+    }
+    else
+    {
+        result = server.startListening(port, [&](NetworkResult, const NetworkBuffer& data)
+        {
+            bytes.fetch_add(data.size, std::memory_order_relaxed);
+            received.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    if (result != NetworkResult::OK)
+    {
+        fprintf(stderr, "Failed to start UDP server on port %u\n", port);
+        return false;
+    }
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+    {
+        fprintf(stderr, "Failed to create sender socket: %s\n", strerror(errno));
+        return false;
+    }
+
+    struct sockaddr_in dest_addr = {};
+    dest_addr.sin_family = AF_INET;
+    dest_addr.sin_port = htons(port);
+    dest_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    std::vector<uint8_t> payload_data(payload, 0x5A);
+    struct iovec iov;
+    iov.iov_base = payload_data.data();
+    iov.iov_len = payload_data.size();
+
+    std::vector<struct mmsghdr> messages(SEND_BATCH);
+    for (auto& msg : messages)
+    {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_hdr.msg_name = &dest_addr;
+        msg.msg_hdr.msg_namelen = sizeof(dest_addr);
+        msg.msg_hdr.msg_iov = &iov;
+        msg.msg_hdr.msg_iovlen = 1;
+    }
+
+    size_t window = sendWindow(payload);
+
+    double cpu_start = cpuSeconds();
+    auto wall_start = std::chrono::steady_clock::now();
+
+    // Throughput is measured up to the last datagram seen arriving, and the
+    // time spent waiting on dropped ones is taken out of it
+    size_t seen = 0;
+    size_t dropped = 0;
+    auto last_progress = wall_start;
+    auto wall_end = wall_start;
+    double cpu_mark = cpu_start;
+    double cpu_end = cpu_start;
+    std::chrono::steady_clock::duration stalled_wall(0), pending_wall(0);
+    double stalled_cpu = 0.0, pending_cpu = 0.0;
+
+    auto poll = [&]()
+    {
+        size_t now_received = received.load(std::memory_order_acquire);
+        if (now_received != seen)
+        {
+            seen = now_received;
+            last_progress = std::chrono::steady_clock::now();
+            cpu_mark = cpuSeconds();
+            wall_end = last_progress;
+            cpu_end = cpu_mark;
+
+            // Stalls only count when the stream went on after them
+            stalled_wall += pending_wall;
+            stalled_cpu += pending_cpu;
+            pending_wall = {};
+            pending_cpu = 0.0;
+        }
+    };
+
+    size_t sent = 0;
+    while (sent < packets)
+    {
+        // Dropped datagrams that arrive late count twice, the window only widens
+        size_t done = received.load(std::memory_order_acquire) + dropped;
+        if (sent > done && sent - done >= window)
+        {
+            poll();
+            auto now = std::chrono::steady_clock::now();
+            if (now - last_progress >= STALL_TIMEOUT)
+            {
+                // Nothing in flight will arrive anymore, free the window
+                dropped = sent - seen;
+                double cpu_now = cpuSeconds();
+                pending_wall += now - last_progress;
+                pending_cpu += cpu_now - cpu_mark;
+                last_progress = now;
+                cpu_mark = cpu_now;
+                continue;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        size_t batch = std::min(SEND_BATCH, packets - sent);
+        int count = sendmmsg(sock, messages.data(), batch, 0);
+        if (count < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            fprintf(stderr, "sendmmsg failed: %s\n", strerror(errno));
+            break;
+        }
+        sent += count;
+    }
+
+    // Wait for the tail of the stream until nothing arrives anymore
+    last_progress = std::chrono::steady_clock::now();
+    for (;;)
+    {
+        poll();
+        if (seen >= sent || std::chrono::steady_clock::now() - last_progress >= STALL_TIMEOUT)
+            break;
+        std::this_thread::yield();
+    }
+
+    close(sock);
+    server.stopListening();
+
+    size_t got = received.load();
+    double wall = std::chrono::duration<double>(wall_end - wall_start - stalled_wall).count();
+    double cpu_used = cpu_end - cpu_start - stalled_cpu;
+
+    printf("%-10s packets=%zu received=%zu dropped=%zu window=%zu bytes=%zu wall=%.3fs pps=%.0f "
+           "cpu_per_packet=%.2fus\n",
+           name, sent, got, sent - got, window, bytes.load(), wall,
+           wall > 0 ? got / wall : 0.0,
+           got > 0 ? cpu_used * 1e6 / got : 0.0);
+
+    return got == sent;
+}
+
+int main(int argc, char** argv)
+{
+    size_t packets = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+    size_t payload = argc > 2 ? strtoul(argv[2], nullptr, 10) : 64;
+    uint16_t port = argc > 3 ? (uint16_t)atoi(argv[3]) : 45454;
+
+    if (payload > MAX_PAYLOAD)
+    {
+        fprintf(stderr, "Payload of %zu bytes exceeds the %zu byte receive slot of UdpServer\n",
+                payload, MAX_PAYLOAD);
+        return 1;
+    }
+
+    esp_log_level_set("net.udp", ESP_LOG_WARN);
+
+    bool ok = runBench("copy", false, packets, payload, port);
+    ok = runBench("zero-copy", true, packets, payload, port) && ok;
+
+    return ok ? 0 : 1;
+}
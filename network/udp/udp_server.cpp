@@ -1,7 +1,9 @@
 #include "udp_server.h"
+#include "udp_buffer_pool.h"
 #include "logging.h"
 
 #include <string.h>
+#include <algorithm>
 
 #ifdef __linux__
 #include <sys/socket.h>
@@ -11,6 +13,8 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <chrono>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #elif defined(ESP_PLATFORM)
 #include "lwip/sockets.h"
 #include "lwip/netdb.h"
@@ -19,6 +23,13 @@
 
 static const char *TAG = "net.udp";
 
+// Datagrams pulled per recvmmsg() call and size of each pooled slot
+static const size_t RECV_BATCH_SIZE = 32;
+static const size_t RECV_SLOT_SIZE = 4096;
+
+// Interval between expired client sweeps
+static const uint64_t CLEANUP_INTERVAL_MS = 1000;
+
 static uint64_t getCurrentTimestamp()
 {
 #ifdef __linux__
@@ -33,7 +44,13 @@ UdpServer::UdpServer():
     socket_(-1),
     listening_(false),
     listen_port_(0),
-    client_timeout_ms_(30000)
+    client_timeout_ms_(30000),
+    last_cleanup_ms_(0)
+#ifdef __linux__
+    ,
+    epoll_fd_(-1),
+    wake_fd_(-1)
+#endif
 {
 }
 
@@ -89,7 +106,11 @@ NetworkResult UdpServer::createSocket()
 void UdpServer::closeSocket()
 {
     std::lock_guard<std::mutex> lock(socket_mutex_);
+    releaseSocket();
+}
 
+void UdpServer::releaseSocket()
+{
     if (socket_ != -1)
     {
         close(socket_);
@@ -112,6 +133,28 @@ NetworkResult UdpServer::startListening(uint16_t port, NetworkCallback callback)
         return NetworkResult::INVALID_PARAMETER;
     }
 
+    return startListeningInternal(port, callback, nullptr);
+}
+
+NetworkResult UdpServer::startListeningViews(uint16_t port, NetworkViewCallback callback)
+{
+    if (listening_.load())
+    {
+        ESP_LOGE(TAG, "UDP server already listening");
+        return NetworkResult::ALREADY_CONNECTED;
+    }
+
+    if (!callback)
+    {
+        ESP_LOGE(TAG, "Invalid callback provided");
+        return NetworkResult::INVALID_PARAMETER;
+    }
+
+    return startListeningInternal(port, nullptr, callback);
+}
+
+NetworkResult UdpServer::startListeningInternal(uint16_t port, NetworkCallback callback, NetworkViewCallback view_callback)
+{
     std::lock_guard<std::mutex> lock(socket_mutex_);
 
     if (socket_ == -1)
@@ -131,11 +174,24 @@ NetworkResult UdpServer::startListening(uint16_t port, NetworkCallback callback)
     if (bind(socket_, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0)
     {
         ESP_LOGE(TAG, "Failed to bind UDP server socket to port %d: %s", port, strerror(errno));
+        releaseSocket();
         return NetworkResult::ERROR;
     }
 
-    listen_port_ = port;
+#ifdef __linux__
+    NetworkResult poller_result = createPoller();
+    if (poller_result != NetworkResult::OK)
+    {
+        releaseSocket();
+        return poller_result;
+    }
+#endif
+
+    // Only a started server holds a callback
     receive_callback_ = callback;
+    view_callback_ = view_callback;
+    listen_port_ = port;
+    last_cleanup_ms_ = getCurrentTimestamp();
     listening_.store(true);
 
     listen_thread_ = std::thread(&UdpServer::listenThread, this);
@@ -150,11 +206,27 @@ void UdpServer::stopListening()
     {
         listening_.store(false);
 
+#ifdef __linux__
+        // Wake the listen thread out of epoll_wait()
+        if (wake_fd_ != -1)
+        {
+            uint64_t one = 1;
+            if (write(wake_fd_, &one, sizeof(one)) < 0)
+            {
+                ESP_LOGW(TAG, "Failed to wake UDP server listen thread: %s", strerror(errno));
+            }
+        }
+#endif
+
         if (listen_thread_.joinable())
         {
             listen_thread_.join();
         }
 
+#ifdef __linux__
+        closePoller();
+#endif
+
         std::lock_guard<std::mutex> clients_lock(clients_mutex_);
         connected_clients_.clear();
 
@@ -219,16 +291,101 @@ NetworkResult UdpServer::sendBroadcast(const NetworkBuffer& data)
     return sendTo(broadcast_addr, data);
 }
 
+#ifdef __linux__
+
 NetworkResult UdpServer::sendToAllClients(const NetworkBuffer& data)
 {
-    std::lock_guard<std::mutex> lock(clients_mutex_);
+    std::vector<struct sockaddr_in> addresses;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        addresses.reserve(connected_clients_.size());
+
+        for (const auto& entry : connected_clients_)
+        {
+            struct sockaddr_in dest_addr = {};
+            dest_addr.sin_family = AF_INET;
+            dest_addr.sin_addr.s_addr = (uint32_t)(entry.first >> 16);
+            dest_addr.sin_port = (uint16_t)(entry.first & 0xFFFF);
+            addresses.push_back(dest_addr);
+        }
+    }
+
+    if (addresses.empty())
+    {
+        return NetworkResult::OK;
+    }
+
+    // Same payload for every client: one iovec shared by all messages
+    struct iovec iov;
+    iov.iov_base = const_cast<uint8_t*>(data.data.data());
+    iov.iov_len = data.size;
+
+    std::vector<struct mmsghdr> messages(addresses.size());
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+        memset(&messages[i], 0, sizeof(messages[i]));
+        messages[i].msg_hdr.msg_name = &addresses[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        messages[i].msg_hdr.msg_iov = &iov;
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    size_t successful_sends = 0;
+    {
+        std::lock_guard<std::mutex> lock(socket_mutex_);
+
+        if (socket_ == -1)
+        {
+            ESP_LOGE(TAG, "UDP server not initialized");
+            return NetworkResult::NOT_INITIALIZED;
+        }
+
+        while (successful_sends < messages.size())
+        {
+            int sent = sendmmsg(socket_, messages.data() + successful_sends,
+                                messages.size() - successful_sends, 0);
+            if (sent < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                ESP_LOGE(TAG, "Failed to send UDP data from server: %s", strerror(errno));
+                break;
+            }
+
+            successful_sends += sent;
+        }
+    }
+
+    ESP_LOGD(TAG, "Sent UDP data to %zu/%zu connected clients",
+              successful_sends, addresses.size());
+
+    return (successful_sends > 0) ? NetworkResult::OK : NetworkResult::ERROR;
+}
+
+#else
+
+NetworkResult UdpServer::sendToAllClients(const NetworkBuffer& data)
+{
+    std::vector<NetworkAddress> addresses;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        addresses.reserve(connected_clients_.size());
+
+        for (const auto& entry : connected_clients_)
+        {
+            addresses.push_back(entry.second.address);
+        }
+    }
 
     NetworkResult result = NetworkResult::OK;
     size_t successful_sends = 0;
 
-    for (const auto& client : connected_clients_)
+    for (const auto& address : addresses)
     {
-        NetworkResult send_result = sendTo(client.address, data);
+        NetworkResult send_result = sendTo(address, data);
         if (send_result == NetworkResult::OK)
         {
             successful_sends++;
@@ -240,15 +397,26 @@ NetworkResult UdpServer::sendToAllClients(const NetworkBuffer& data)
     }
 
     ESP_LOGD(TAG, "Sent UDP data to %zu/%zu connected clients",
-              successful_sends, connected_clients_.size());
+              successful_sends, addresses.size());
 
     return (successful_sends > 0) ? NetworkResult::OK : result;
 }
 
+#endif
+
 std::vector<UdpClientInfo> UdpServer::getConnectedClients() const
 {
     std::lock_guard<std::mutex> lock(clients_mutex_);
-    return connected_clients_;
+
+    std::vector<UdpClientInfo> clients;
+    clients.reserve(connected_clients_.size());
+
+    for (const auto& entry : connected_clients_)
+    {
+        clients.push_back(entry.second);
+    }
+
+    return clients;
 }
 
 void UdpServer::setClientTimeout(uint32_t timeoutMs)
@@ -261,22 +429,25 @@ void UdpServer::setErrorCallback(NetworkErrorCallback callback)
     error_callback_ = callback;
 }
 
-void UdpServer::updateClientList(const NetworkAddress& client_addr)
+void UdpServer::updateClientList(uint32_t addr, uint16_t port, uint64_t timestamp)
 {
-    std::lock_guard<std::mutex> lock(clients_mutex_);
-
-    uint64_t current_time = getCurrentTimestamp();
+    uint64_t key = clientKey(addr, port);
 
-    for (auto& client : connected_clients_)
+    auto it = connected_clients_.find(key);
+    if (it != connected_clients_.end())
     {
-        if (client.address.host == client_addr.host && client.address.port == client_addr.port)
-        {
-            client.last_seen = current_time;
-            return;
-        }
+        it->second.last_seen = timestamp;
+        return;
     }
 
-    connected_clients_.emplace_back(client_addr, current_time);
+    // Only format the address string for clients we have not seen yet
+    struct in_addr in;
+    in.s_addr = addr;
+    char client_ip[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &in, client_ip, INET_ADDRSTRLEN);
+
+    NetworkAddress client_addr(client_ip, ntohs(port));
+    connected_clients_.emplace(key, UdpClientInfo(client_addr, timestamp));
     ESP_LOGD(TAG, "New UDP client connected: %s:%d",
               client_addr.host.c_str(), client_addr.port);
 }
@@ -286,15 +457,20 @@ void UdpServer::cleanupExpiredClients()
     std::lock_guard<std::mutex> lock(clients_mutex_);
 
     uint64_t current_time = getCurrentTimestamp();
+    last_cleanup_ms_ = current_time;
     size_t initial_count = connected_clients_.size();
 
-    connected_clients_.erase(
-        std::remove_if(connected_clients_.begin(), connected_clients_.end(),
-                      [this, current_time](const UdpClientInfo& client)
-                      {
-                          return (current_time - client.last_seen) > client_timeout_ms_;
-                      }),
-        connected_clients_.end());
+    for (auto it = connected_clients_.begin(); it != connected_clients_.end();)
+    {
+        if ((current_time - it->second.last_seen) > client_timeout_ms_)
+        {
+            it = connected_clients_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
 
     if (connected_clients_.size() != initial_count)
     {
@@ -303,17 +479,195 @@ void UdpServer::cleanupExpiredClients()
     }
 }
 
+void UdpServer::deliver(const NetworkBufferView& data)
+{
+    if (view_callback_)
+    {
+        view_callback_(NetworkResult::OK, data);
+    }
+    else if (receive_callback_)
+    {
+        NetworkBuffer received_data(data.data, data.size);
+        receive_callback_(NetworkResult::OK, received_data);
+    }
+}
+
+#ifdef __linux__
+
+NetworkResult UdpServer::createPoller()
+{
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0)
+    {
+        ESP_LOGE(TAG, "Failed to create UDP server poller: %s", strerror(errno));
+        closePoller();
+        return NetworkResult::ERROR;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = socket_;
+    int socket_result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, socket_, &ev);
+
+    ev.data.fd = wake_fd_;
+    int wake_result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+
+    if (socket_result < 0 || wake_result < 0)
+    {
+        ESP_LOGE(TAG, "Failed to register UDP server poller fds: %s", strerror(errno));
+        closePoller();
+        return NetworkResult::ERROR;
+    }
+
+    return NetworkResult::OK;
+}
+
+void UdpServer::closePoller()
+{
+    if (epoll_fd_ != -1)
+    {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    if (wake_fd_ != -1)
+    {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+}
+
+void UdpServer::drainSocket(UdpBufferPool& pool)
+{
+    // Pull datagrams in batches until the socket queue is empty
+    while (listening_.load())
+    {
+        pool.reset();
+
+        int count;
+        {
+            std::lock_guard<std::mutex> lock(socket_mutex_);
+            if (socket_ == -1)
+            {
+                return;
+            }
+
+            count = recvmmsg(socket_, pool.headers(), pool.slotCount(), MSG_DONTWAIT, nullptr);
+        }
+
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                ESP_LOGE(TAG, "Failed to receive UDP data in server: %s", strerror(errno));
+                if (error_callback_)
+                {
+                    error_callback_(NetworkResult::ERROR, "Receive failed");
+                }
+            }
+            return;
+        }
+
+        // One lock and one timestamp for the whole batch
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex_);
+            uint64_t current_time = getCurrentTimestamp();
+
+            for (int i = 0; i < count; i++)
+            {
+                const struct sockaddr_in& client_addr = pool.address(i);
+                updateClientList(client_addr.sin_addr.s_addr, client_addr.sin_port, current_time);
+            }
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            const struct mmsghdr& msg = pool.headers()[i];
+            if (msg.msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                ESP_LOGW(TAG, "UDP datagram truncated to %zu bytes", pool.slotSize());
+            }
+
+            if (msg.msg_len > 0)
+            {
+                deliver(pool.view(i, msg.msg_len));
+            }
+        }
+
+        ESP_LOGD(TAG, "Received batch of %d UDP packets in server", count);
+
+        if ((size_t)count < pool.slotCount())
+        {
+            return;
+        }
+    }
+}
+
 void UdpServer::listenThread()
 {
-    const size_t BUFFER_SIZE = 4096;
-    std::vector<uint8_t> buffer(BUFFER_SIZE);
+    UdpBufferPool pool(RECV_BATCH_SIZE, RECV_SLOT_SIZE);
+    struct epoll_event events[2];
+
+    while (listening_.load())
+    {
+        int ready = epoll_wait(epoll_fd_, events, 2, CLEANUP_INTERVAL_MS);
+
+        if (!listening_.load())
+        {
+            break;
+        }
+
+        if (ready < 0)
+        {
+            if (errno != EINTR)
+            {
+                ESP_LOGE(TAG, "epoll_wait failed in UDP server listen thread: %s", strerror(errno));
+                if (error_callback_)
+                {
+                    error_callback_(NetworkResult::ERROR, "Poll failed");
+                }
+                break;
+            }
+            continue;
+        }
 
-    struct timeval timeout;
-    timeout.tv_sec = 1;
-    timeout.tv_usec = 0;
+        for (int i = 0; i < ready; i++)
+        {
+            if (events[i].data.fd != wake_fd_)
+            {
+                drainSocket(pool);
+            }
+        }
+
+        // Sweep on a fixed interval so sustained traffic does not starve it
+        if (getCurrentTimestamp() - last_cleanup_ms_ >= CLEANUP_INTERVAL_MS)
+        {
+            cleanupExpiredClients();
+        }
+    }
+
+    ESP_LOGD(TAG, "UDP server listen thread terminated");
+}
+
+#else
+
+void UdpServer::listenThread()
+{
+    UdpBufferPool pool(1, RECV_SLOT_SIZE);
 
     while (listening_.load())
     {
+        // select() may modify the timeout, re-arm it on every call
+        struct timeval timeout;
+        timeout.tv_sec = CLEANUP_INTERVAL_MS / 1000;
+        timeout.tv_usec = (CLEANUP_INTERVAL_MS % 1000) * 1000;
+
         fd_set read_fds;
         FD_ZERO(&read_fds);
 
@@ -333,6 +687,12 @@ void UdpServer::listenThread()
             break;
         }
 
+        // Sweep on a fixed interval so sustained traffic does not starve it
+        if (getCurrentTimestamp() - last_cleanup_ms_ >= CLEANUP_INTERVAL_MS)
+        {
+            cleanupExpiredClients();
+        }
+
         if (select_result < 0)
         {
             if (errno != EINTR)
@@ -348,7 +708,6 @@ void UdpServer::listenThread()
 
         if (select_result == 0)
         {
-            cleanupExpiredClients();
             continue;
         }
 
@@ -363,7 +722,7 @@ void UdpServer::listenThread()
                 break;
             }
 
-            bytes_received = recvfrom(socket_, buffer.data(), BUFFER_SIZE, 0,
+            bytes_received = recvfrom(socket_, pool.slot(0), pool.slotSize(), 0,
                                     (struct sockaddr*)&client_addr, &addr_len);
         }
 
@@ -382,22 +741,19 @@ void UdpServer::listenThread()
 
         if (bytes_received > 0)
         {
-            char client_ip[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, INET_ADDRSTRLEN);
-
-            NetworkAddress sender_addr(client_ip, ntohs(client_addr.sin_port));
-            updateClientList(sender_addr);
-
-            if (receive_callback_)
             {
-                NetworkBuffer received_data(buffer.data(), bytes_received);
-                receive_callback_(NetworkResult::OK, received_data);
+                std::lock_guard<std::mutex> lock(clients_mutex_);
+                updateClientList(client_addr.sin_addr.s_addr, client_addr.sin_port,
+                                 getCurrentTimestamp());
             }
 
-            ESP_LOGD(TAG, "Received UDP packet in server from %s:%d (%zd bytes)",
-                     client_ip, ntohs(client_addr.sin_port), bytes_received);
+            deliver(pool.view(0, bytes_received));
+
+            ESP_LOGD(TAG, "Received UDP packet in server (%zd bytes)", bytes_received);
         }
     }
 
     ESP_LOGD(TAG, "UDP server listen thread terminated");
-}
\ No newline at end of file
+}
+
+#endif
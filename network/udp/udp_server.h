@@ -5,6 +5,9 @@
 #include <thread>
 #include <mutex>
 #include <vector>
+#include <unordered_map>
+
+class UdpBufferPool;
 
 struct UdpClientInfo
 {
@@ -26,6 +29,8 @@ public:
     void cleanup();
 
     NetworkResult startListening(uint16_t port, NetworkCallback callback);
+    // Zero-copy variant: data points into a pooled buffer valid only during the callback
+    NetworkResult startListeningViews(uint16_t port, NetworkViewCallback callback);
     void stopListening();
 
     NetworkResult sendTo(const NetworkAddress& address, const NetworkBuffer& data);
@@ -39,11 +44,26 @@ public:
     void setErrorCallback(NetworkErrorCallback callback);
 
 private:
+    NetworkResult startListeningInternal(uint16_t port, NetworkCallback callback, NetworkViewCallback view_callback);
     void listenThread();
+    void deliver(const NetworkBufferView& data);
     void cleanupExpiredClients();
     NetworkResult createSocket();
     void closeSocket();
-    void updateClientList(const NetworkAddress& client_addr);
+    // socket_mutex_ must be held
+    void releaseSocket();
+    // addr and port are in network byte order, clients_mutex_ must be held
+    void updateClientList(uint32_t addr, uint16_t port, uint64_t timestamp);
+#ifdef __linux__
+    NetworkResult createPoller();
+    void closePoller();
+    void drainSocket(UdpBufferPool& pool);
+#endif
+
+    static uint64_t clientKey(uint32_t addr, uint16_t port)
+    {
+        return ((uint64_t)addr << 16) | port;
+    }
 
     int socket_;
     std::atomic<bool> listening_;
@@ -54,7 +74,16 @@ private:
     uint16_t listen_port_;
     uint32_t client_timeout_ms_;
 
-    std::vector<UdpClientInfo> connected_clients_;
+    uint64_t last_cleanup_ms_;
+
+    // Keyed by clientKey() so the per-packet lookup avoids string compares
+    std::unordered_map<uint64_t, UdpClientInfo> connected_clients_;
     NetworkCallback receive_callback_;
+    NetworkViewCallback view_callback_;
     NetworkErrorCallback error_callback_;
+
+#ifdef __linux__
+    int epoll_fd_;
+    int wake_fd_;
+#endif
 };
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "mongoose.h"
 #include <chrono>
 #include <cstring>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
 
 #ifdef __linux__
 #include <unistd.h>
@@ -12,6 +15,9 @@
 
 static const char *TAG = "net.ws";
 
+// Shortest probe interval, whatever the configuration says
+static const uint32_t MIN_PROBE_INTERVAL_MS = 250;
+
 static uint64_t getCurrentTimestamp()
 {
 #ifdef __linux__
@@ -28,9 +34,26 @@ WebSocketClient::WebSocketClient():
     state_(WebSocketState::DISCONNECTED),
     running_(false),
     should_reconnect_(false),
-    reconnect_attempts_(0),
+    reconnect_immediately_(false),
+    abort_connect_(false),
+    connect_pending_(false),
+    reconnect_at_ms_(0),
+    send_flushed_total_(0),
+    sent_count_(0),
+    connect_started_ms_(0),
     last_ping_time_(0),
-    last_pong_time_(0)
+    last_pong_time_(0),
+    probe_seq_(0),
+    probe_outstanding_(false),
+    probe_interval_ms_(0),
+    missed_pongs_(0),
+    last_rx_time_(0),
+    last_tx_time_(0),
+    network_changed_(false),
+    loss_history_(0),
+    loss_samples_(0),
+    srtt_ms_(0.0f),
+    rttvar_ms_(0.0f)
 {
 }
 
@@ -73,7 +96,11 @@ void WebSocketClient::cleanup()
 
     if (running_.load())
     {
-        running_.store(false);
+        {
+            std::lock_guard<std::mutex> lock(reconnect_mutex_);
+            running_.store(false);
+        }
+        reconnect_cv_.notify_all();
 
         if (service_thread_.joinable())
         {
@@ -88,11 +115,20 @@ void WebSocketClient::cleanup()
 
     destroyManager();
 
-    std::lock_guard<std::mutex> lock(messages_mutex_);
-    while (!outgoing_messages_.empty())
+    WebSocketSendQueue::Completions done;
     {
-        outgoing_messages_.pop();
+        std::lock_guard<std::mutex> lock(messages_mutex_);
+        outgoing_queue_.clear(WebSocketSendResult::CANCELLED, done);
+        for (auto& msg : in_flight_)
+        {
+            if (msg.on_complete)
+            {
+                done.emplace_back(std::move(msg.on_complete), WebSocketSendResult::CANCELLED);
+            }
+        }
+        in_flight_.clear();
     }
+    runCompletions(done);
 }
 
 void WebSocketClient::destroyManager()
@@ -120,6 +156,20 @@ NetworkResult WebSocketClient::connect(const WebSocketConfig& config)
         return NetworkResult::INVALID_PARAMETER;
     }
 
+    // A fresh connection supersedes any pending retry and starts a new backoff
+    cancelReconnect();
+    {
+        std::lock_guard<std::mutex> lock(reconnect_mutex_);
+        reconnect_policy_.configure(config.reconnect_delay_ms, config.max_reconnect_delay_ms,
+                                    config.max_reconnect_attempts);
+        reconnect_policy_.reset();
+    }
+
+    return openConnection(config);
+}
+
+NetworkResult WebSocketClient::openConnection(const WebSocketConfig& config)
+{
     if (state_.load() == WebSocketState::CONNECTED ||
         state_.load() == WebSocketState::CONNECTING)
     {
@@ -129,46 +179,78 @@ NetworkResult WebSocketClient::connect(const WebSocketConfig& config)
 
     std::lock_guard<std::mutex> lock(config_mutex_);
     current_config_ = config;
-    reconnect_attempts_ = 0;
 
-    state_.store(WebSocketState::CONNECTING);
-    if (state_callback_)
+    // The probe interval starts here and doubles, 0 would probe on every loop
+    if (current_config_.ping_interval_ms > 0)
     {
-        state_callback_(WebSocketState::CONNECTING);
+        uint32_t floor = std::min(MIN_PROBE_INTERVAL_MS, current_config_.ping_interval_ms);
+        current_config_.min_ping_interval_ms = std::clamp(current_config_.min_ping_interval_ms,
+                                                          floor, current_config_.ping_interval_ms);
     }
+    abort_connect_.store(false);
 
-    // Build headers string for mongoose
-    std::string headerStr;
-    for (const auto& header : current_config_.headers)
     {
-        headerStr += header.first + ": " + header.second + "\r\n";
+        std::lock_guard<std::mutex> messages_lock(messages_mutex_);
+        outgoing_queue_.setLimits(config.max_queue_messages, config.max_queue_bytes,
+                                  config.overflow_policy);
     }
 
-    ESP_LOGD(TAG, "WebSocket headers: %s", headerStr.c_str());
-
-    // Create WebSocket connection using mongoose with headers
-    if (headerStr.empty())
+    state_.store(WebSocketState::CONNECTING);
+    if (state_callback_)
     {
-        conn_ = mg_ws_connect(mgr_, current_config_.url.c_str(), websocketEventHandler, this, nullptr);
+        state_callback_(WebSocketState::CONNECTING);
     }
-    else
+
+    // Mongoose is not thread-safe, the service thread opens the connection
+    connect_pending_.store(true);
+    return NetworkResult::OK;
+}
+
+void WebSocketClient::startPendingConnection()
+{
+    if (!connect_pending_.exchange(false))
     {
-        conn_ = mg_ws_connect(mgr_, current_config_.url.c_str(), websocketEventHandler, this, "%s", headerStr.c_str());
+        return;
     }
 
-    if (!conn_)
     {
-        ESP_LOGE(TAG, "Failed to create WebSocket connection");
-        state_.store(WebSocketState::ERROR);
-        if (error_callback_)
+        std::lock_guard<std::mutex> lock(config_mutex_);
+
+        // Build headers string for mongoose
+        std::string headerStr;
+        for (const auto& header : current_config_.headers)
+        {
+            headerStr += header.first + ": " + header.second + "\r\n";
+        }
+
+        ESP_LOGD(TAG, "WebSocket headers: %s", headerStr.c_str());
+
+        connect_started_ms_.store(getCurrentTimestamp());
+
+        // Create WebSocket connection using mongoose with headers
+        if (headerStr.empty())
+        {
+            conn_ = mg_ws_connect(mgr_, current_config_.url.c_str(), websocketEventHandler, this, nullptr);
+        }
+        else
+        {
+            conn_ = mg_ws_connect(mgr_, current_config_.url.c_str(), websocketEventHandler, this, "%s", headerStr.c_str());
+        }
+
+        if (conn_)
         {
-            error_callback_(NetworkResult::CONNECTION_FAILED, "Failed to create connection");
+            ESP_LOGI(TAG, "WebSocket connecting to %s", current_config_.url.c_str());
+            return;
         }
-        return NetworkResult::CONNECTION_FAILED;
     }
 
-    ESP_LOGI(TAG, "WebSocket connecting to %s", current_config_.url.c_str());
-    return NetworkResult::OK;
+    ESP_LOGE(TAG, "Failed to create WebSocket connection");
+    state_.store(WebSocketState::ERROR);
+    if (error_callback_)
+    {
+        error_callback_(NetworkResult::CONNECTION_FAILED, "Failed to create connection");
+    }
+    scheduleReconnect();
 }
 
 void WebSocketClient::disconnect()
@@ -180,7 +262,8 @@ void WebSocketClient::disconnect()
         return;
     }
 
-    should_reconnect_.store(false);
+    cancelReconnect();
+    connect_pending_.store(false);
 
     std::lock_guard<std::mutex> lock(config_mutex_);
 
@@ -200,7 +283,7 @@ void WebSocketClient::disconnect()
     ESP_LOGI(TAG, "WebSocket disconnected");
 }
 
-NetworkResult WebSocketClient::sendText(const std::string& message)
+NetworkResult WebSocketClient::sendText(const std::string& message, const WebSocketSendOptions& options)
 {
     if (state_.load() != WebSocketState::CONNECTED)
     {
@@ -211,17 +294,10 @@ NetworkResult WebSocketClient::sendText(const std::string& message)
     WebSocketMessage msg(message);
     msg.is_binary = false;
 
-    {
-        std::lock_guard<std::mutex> lock(messages_mutex_);
-        outgoing_messages_.push(msg);
-    }
-
-    processOutgoingMessages();
-
-    return NetworkResult::OK;
+    return enqueueMessage(std::move(msg), options);
 }
 
-NetworkResult WebSocketClient::sendBinary(const std::vector<uint8_t>& data)
+NetworkResult WebSocketClient::sendBinary(const std::vector<uint8_t>& data, const WebSocketSendOptions& options)
 {
     if (state_.load() != WebSocketState::CONNECTED)
     {
@@ -232,21 +308,54 @@ NetworkResult WebSocketClient::sendBinary(const std::vector<uint8_t>& data)
     WebSocketMessage msg(data);
     msg.is_binary = true;
 
+    return enqueueMessage(std::move(msg), options);
+}
+
+NetworkResult WebSocketClient::sendJson(const std::string& json, const WebSocketSendOptions& options)
+{
+    return sendText(json, options);
+}
+
+NetworkResult WebSocketClient::enqueueMessage(WebSocketMessage&& message, const WebSocketSendOptions& options)
+{
+    uint32_t ttl_ms = options.ttl_ms;
+    if (ttl_ms == 0)
+    {
+        // openConnection can rewrite the config from another thread
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        ttl_ms = current_config_.default_message_ttl_ms;
+    }
+
+    uint64_t now = getCurrentTimestamp();
+
+    WebSocketSendQueue::Entry entry;
+    entry.message = std::move(message);
+    entry.priority = options.priority;
+    entry.enqueued_ms = now;
+    entry.expires_ms = ttl_ms ? now + ttl_ms : 0;
+    entry.replace_key = options.replace_key;
+    entry.on_complete = options.on_complete;
+
+    WebSocketSendQueue::Completions done;
+    bool accepted;
     {
         std::lock_guard<std::mutex> lock(messages_mutex_);
-        outgoing_messages_.push(msg);
+        accepted = outgoing_queue_.push(std::move(entry), done);
+    }
+    runCompletions(done);
+
+    if (!accepted)
+    {
+        return NetworkResult::BUFFER_TOO_SMALL;
     }
 
+    last_tx_time_.store(now);
+
     processOutgoingMessages();
 
     return NetworkResult::OK;
 }
 
-NetworkResult WebSocketClient::sendJson(const std::string& json)
-{
-    return sendText(json);
-}
-
 NetworkResult WebSocketClient::ping(const std::string& data)
 {
     if (state_.load() != WebSocketState::CONNECTED || !conn_)
@@ -273,11 +382,39 @@ bool WebSocketClient::isConnected() const
     return state_.load() == WebSocketState::CONNECTED;
 }
 
+WebSocketQueueMetrics WebSocketClient::getQueueMetrics() const
+{
+    WebSocketQueueMetrics metrics;
+    uint64_t now = getCurrentTimestamp();
+
+    std::lock_guard<std::mutex> lock(messages_mutex_);
+
+    metrics.queued_messages = outgoing_queue_.size();
+    metrics.queued_bytes = outgoing_queue_.bytes();
+
+    uint64_t oldest = outgoing_queue_.oldestEnqueuedMs();
+    metrics.oldest_age_ms = (oldest && now > oldest) ? now - oldest : 0;
+
+    metrics.in_flight_messages = in_flight_.size();
+    metrics.send_buffer_bytes = conn_ ? conn_->send.len : 0;
+    metrics.sent = sent_count_;
+    metrics.dropped = outgoing_queue_.droppedCount();
+    metrics.expired = outgoing_queue_.expiredCount();
+    metrics.replaced = outgoing_queue_.replacedCount();
+
+    return metrics;
+}
+
 void WebSocketClient::setMessageCallback(WebSocketMessageCallback callback)
 {
     message_callback_ = callback;
 }
 
+void WebSocketClient::setMessageViewCallback(WebSocketMessageViewCallback callback)
+{
+    message_view_callback_ = callback;
+}
+
 void WebSocketClient::setStateCallback(WebSocketStateCallback callback)
 {
     state_callback_ = callback;
@@ -293,6 +430,66 @@ void WebSocketClient::setErrorCallback(NetworkErrorCallback callback)
     error_callback_ = callback;
 }
 
+void WebSocketClient::setLinkStatsCallback(WebSocketLinkStatsCallback callback)
+{
+    link_stats_callback_ = callback;
+}
+
+WebSocketLinkStats WebSocketClient::getLinkStats() const
+{
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return link_stats_;
+}
+
+void WebSocketClient::notifyNetworkChanged()
+{
+    ESP_LOGI(TAG, "Network changed, probing WebSocket link");
+    network_changed_.store(true);
+}
+
+void WebSocketClient::reconnectNow()
+{
+    WebSocketState state = state_.load();
+    if (state == WebSocketState::CONNECTED)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        if (!current_config_.auto_reconnect)
+        {
+            return;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(reconnect_mutex_);
+
+        if (should_reconnect_.load())
+        {
+            reconnect_at_ms_ = 0;
+        }
+        else if (state == WebSocketState::CONNECTING)
+        {
+            // The attempt in flight most likely lost its SYN or handshake with
+            // the old link, start over instead of waiting for the connect timeout
+            reconnect_immediately_.store(true);
+            abort_connect_.store(true);
+        }
+        else
+        {
+            return;
+        }
+
+        // The outage is over, a failure now should not inherit its long delays
+        reconnect_policy_.reset();
+    }
+
+    ESP_LOGI(TAG, "Network is back, reconnecting WebSocket now");
+    reconnect_cv_.notify_one();
+}
+
 void WebSocketClient::setReconnectConfigCallback(ReconnectConfigCallback callback)
 {
     reconnect_config_callback_ = callback;
@@ -307,17 +504,33 @@ void WebSocketClient::setAutoReconnect(bool enabled)
 
 void WebSocketClient::scheduleReconnect()
 {
-    if (!current_config_.auto_reconnect || reconnect_attempts_ >= current_config_.max_reconnect_attempts)
+    if (!current_config_.auto_reconnect)
     {
-        ESP_LOGW(TAG, "WebSocket reconnection disabled or max attempts reached");
+        ESP_LOGW(TAG, "WebSocket reconnection disabled");
         state_.store(WebSocketState::ERROR);
         return;
     }
 
-    uint32_t delay_ms = current_config_.reconnect_delay_ms * (1 << std::min<uint32_t>(reconnect_attempts_, 5u));
-    ESP_LOGI(TAG, "WebSocket will reconnect in %u ms (attempt %u)", delay_ms, reconnect_attempts_ + 1);
+    uint32_t delay_ms = 0;
+    uint32_t attempt = 0;
+    {
+        std::lock_guard<std::mutex> lock(reconnect_mutex_);
+
+        if (!reconnect_immediately_.exchange(false) && !reconnect_policy_.next(delay_ms))
+        {
+            ESP_LOGW(TAG, "WebSocket max reconnection attempts reached");
+            state_.store(WebSocketState::ERROR);
+            return;
+        }
+
+        reconnect_at_ms_ = getCurrentTimestamp() + delay_ms;
+        should_reconnect_.store(true);
+        attempt = reconnect_policy_.attempts();
+    }
+    reconnect_cv_.notify_one();
+
+    ESP_LOGI(TAG, "WebSocket will reconnect in %u ms (attempt %u)", delay_ms, attempt);
 
-    should_reconnect_.store(true);
     state_.store(WebSocketState::CLOSING);
 
     if (state_callback_)
@@ -326,6 +539,46 @@ void WebSocketClient::scheduleReconnect()
     }
 }
 
+void WebSocketClient::cancelReconnect()
+{
+    std::lock_guard<std::mutex> lock(reconnect_mutex_);
+    should_reconnect_.store(false);
+    reconnect_immediately_.store(false);
+}
+
+void WebSocketClient::checkConnectTimeout()
+{
+    if (!conn_ || state_.load() != WebSocketState::CONNECTING)
+    {
+        return;
+    }
+
+    bool abort = abort_connect_.exchange(false);
+    uint64_t elapsed = getCurrentTimestamp() - connect_started_ms_.load();
+
+    if (!abort && (current_config_.connect_timeout_ms == 0 || elapsed < current_config_.connect_timeout_ms))
+    {
+        return;
+    }
+
+    if (!abort)
+    {
+        ESP_LOGW(TAG, "WebSocket connect timed out after %llu ms", (unsigned long long)elapsed);
+    }
+
+    // MG_EV_CLOSE sees the CONNECTING state and schedules the next attempt
+    conn_->is_closing = 1;
+}
+
+void WebSocketClient::runCompletions(WebSocketSendQueue::Completions& done)
+{
+    for (auto& completion : done)
+    {
+        completion.first(completion.second);
+    }
+    done.clear();
+}
+
 void WebSocketClient::processOutgoingMessages()
 {
     if (!conn_ || state_.load() != WebSocketState::CONNECTED)
@@ -333,19 +586,287 @@ void WebSocketClient::processOutgoingMessages()
         return;
     }
 
-    std::lock_guard<std::mutex> lock(messages_mutex_);
+    size_t send_limit;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        send_limit = current_config_.max_send_buffer_bytes;
+    }
 
-    while (!outgoing_messages_.empty())
+    WebSocketSendQueue::Completions done;
     {
-        WebSocketMessage& msg = outgoing_messages_.front();
+        std::lock_guard<std::mutex> lock(messages_mutex_);
+
+        uint64_t now = getCurrentTimestamp();
+        WebSocketSendQueue::Entry entry;
 
-        unsigned char op = msg.is_binary ? WEBSOCKET_OP_BINARY : WEBSOCKET_OP_TEXT;
+        // Leave messages queued while mongoose still holds unsent data, so that
+        // priority and TTL keep applying instead of piling into c->send
+        while ((send_limit == 0 || conn_->send.len < send_limit) &&
+               outgoing_queue_.popNext(now, entry, done))
+        {
+            unsigned char op = entry.message.is_binary ? WEBSOCKET_OP_BINARY : WEBSOCKET_OP_TEXT;
+
+            mg_ws_send(conn_, entry.message.data.c_str(), entry.message.data.size(), op);
 
-        mg_ws_send(conn_, msg.data.c_str(), msg.data.size(), op);
+            in_flight_.push_back({send_flushed_total_ + conn_->send.len, std::move(entry.on_complete)});
 
-        ESP_LOGD(TAG, "WebSocket message sent: %zu bytes", msg.data.size());
+            ESP_LOGD(TAG, "WebSocket message sent: %zu bytes", entry.message.data.size());
+        }
+    }
+    runCompletions(done);
+}
 
-        outgoing_messages_.pop();
+void WebSocketClient::expireOutgoingMessages()
+{
+    WebSocketSendQueue::Completions done;
+    {
+        std::lock_guard<std::mutex> lock(messages_mutex_);
+        if (outgoing_queue_.empty())
+        {
+            return;
+        }
+        outgoing_queue_.expire(getCurrentTimestamp(), done);
+    }
+    runCompletions(done);
+}
+
+void WebSocketClient::onSendBufferFlushed(size_t bytes)
+{
+    WebSocketSendQueue::Completions done;
+    {
+        std::lock_guard<std::mutex> lock(messages_mutex_);
+        send_flushed_total_ += bytes;
+
+        while (!in_flight_.empty() && in_flight_.front().end_offset <= send_flushed_total_)
+        {
+            sent_count_++;
+            if (in_flight_.front().on_complete)
+            {
+                done.emplace_back(std::move(in_flight_.front().on_complete), WebSocketSendResult::SENT);
+            }
+            in_flight_.pop_front();
+        }
+    }
+    runCompletions(done);
+}
+
+void WebSocketClient::cancelInFlightMessages()
+{
+    WebSocketSendQueue::Completions done;
+    {
+        std::lock_guard<std::mutex> lock(messages_mutex_);
+        for (auto& msg : in_flight_)
+        {
+            if (msg.on_complete)
+            {
+                done.emplace_back(std::move(msg.on_complete), WebSocketSendResult::CANCELLED);
+            }
+        }
+        in_flight_.clear();
+        send_flushed_total_ = 0;
+    }
+    runCompletions(done);
+}
+
+void WebSocketClient::resetLinkState()
+{
+    probe_outstanding_ = false;
+    probe_interval_ms_ = current_config_.min_ping_interval_ms;
+    missed_pongs_ = 0;
+    last_rx_time_ = getCurrentTimestamp();
+    last_tx_time_.store(0);
+    loss_history_ = 0;
+    loss_samples_ = 0;
+    srtt_ms_ = 0.0f;
+    rttvar_ms_ = 0.0f;
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    link_stats_ = WebSocketLinkStats();
+    link_stats_.probe_interval_ms = probe_interval_ms_;
+}
+
+uint32_t WebSocketClient::probeTimeoutMs() const
+{
+    // No sample yet: fall back to the configured timeout
+    if (srtt_ms_ <= 0.0f)
+    {
+        return current_config_.pong_timeout_ms;
+    }
+
+    uint32_t timeout = static_cast<uint32_t>(srtt_ms_ + 4.0f * rttvar_ms_);
+    return std::clamp(timeout, current_config_.min_pong_timeout_ms,
+                      std::max(current_config_.min_pong_timeout_ms, current_config_.pong_timeout_ms));
+}
+
+void WebSocketClient::sendProbe(uint64_t now)
+{
+    // The payload carries a sequence number so late pongs are not mistaken
+    // for the answer to the current probe
+    char payload[16];
+    int len = snprintf(payload, sizeof(payload), "%u", ++probe_seq_);
+
+    mg_ws_send(conn_, payload, len, WEBSOCKET_OP_PING);
+    last_ping_time_ = now;
+    probe_outstanding_ = true;
+
+    ESP_LOGD(TAG, "WebSocket probe %u sent (interval %u ms, timeout %u ms)",
+             probe_seq_, probe_interval_ms_, probeTimeoutMs());
+}
+
+void WebSocketClient::recordProbe(bool lost, uint32_t rtt_ms)
+{
+    loss_history_ = static_cast<uint16_t>((loss_history_ << 1) | (lost ? 1 : 0));
+    if (loss_samples_ < 16)
+    {
+        loss_samples_++;
+    }
+
+    if (!lost)
+    {
+        // RFC 6298 smoothing
+        if (srtt_ms_ <= 0.0f)
+        {
+            srtt_ms_ = static_cast<float>(rtt_ms);
+            rttvar_ms_ = srtt_ms_ / 2.0f;
+        }
+        else
+        {
+            rttvar_ms_ = 0.75f * rttvar_ms_ + 0.25f * std::fabs(srtt_ms_ - rtt_ms);
+            srtt_ms_ = 0.875f * srtt_ms_ + 0.125f * rtt_ms;
+        }
+    }
+
+    uint16_t mask = loss_samples_ >= 16 ? 0xFFFF : static_cast<uint16_t>((1u << loss_samples_) - 1);
+    int lost_count = __builtin_popcount(loss_history_ & mask);
+
+    WebSocketLinkStats stats;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        if (!lost)
+        {
+            link_stats_.last_rtt_ms = rtt_ms;
+        }
+        else
+        {
+            link_stats_.probes_lost++;
+        }
+        link_stats_.probes_sent++;
+        link_stats_.smoothed_rtt_ms = static_cast<uint32_t>(srtt_ms_ + 0.5f);
+        link_stats_.jitter_ms = static_cast<uint32_t>(rttvar_ms_ + 0.5f);
+        link_stats_.loss = static_cast<float>(lost_count) / loss_samples_;
+        link_stats_.probe_interval_ms = probe_interval_ms_;
+        stats = link_stats_;
+    }
+
+    if (link_stats_callback_)
+    {
+        link_stats_callback_(stats);
+    }
+}
+
+void WebSocketClient::onPong(const char* data, size_t len)
+{
+    uint64_t now = getCurrentTimestamp();
+    last_pong_time_ = now;
+    last_rx_time_ = now;
+
+    if (len == 0 || len >= 16)
+    {
+        return;
+    }
+
+    char payload[16];
+    memcpy(payload, data, len);
+    payload[len] = '\0';
+
+    uint32_t seq = strtoul(payload, nullptr, 10);
+    if (!probe_outstanding_ || seq != probe_seq_)
+    {
+        // A late answer to an earlier probe still proves the server is there,
+        // it only carries no usable RTT sample
+        if (seq != 0 && seq <= probe_seq_)
+        {
+            missed_pongs_ = 0;
+        }
+        ESP_LOGD(TAG, "Late pong %s (expecting %u)", payload, probe_seq_);
+        return;
+    }
+
+    probe_outstanding_ = false;
+    missed_pongs_ = 0;
+
+    // Healthy answer: back off towards the idle interval
+    probe_interval_ms_ = std::min(probe_interval_ms_ * 2, current_config_.ping_interval_ms);
+
+    recordProbe(false, static_cast<uint32_t>(now - last_ping_time_));
+
+    ESP_LOGD(TAG, "WebSocket pong %u: rtt %llu ms, srtt %.1f ms, rttvar %.1f ms",
+             probe_seq_, (unsigned long long)(now - last_ping_time_), srtt_ms_, rttvar_ms_);
+}
+
+void WebSocketClient::updateKeepalive()
+{
+    if (current_config_.ping_interval_ms == 0 || !conn_)
+    {
+        return;
+    }
+
+    uint64_t now = getCurrentTimestamp();
+    bool probe_now = false;
+
+    if (network_changed_.exchange(false))
+    {
+        probe_interval_ms_ = current_config_.min_ping_interval_ms;
+        probe_now = true;
+    }
+
+    if (probe_outstanding_)
+    {
+        if (now - last_ping_time_ < probeTimeoutMs())
+        {
+            return;
+        }
+
+        probe_outstanding_ = false;
+
+        // Data arrived after the ping: the link works, only the pong is slow
+        if (last_rx_time_ > last_ping_time_)
+        {
+            missed_pongs_ = 0;
+            ESP_LOGD(TAG, "WebSocket pong %u late but link active", probe_seq_);
+            return;
+        }
+
+        missed_pongs_++;
+        probe_interval_ms_ = current_config_.min_ping_interval_ms;
+        recordProbe(true, 0);
+
+        ESP_LOGW(TAG, "WebSocket pong missed (%u/%u)", missed_pongs_, current_config_.max_missed_pongs);
+
+        if (missed_pongs_ >= std::max(1u, current_config_.max_missed_pongs))
+        {
+            ESP_LOGE(TAG, "WebSocket ping timeout");
+            disconnect();
+            scheduleReconnect();
+            return;
+        }
+
+        // Re-probe right away instead of waiting another interval
+        probe_now = true;
+    }
+
+    // Something was sent but nothing came back since: check the link now
+    uint64_t last_tx = last_tx_time_.load();
+    if (current_config_.send_echo_timeout_ms > 0 &&
+        last_tx > last_rx_time_ && last_tx > last_ping_time_ &&
+        now - last_tx >= current_config_.send_echo_timeout_ms)
+    {
+        probe_now = true;
+    }
+
+    if (probe_now || now - last_ping_time_ >= probe_interval_ms_)
+    {
+        sendProbe(now);
     }
 }
 
@@ -355,33 +876,23 @@ void WebSocketClient::serviceThread()
 
     while (running_.load())
     {
+        startPendingConnection();
+
         if (mgr_)
         {
             mg_mgr_poll(mgr_, 50);
         }
 
         // Process outgoing messages
-        if (state_.load() == WebSocketState::CONNECTED)
+        if (state_.load() != WebSocketState::CONNECTED)
+        {
+            expireOutgoingMessages();
+            checkConnectTimeout();
+        }
+        else
         {
             processOutgoingMessages();
-
-            // Send periodic pings if enabled
-            if (current_config_.ping_interval_ms > 0)
-            {
-                uint64_t now = getCurrentTimestamp();
-                if (now - last_ping_time_ >= current_config_.ping_interval_ms)
-                {
-                    ping();
-                }
-                else if (current_config_.pong_timeout_ms > 0 &&
-                         last_ping_time_ > last_pong_time_ &&
-                         now - last_ping_time_ >= current_config_.pong_timeout_ms)
-                {
-                    ESP_LOGE(TAG, "WebSocket ping timeout");
-                    disconnect();
-                    scheduleReconnect();
-                }
-            }
+            updateKeepalive();
         }
     }
 
@@ -392,52 +903,63 @@ void WebSocketClient::reconnectThread()
 {
     ESP_LOGD(TAG, "WebSocket reconnect thread started");
 
+    std::unique_lock<std::mutex> lock(reconnect_mutex_);
+
     while (running_.load())
     {
-        if (should_reconnect_.load())
+        if (!should_reconnect_.load())
         {
-            should_reconnect_.store(false);
-            reconnect_attempts_++;
+            reconnect_cv_.wait(lock);
+            continue;
+        }
 
-            uint32_t delay_ms = current_config_.reconnect_delay_ms *
-                               (1 << std::min<uint32_t>(reconnect_attempts_ - 1, 5u));
+        // reconnectNow(), disconnect() and cleanup() wake us up early
+        uint64_t now = getCurrentTimestamp();
+        if (now < reconnect_at_ms_)
+        {
+            reconnect_cv_.wait_for(lock, std::chrono::milliseconds(reconnect_at_ms_ - now));
+            continue;
+        }
 
-            ESP_LOGI(TAG, "WebSocket reconnecting in %u ms (attempt %u/%u)",
-                     delay_ms, reconnect_attempts_, current_config_.max_reconnect_attempts);
+        should_reconnect_.store(false);
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        lock.unlock();
+        attemptReconnect();
+        lock.lock();
+    }
 
-            if (running_.load() && state_.load() != WebSocketState::CONNECTED)
-            {
-                WebSocketConfig config;
-
-                // If a reconnect config callback is set, use it to get fresh config
-                // This allows regenerating auth headers (nonce, timestamp, HMAC)
-                if (reconnect_config_callback_)
-                {
-                    ESP_LOGD(TAG, "Getting fresh config from reconnect callback");
-                    config = reconnect_config_callback_();
-                }
-                else
-                {
-                    std::lock_guard<std::mutex> lock(config_mutex_);
-                    config = current_config_;
-                }
-
-                ESP_LOGI(TAG, "WebSocket attempting reconnection...");
-                NetworkResult result = connect(config);
-
-                if (result != NetworkResult::OK)
-                {
-                    scheduleReconnect();
-                }
-            }
-        }
+    ESP_LOGD(TAG, "WebSocket reconnect thread terminated");
+}
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+void WebSocketClient::attemptReconnect()
+{
+    if (!running_.load() || state_.load() == WebSocketState::CONNECTED)
+    {
+        return;
     }
 
-    ESP_LOGD(TAG, "WebSocket reconnect thread terminated");
+    WebSocketConfig config;
+
+    // If a reconnect config callback is set, use it to get fresh config
+    // This allows regenerating auth headers (nonce, timestamp, HMAC)
+    if (reconnect_config_callback_)
+    {
+        ESP_LOGD(TAG, "Getting fresh config from reconnect callback");
+        config = reconnect_config_callback_();
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        config = current_config_;
+    }
+
+    ESP_LOGI(TAG, "WebSocket attempting reconnection...");
+    NetworkResult result = openConnection(config);
+
+    if (result != NetworkResult::OK && result != NetworkResult::ALREADY_CONNECTED)
+    {
+        scheduleReconnect();
+    }
 }
 
 void WebSocketClient::websocketEventHandler(struct mg_connection* c, int ev, void* ev_data, void* fn_data)
@@ -475,6 +997,22 @@ void WebSocketClient::websocketEventHandler(struct mg_connection* c, int ev, voi
         case MG_EV_OPEN:
         {
             ESP_LOGD(TAG, "WebSocket connection opened");
+            client->cancelInFlightMessages();
+            break;
+        }
+
+        case MG_EV_WRITE:
+        {
+            // Ignore a previous connection still flushing while it closes
+            if (client->conn_ != c)
+            {
+                break;
+            }
+
+            client->onSendBufferFlushed(static_cast<size_t>(*static_cast<long*>(ev_data)));
+
+            // Room freed in the send buffer, keep draining
+            client->processOutgoingMessages();
             break;
         }
 
@@ -482,9 +1020,13 @@ void WebSocketClient::websocketEventHandler(struct mg_connection* c, int ev, voi
         {
             ESP_LOGI(TAG, "WebSocket handshake completed");
             client->state_.store(WebSocketState::CONNECTED);
-            client->reconnect_attempts_ = 0;
+            {
+                std::lock_guard<std::mutex> lock(client->reconnect_mutex_);
+                client->reconnect_policy_.reset();
+            }
             client->last_ping_time_ = getCurrentTimestamp();
             client->last_pong_time_ = client->last_ping_time_;
+            client->resetLinkState();
 
             if (client->state_callback_)
             {
@@ -496,36 +1038,32 @@ void WebSocketClient::websocketEventHandler(struct mg_connection* c, int ev, voi
         case MG_EV_WS_MSG:
         {
             struct mg_ws_message* wm = static_cast<struct mg_ws_message*>(ev_data);
+            client->last_rx_time_ = getCurrentTimestamp();
 
-            if (!client->message_callback_)
+            // Mongoose reassembles fragmented messages in place in c->recv, so
+            // wm->data always covers the whole message and flags carry the
+            // opcode of the first frame.
+            WebSocketOpcode opcode = static_cast<WebSocketOpcode>(wm->flags & 0x0F);
+            if (opcode != WebSocketOpcode::BINARY)
             {
-                break;
+                opcode = WebSocketOpcode::TEXT;
             }
 
-            // Create message and determine if it's binary or text
-            WebSocketMessage msg;
-            msg.data.assign(wm->data.ptr, wm->data.ptr + wm->data.len);
+            ESP_LOGD(TAG, "WebSocket message received: %zu bytes, is_binary: %d",
+                     wm->data.len, opcode == WebSocketOpcode::BINARY);
 
-            // Determine message type based on opcode (lower 4 bits of flags)
-            uint8_t opcode = wm->flags & 0x0F;
-            if (opcode == 0x01)  // Text frame
+            if (client->message_view_callback_)
             {
-                msg.is_binary = false;
+                WebSocketMessageView view(std::string_view(wm->data.ptr, wm->data.len), opcode);
+                client->message_view_callback_(view);
             }
-            else if (opcode == 0x02)  // Binary frame
+            else if (client->message_callback_)
             {
-                msg.is_binary = true;
+                // assign() keeps the string capacity, no allocation once warmed up
+                client->rx_message_.data.assign(wm->data.ptr, wm->data.len);
+                client->rx_message_.is_binary = (opcode == WebSocketOpcode::BINARY);
+                client->message_callback_(client->rx_message_);
             }
-            else
-            {
-                // Default to text for continuation frames or unknown
-                msg.is_binary = false;
-            }
-
-            ESP_LOGD(TAG, "WebSocket message received: %zu bytes, is_binary: %d",
-                     msg.data.size(), msg.is_binary);
-
-            client->message_callback_(msg);
             break;
         }
 
@@ -537,7 +1075,7 @@ void WebSocketClient::websocketEventHandler(struct mg_connection* c, int ev, voi
             if (opcode == 0x0A)  // Pong frame
             {
                 ESP_LOGD(TAG, "WebSocket pong received");
-                client->last_pong_time_ = getCurrentTimestamp();
+                client->onPong(wm->data.ptr, wm->data.len);
             }
             else if (opcode == 0x09)  // Ping frame
             {
@@ -554,6 +1092,11 @@ void WebSocketClient::websocketEventHandler(struct mg_connection* c, int ev, voi
         {
             ESP_LOGI(TAG, "WebSocket connection closed");
 
+            if (client->conn_ == c || client->conn_ == nullptr)
+            {
+                client->cancelInFlightMessages();
+            }
+
             WebSocketState prev_state = client->state_.load();
             client->state_.store(WebSocketState::DISCONNECTED);
             client->conn_ = nullptr;
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "websocket_types.h"
+#include "websocket_send_queue.h"
+#include "websocket_reconnect_policy.h"
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 
@@ -23,18 +26,45 @@ public:
     NetworkResult connect(const WebSocketConfig& config);
     void disconnect();
 
-    NetworkResult sendText(const std::string& message);
-    NetworkResult sendBinary(const std::vector<uint8_t>& data);
-    NetworkResult sendJson(const std::string& json);
+    // Messages go through a bounded priority queue, BUFFER_TOO_SMALL is
+    // returned when the queue rejects the message
+    NetworkResult sendText(const std::string& message,
+                           const WebSocketSendOptions& options = WebSocketSendOptions());
+    NetworkResult sendBinary(const std::vector<uint8_t>& data,
+                             const WebSocketSendOptions& options = WebSocketSendOptions());
+    NetworkResult sendJson(const std::string& json,
+                           const WebSocketSendOptions& options = WebSocketSendOptions());
     NetworkResult ping(const std::string& data = "");
 
     WebSocketState getState() const;
     bool isConnected() const;
 
+    WebSocketQueueMetrics getQueueMetrics() const;
+    WebSocketLinkStats getLinkStats() const;
+
+    /**
+     * @brief Signal that the network changed (new IP, link up/down)
+     * Switches keepalive to fast probing so a dead link is detected quickly
+     */
+    void notifyNetworkChanged();
+
+    /**
+     * @brief Skip the pending backoff and reconnect right away
+     * Meant for "network is back" events. Does nothing unless a reconnection
+     * is pending or in progress; a connect attempt started while the network
+     * was down is aborted and retried.
+     */
+    void reconnectNow();
+
+    // Owning callback: the message is copied out of the receive buffer
     void setMessageCallback(WebSocketMessageCallback callback);
+    // Zero-copy callback, takes precedence over setMessageCallback() when set
+    void setMessageViewCallback(WebSocketMessageViewCallback callback);
     void setStateCallback(WebSocketStateCallback callback);
     void setCloseCallback(WebSocketCloseCallback callback);
     void setErrorCallback(NetworkErrorCallback callback);
+    // Called from the service thread after each RTT sample or lost probe
+    void setLinkStatsCallback(WebSocketLinkStatsCallback callback);
 
     // Callback called before reconnection to get fresh config (e.g., regenerate auth headers)
     using ReconnectConfigCallback = std::function<WebSocketConfig()>;
@@ -54,7 +84,23 @@ private:
     void reconnectThread();
     void destroyManager();
     void scheduleReconnect();
+    void cancelReconnect();
+    void attemptReconnect();
+    NetworkResult openConnection(const WebSocketConfig& config);
+    void startPendingConnection();
+    void checkConnectTimeout();
+    NetworkResult enqueueMessage(WebSocketMessage&& message, const WebSocketSendOptions& options);
     void processOutgoingMessages();
+    void updateKeepalive();
+    void sendProbe(uint64_t now);
+    void onPong(const char* data, size_t len);
+    void recordProbe(bool lost, uint32_t rtt_ms);
+    uint32_t probeTimeoutMs() const;
+    void resetLinkState();
+    void expireOutgoingMessages();
+    void onSendBufferFlushed(size_t bytes);
+    void cancelInFlightMessages();
+    static void runCompletions(WebSocketSendQueue::Completions& done);
 
     struct mg_mgr* mgr_;
     struct mg_connection* conn_;
@@ -62,6 +108,9 @@ private:
     std::atomic<WebSocketState> state_;
     std::atomic<bool> running_;
     std::atomic<bool> should_reconnect_;
+    std::atomic<bool> reconnect_immediately_;
+    std::atomic<bool> abort_connect_;
+    std::atomic<bool> connect_pending_;
 
     std::thread service_thread_;
     std::thread reconnect_thread_;
@@ -69,16 +118,54 @@ private:
     mutable std::mutex config_mutex_;
     mutable std::mutex messages_mutex_;
 
-    WebSocketConfig current_config_;
-    std::queue<WebSocketMessage> outgoing_messages_;
+    // Pending reconnection, guarded by reconnect_mutex_
+    std::mutex reconnect_mutex_;
+    std::condition_variable reconnect_cv_;
+    WebSocketReconnectPolicy reconnect_policy_;
+    uint64_t reconnect_at_ms_;
 
-    uint32_t reconnect_attempts_;
+    WebSocketConfig current_config_;
+    WebSocketSendQueue outgoing_queue_;
+
+    // Messages handed to mongoose, completed once the socket has written
+    // everything up to end_offset (byte offset in the connection stream)
+    struct InFlightMessage
+    {
+        uint64_t end_offset;
+        WebSocketSendCallback on_complete;
+    };
+    std::deque<InFlightMessage> in_flight_;
+    uint64_t send_flushed_total_;
+    uint32_t sent_count_;
+
+    std::atomic<uint64_t> connect_started_ms_;
     uint64_t last_ping_time_;
     uint64_t last_pong_time_;
 
+    // Adaptive keepalive, only touched from the service thread
+    uint32_t probe_seq_;
+    bool probe_outstanding_;
+    uint32_t probe_interval_ms_;
+    uint32_t missed_pongs_;
+    uint64_t last_rx_time_;
+    std::atomic<uint64_t> last_tx_time_;
+    std::atomic<bool> network_changed_;
+    uint16_t loss_history_;     // One bit per recent probe, 1 = lost
+    uint8_t loss_samples_;
+    float srtt_ms_;
+    float rttvar_ms_;
+
+    mutable std::mutex stats_mutex_;
+    WebSocketLinkStats link_stats_;
+
+    // Reused for owning callbacks so its capacity survives across messages
+    WebSocketMessage rx_message_;
+
     WebSocketMessageCallback message_callback_;
+    WebSocketMessageViewCallback message_view_callback_;
     WebSocketStateCallback state_callback_;
     WebSocketCloseCallback close_callback_;
     NetworkErrorCallback error_callback_;
+    WebSocketLinkStatsCallback link_stats_callback_;
     ReconnectConfigCallback reconnect_config_callback_;
 };
\ No newline at end of file
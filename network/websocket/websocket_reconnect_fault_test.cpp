@@ -0,0 +1,270 @@
+// Fault-injection test for WebSocketClient reconnection.
+// Runs a local mongoose WebSocket server that can be stopped, restarted and
+// frozen (accepts TCP but never answers, like a half-dead link), and checks
+// that the client keeps retrying with jittered backoff, reconnects at once
+// on reconnectNow() and recovers from hung connects and dead links.
+//
+// Usage: ws_reconnect_fault_test [port]
+
+#include "websocket_client.h"
+#include "logging.h"
+#include "mongoose.h"
+#include "test_check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Client tuning, scaled down so the whole run takes a few seconds
+static const uint32_t BASE_DELAY_MS = 200;
+static const uint32_t MAX_DELAY_MS = 2000;
+static const uint32_t CONNECT_TIMEOUT_MS = 1500;
+static const uint32_t SLACK_MS = 400;
+
+static uint64_t nowMs()
+{
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+}
+
+static void sleepMs(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+class FaultServer
+{
+public:
+    explicit FaultServer(uint16_t port):
+        url_("ws://127.0.0.1:" + std::to_string(port)),
+        listener_(nullptr),
+        running_(true),
+        listening_(false),
+        frozen_(false)
+    {
+        mg_mgr_init(&mgr_);
+        thread_ = std::thread(&FaultServer::run, this);
+    }
+
+    ~FaultServer()
+    {
+        running_.store(false);
+        thread_.join();
+        mg_mgr_free(&mgr_);
+    }
+
+    // Applied by the server thread on its next poll
+    void start() { listening_.store(true); }
+    void stop() { listening_.store(false); }
+    void freeze(bool frozen) { frozen_.store(frozen); }
+
+    const std::string& url() const { return url_; }
+
+private:
+    static void handler(struct mg_connection* c, int ev, void* ev_data, void*)
+    {
+        if (ev == MG_EV_HTTP_MSG)
+        {
+            mg_ws_upgrade(c, static_cast<struct mg_http_message*>(ev_data), nullptr);
+        }
+        else if (ev == MG_EV_WS_MSG)
+        {
+            struct mg_ws_message* wm = static_cast<struct mg_ws_message*>(ev_data);
+            mg_ws_send(c, wm->data.ptr, wm->data.len, WEBSOCKET_OP_TEXT);
+        }
+    }
+
+    void run()
+    {
+        while (running_.load())
+        {
+            if (frozen_.load())
+            {
+                sleepMs(10);
+                continue;
+            }
+
+            bool want = listening_.load();
+            if (want && !listener_)
+            {
+                listener_ = mg_http_listen(&mgr_, url_.c_str(), handler, nullptr);
+                if (!listener_)
+                {
+                    fprintf(stderr, "Failed to listen on %s\n", url_.c_str());
+                }
+            }
+            else if (!want && listener_)
+            {
+                // Server down: drop the listener and every accepted connection
+                for (struct mg_connection* c = mgr_.conns; c; c = c->next)
+                {
+                    c->is_closing = 1;
+                }
+                listener_ = nullptr;
+            }
+
+            mg_mgr_poll(&mgr_, 10);
+        }
+    }
+
+    std::string url_;
+    struct mg_mgr mgr_;
+    struct mg_connection* listener_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> listening_;
+    std::atomic<bool> frozen_;
+};
+
+// Records state transitions reported by the client
+class StateLog
+{
+public:
+    void record(WebSocketState state)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.push_back({nowMs(), state});
+    }
+
+    // Times of the CONNECTING transitions since 'since'
+    std::vector<uint64_t> attempts(uint64_t since) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<uint64_t> times;
+        for (const auto& entry : entries_)
+        {
+            if (entry.first >= since && entry.second == WebSocketState::CONNECTING)
+            {
+                times.push_back(entry.first);
+            }
+        }
+        return times;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<uint64_t, WebSocketState>> entries_;
+};
+
+static bool waitFor(WebSocketClient& client, bool connected, uint32_t timeout_ms, uint64_t* elapsed_ms = nullptr)
+{
+    uint64_t start = nowMs();
+    while (nowMs() - start < timeout_ms)
+    {
+        if (client.isConnected() == connected)
+        {
+            if (elapsed_ms)
+            {
+                *elapsed_ms = nowMs() - start;
+            }
+            return true;
+        }
+        sleepMs(5);
+    }
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    uint16_t port = argc > 1 ? (uint16_t)atoi(argv[1]) : 18931;
+
+    esp_log_level_set("net.ws", ESP_LOG_NONE);
+    mg_log_set(MG_LL_NONE);
+
+    FaultServer server(port);
+    StateLog log;
+
+    WebSocketClient client;
+    if (client.init() != NetworkResult::OK)
+    {
+        fprintf(stderr, "Failed to init WebSocket client\n");
+        return 1;
+    }
+    client.setStateCallback([&log](WebSocketState state) { log.record(state); });
+
+    WebSocketConfig config;
+    config.url = server.url();
+    config.auto_reconnect = true;
+    config.reconnect_delay_ms = BASE_DELAY_MS;
+    config.max_reconnect_delay_ms = MAX_DELAY_MS;
+    config.max_reconnect_attempts = 0;
+    config.connect_timeout_ms = CONNECT_TIMEOUT_MS;
+    config.ping_interval_ms = 1000;
+    config.min_ping_interval_ms = 300;
+    config.pong_timeout_ms = 600;
+    config.min_pong_timeout_ms = 300;
+    config.max_missed_pongs = 2;
+
+    char detail[128];
+
+    // 1. Plain connection
+    server.start();
+    sleepMs(100);
+    client.connect(config);
+    check(waitFor(client, true, 2000), "initial connect");
+
+    // 2. Server goes away: retries must not give up and stay within the cap
+    uint64_t down_at = nowMs();
+    server.stop();
+    check(waitFor(client, false, 2000), "server stop detected");
+    sleepMs(6000);
+
+    std::vector<uint64_t> attempts = log.attempts(down_at);
+    uint64_t max_gap = 0;
+    for (size_t i = 1; i < attempts.size(); i++)
+    {
+        max_gap = std::max(max_gap, attempts[i] - attempts[i - 1]);
+    }
+    snprintf(detail, sizeof(detail), "(%zu attempts, max gap %llu ms)",
+             attempts.size(), (unsigned long long)max_gap);
+    check(attempts.size() > 3, "keeps retrying past 3 attempts", detail);
+    check(max_gap <= MAX_DELAY_MS + SLACK_MS, "retry interval capped", detail);
+
+    // 3. Server back without a hint: next backoff tick reconnects
+    uint64_t elapsed = 0;
+    server.start();
+    bool ok = waitFor(client, true, MAX_DELAY_MS + 2 * SLACK_MS, &elapsed);
+    snprintf(detail, sizeof(detail), "(%llu ms)", (unsigned long long)elapsed);
+    check(ok, "reconnect on backoff after restart", detail);
+
+    // 4. Network back: reconnectNow() skips the pending backoff
+    server.stop();
+    waitFor(client, false, 2000);
+    sleepMs(5000);
+    server.start();
+    sleepMs(50);
+    client.reconnectNow();
+    ok = waitFor(client, true, SLACK_MS, &elapsed);
+    snprintf(detail, sizeof(detail), "(%llu ms)", (unsigned long long)elapsed);
+    check(ok, "instant reconnect on network up", detail);
+
+    // 5. Frozen server: keepalive declares the link dead, connects hang and
+    // time out, reconnectNow() aborts the hung attempt once it thaws
+    server.freeze(true);
+    ok = waitFor(client, false, 3000, &elapsed);
+    snprintf(detail, sizeof(detail), "(%llu ms)", (unsigned long long)elapsed);
+    check(ok, "dead link detected by keepalive", detail);
+
+    uint64_t frozen_at = nowMs();
+    sleepMs(CONNECT_TIMEOUT_MS + MAX_DELAY_MS + SLACK_MS);
+    attempts = log.attempts(frozen_at);
+    snprintf(detail, sizeof(detail), "(%zu attempts)", attempts.size());
+    check(attempts.size() >= 2, "hung connect times out and retries", detail);
+
+    server.freeze(false);
+    client.reconnectNow();
+    ok = waitFor(client, true, 2 * SLACK_MS, &elapsed);
+    snprintf(detail, sizeof(detail), "(%llu ms)", (unsigned long long)elapsed);
+    check(ok, "reconnect after thaw", detail);
+
+    client.cleanup();
+
+    return testResult();
+}
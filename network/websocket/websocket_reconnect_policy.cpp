@@ -0,0 +1,57 @@
+#include "websocket_reconnect_policy.h"
+#include <algorithm>
+
+#ifdef ESP_PLATFORM
+#include "esp_random.h"
+#endif
+
+static uint32_t randomSeed()
+{
+#ifdef ESP_PLATFORM
+    return esp_random();
+#else
+    std::random_device rd;
+    return rd();
+#endif
+}
+
+WebSocketReconnectPolicy::WebSocketReconnectPolicy():
+    base_delay_ms_(1000),
+    max_delay_ms_(60000),
+    max_attempts_(0),
+    attempts_(0),
+    previous_delay_ms_(0),
+    rng_(randomSeed())
+{
+}
+
+void WebSocketReconnectPolicy::configure(uint32_t base_delay_ms, uint32_t max_delay_ms, uint32_t max_attempts)
+{
+    base_delay_ms_ = std::max<uint32_t>(base_delay_ms, 1);
+    max_delay_ms_ = std::max(max_delay_ms, base_delay_ms_);
+    max_attempts_ = max_attempts;
+}
+
+void WebSocketReconnectPolicy::reset()
+{
+    attempts_ = 0;
+    previous_delay_ms_ = 0;
+}
+
+bool WebSocketReconnectPolicy::next(uint32_t& delay_ms)
+{
+    if (max_attempts_ != 0 && attempts_ >= max_attempts_)
+    {
+        return false;
+    }
+
+    uint64_t previous = previous_delay_ms_ == 0 ? base_delay_ms_ : previous_delay_ms_;
+    uint64_t upper = std::min<uint64_t>(previous * 3, max_delay_ms_);
+
+    std::uniform_int_distribution<uint32_t> dist(base_delay_ms_, static_cast<uint32_t>(upper));
+    delay_ms = dist(rng_);
+
+    previous_delay_ms_ = delay_ms;
+    attempts_++;
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// Reconnection backoff using "decorrelated jitter":
+//   delay = min(max_delay, random(base_delay, previous_delay * 3))
+// Delays grow roughly exponentially but stay spread out, so a fleet of
+// remotes does not hammer the server in lockstep after an outage. Once
+// max_delay is reached attempts keep going at that interval.
+// Not thread-safe: WebSocketClient guards it with its reconnect mutex.
+class WebSocketReconnectPolicy
+{
+public:
+    WebSocketReconnectPolicy();
+
+    // max_attempts == 0 retries forever
+    void configure(uint32_t base_delay_ms, uint32_t max_delay_ms, uint32_t max_attempts);
+
+    // Start again from base_delay, after a successful connection or a network change
+    void reset();
+
+    // Returns false once max_attempts have been used
+    bool next(uint32_t& delay_ms);
+
+    uint32_t attempts() const { return attempts_; }
+    uint32_t maxAttempts() const { return max_attempts_; }
+
+private:
+    uint32_t base_delay_ms_;
+    uint32_t max_delay_ms_;
+    uint32_t max_attempts_;
+    uint32_t attempts_;
+    uint32_t previous_delay_ms_;
+    std::minstd_rand rng_;
+};
@@ -0,0 +1,235 @@
+#include "websocket_send_queue.h"
+#include "logging.h"
+
+static const char *TAG = "net.ws.queue";
+
+WebSocketSendQueue::WebSocketSendQueue():
+    count_(0),
+    bytes_(0),
+    max_messages_(32),
+    max_bytes_(16 * 1024),
+    policy_(WebSocketOverflowPolicy::DROP_OLDEST),
+    dropped_(0),
+    expired_(0),
+    replaced_(0)
+{
+}
+
+void WebSocketSendQueue::setLimits(size_t max_messages, size_t max_bytes, WebSocketOverflowPolicy policy)
+{
+    max_messages_ = max_messages;
+    max_bytes_ = max_bytes;
+    policy_ = policy;
+}
+
+void WebSocketSendQueue::finish(Entry& entry, WebSocketSendResult result, Completions& done)
+{
+    if (entry.on_complete)
+    {
+        done.emplace_back(std::move(entry.on_complete), result);
+    }
+}
+
+bool WebSocketSendQueue::replaceExisting(Entry& entry, Completions& done)
+{
+    if (entry.replace_key.empty())
+    {
+        return false;
+    }
+
+    for (auto& queue : queues_)
+    {
+        for (auto it = queue.begin(); it != queue.end(); ++it)
+        {
+            if (it->replace_key != entry.replace_key)
+            {
+                continue;
+            }
+
+            ESP_LOGD(TAG, "Replacing queued message '%s'", entry.replace_key.c_str());
+            replaced_++;
+            finish(*it, WebSocketSendResult::REPLACED, done);
+
+            // The new payload does not fit in the old one's place: drop the old
+            // entry anyway and let push() make room, a key is never queued twice
+            if (bytes_ - it->message.data.size() + entry.message.data.size() > max_bytes_)
+            {
+                count_--;
+                bytes_ -= it->message.data.size();
+                queue.erase(it);
+                return false;
+            }
+
+            bytes_ -= it->message.data.size();
+            bytes_ += entry.message.data.size();
+
+            // Keep the original slot when priority is unchanged so replacing does
+            // not push a command behind newer traffic
+            if (it->priority == entry.priority)
+            {
+                *it = std::move(entry);
+            }
+            else
+            {
+                queue.erase(it);
+                queues_[static_cast<size_t>(entry.priority)].push_back(std::move(entry));
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool WebSocketSendQueue::makeRoom(const Entry& entry, Completions& done)
+{
+    size_t needed = entry.message.data.size();
+
+    if (needed > max_bytes_)
+    {
+        return false;
+    }
+
+    while (count_ + 1 > max_messages_ || bytes_ + needed > max_bytes_)
+    {
+        if (policy_ != WebSocketOverflowPolicy::DROP_OLDEST)
+        {
+            return false;
+        }
+
+        // Evict the oldest message of the lowest priority not above the new one
+        std::deque<Entry>* victims = nullptr;
+        for (size_t p = 0; p <= static_cast<size_t>(entry.priority); p++)
+        {
+            if (!queues_[p].empty())
+            {
+                victims = &queues_[p];
+                break;
+            }
+        }
+
+        if (!victims)
+        {
+            return false;
+        }
+
+        Entry& victim = victims->front();
+        ESP_LOGW(TAG, "Outgoing queue full, dropping %zu byte message", victim.message.data.size());
+
+        dropped_++;
+        count_--;
+        bytes_ -= victim.message.data.size();
+        finish(victim, WebSocketSendResult::DROPPED, done);
+        victims->pop_front();
+    }
+
+    return true;
+}
+
+bool WebSocketSendQueue::push(Entry&& entry, Completions& done)
+{
+    if (replaceExisting(entry, done))
+    {
+        return true;
+    }
+
+    if (!makeRoom(entry, done))
+    {
+        ESP_LOGW(TAG, "Outgoing queue full, rejecting %zu byte message", entry.message.data.size());
+        dropped_++;
+        finish(entry, WebSocketSendResult::DROPPED, done);
+        return false;
+    }
+
+    count_++;
+    bytes_ += entry.message.data.size();
+    queues_[static_cast<size_t>(entry.priority)].push_back(std::move(entry));
+    return true;
+}
+
+bool WebSocketSendQueue::popNext(uint64_t now, Entry& out, Completions& done)
+{
+    for (size_t p = PRIORITY_COUNT; p-- > 0;)
+    {
+        auto& queue = queues_[p];
+
+        while (!queue.empty())
+        {
+            Entry& entry = queue.front();
+            count_--;
+            bytes_ -= entry.message.data.size();
+
+            if (entry.expires_ms != 0 && now >= entry.expires_ms)
+            {
+                ESP_LOGD(TAG, "Dropping expired message (queued %llu ms)",
+                         (unsigned long long)(now - entry.enqueued_ms));
+                expired_++;
+                finish(entry, WebSocketSendResult::EXPIRED, done);
+                queue.pop_front();
+                continue;
+            }
+
+            out = std::move(entry);
+            queue.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WebSocketSendQueue::expire(uint64_t now, Completions& done)
+{
+    for (auto& queue : queues_)
+    {
+        for (auto it = queue.begin(); it != queue.end();)
+        {
+            if (it->expires_ms != 0 && now >= it->expires_ms)
+            {
+                expired_++;
+                count_--;
+                bytes_ -= it->message.data.size();
+                finish(*it, WebSocketSendResult::EXPIRED, done);
+                it = queue.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+void WebSocketSendQueue::clear(WebSocketSendResult reason, Completions& done)
+{
+    for (auto& queue : queues_)
+    {
+        for (auto& entry : queue)
+        {
+            finish(entry, reason, done);
+        }
+        queue.clear();
+    }
+
+    count_ = 0;
+    bytes_ = 0;
+}
+
+uint64_t WebSocketSendQueue::oldestEnqueuedMs() const
+{
+    uint64_t oldest = 0;
+
+    // In-place replacement refreshes enqueued_ms, so queues are not sorted by age
+    for (const auto& queue : queues_)
+    {
+        for (const auto& entry : queue)
+        {
+            if (oldest == 0 || entry.enqueued_ms < oldest)
+            {
+                oldest = entry.enqueued_ms;
+            }
+        }
+    }
+
+    return oldest;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "websocket_types.h"
+#include <deque>
+#include <vector>
+#include <utility>
+
+// Bounded, prioritized queue of outgoing WebSocket messages.
+// Not thread-safe: WebSocketClient guards it with its messages mutex.
+// Completion callbacks are never invoked here, they are collected into a
+// Completions list so the caller can run them once its lock is released.
+class WebSocketSendQueue
+{
+public:
+    struct Entry
+    {
+        WebSocketMessage message;
+        WebSocketPriority priority;
+        uint64_t enqueued_ms;
+        uint64_t expires_ms;    // 0 means never
+        std::string replace_key;
+        WebSocketSendCallback on_complete;
+
+        Entry() : priority(WebSocketPriority::NORMAL), enqueued_ms(0), expires_ms(0) {}
+    };
+
+    using Completions = std::vector<std::pair<WebSocketSendCallback, WebSocketSendResult>>;
+
+    WebSocketSendQueue();
+
+    void setLimits(size_t max_messages, size_t max_bytes, WebSocketOverflowPolicy policy);
+
+    // Returns false if the entry was rejected (its own callback is added to done)
+    bool push(Entry&& entry, Completions& done);
+
+    // Pops the highest priority, oldest entry that has not expired
+    bool popNext(uint64_t now, Entry& out, Completions& done);
+
+    void expire(uint64_t now, Completions& done);
+    void clear(WebSocketSendResult reason, Completions& done);
+
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+    size_t bytes() const { return bytes_; }
+    uint64_t oldestEnqueuedMs() const;
+
+    uint32_t droppedCount() const { return dropped_; }
+    uint32_t expiredCount() const { return expired_; }
+    uint32_t replacedCount() const { return replaced_; }
+
+private:
+    static const size_t PRIORITY_COUNT = 3;
+
+    // Removes any queued entry with the same replace key, true if entry took its slot
+    bool replaceExisting(Entry& entry, Completions& done);
+    bool makeRoom(const Entry& entry, Completions& done);
+    void finish(Entry& entry, WebSocketSendResult result, Completions& done);
+
+    std::deque<Entry> queues_[PRIORITY_COUNT];
+    size_t count_;
+    size_t bytes_;
+
+    size_t max_messages_;
+    size_t max_bytes_;
+    WebSocketOverflowPolicy policy_;
+
+    uint32_t dropped_;
+    uint32_t expired_;
+    uint32_t replaced_;
+};
@@ -0,0 +1,110 @@
+// Checks WebSocketSendQueue limits and replace keys: in-place replacement,
+// replacement that overflows the byte cap, eviction by priority and
+// rejection under REJECT_NEW.
+//
+// Usage: websocket_send_queue_test
+
+#include "websocket_send_queue.h"
+#include "test_check.h"
+
+#include <stdio.h>
+
+#include <string>
+
+static WebSocketSendQueue::Entry entry(const std::string& data, const std::string& key = "",
+                                       WebSocketPriority priority = WebSocketPriority::NORMAL)
+{
+    WebSocketSendQueue::Entry e;
+    e.message = WebSocketMessage(data);
+    e.replace_key = key;
+    e.priority = priority;
+    return e;
+}
+
+static size_t countKey(WebSocketSendQueue queue, const std::string& key, std::string* last = nullptr)
+{
+    WebSocketSendQueue::Completions done;
+    WebSocketSendQueue::Entry out;
+    size_t count = 0;
+    while (queue.popNext(0, out, done))
+    {
+        if (out.replace_key == key)
+        {
+            count++;
+            if (last)
+            {
+                *last = out.message.data;
+            }
+        }
+    }
+    return count;
+}
+
+int main()
+{
+    WebSocketSendQueue::Completions done;
+
+    // 1. Same key and size: replaced in place
+    {
+        WebSocketSendQueue queue;
+        queue.setLimits(8, 64, WebSocketOverflowPolicy::DROP_OLDEST);
+        queue.push(entry("state=1", "light"), done);
+        queue.push(entry("other"), done);
+        queue.push(entry("state=2", "light"), done);
+
+        std::string last;
+        check(queue.size() == 2 && queue.bytes() == 12, "replace keeps size and bytes");
+        check(countKey(queue, "light", &last) == 1 && last == "state=2", "replace keeps latest value");
+        check(queue.replacedCount() == 1, "replace counted");
+    }
+
+    // 2. Replacement too big for the old slot: old entry goes, new one still queued once
+    {
+        WebSocketSendQueue queue;
+        queue.setLimits(8, 32, WebSocketOverflowPolicy::DROP_OLDEST);
+        done.clear();
+        WebSocketSendQueue::Entry old_value = entry(std::string(10, 'k'), "slider", WebSocketPriority::HIGH);
+        old_value.on_complete = [](WebSocketSendResult) {};
+        queue.push(std::move(old_value), done);
+        queue.push(entry(std::string(10, 'a')), done);
+        queue.push(entry(std::string(10, 'b')), done);
+        bool pushed = queue.push(entry(std::string(20, 'K'), "slider", WebSocketPriority::HIGH), done);
+
+        std::string last;
+        size_t copies = countKey(queue, "slider", &last);
+        char detail[64];
+        snprintf(detail, sizeof(detail), "(%zu copies, %zu bytes)", copies, queue.bytes());
+        check(pushed && copies == 1 && last == std::string(20, 'K'), "overflowing replace queues key once", detail);
+        check(queue.bytes() <= 32, "overflowing replace respects byte cap", detail);
+        check(done.size() == 1 && done[0].second == WebSocketSendResult::REPLACED, "old entry finished as replaced");
+    }
+
+    // 3. Replacement rejected under REJECT_NEW: stale value is not sent either
+    {
+        WebSocketSendQueue queue;
+        queue.setLimits(8, 32, WebSocketOverflowPolicy::REJECT_NEW);
+        done.clear();
+        queue.push(entry(std::string(16, 'a')), done);
+        queue.push(entry(std::string(8, 'k'), "slider"), done);
+        bool pushed = queue.push(entry(std::string(24, 'K'), "slider"), done);
+
+        check(!pushed && countKey(queue, "slider") == 0, "rejected replace drops stale value");
+        check(queue.size() == 1 && queue.bytes() == 16, "rejected replace accounting");
+    }
+
+    // 4. Eviction never takes a higher priority message
+    {
+        WebSocketSendQueue queue;
+        queue.setLimits(2, 1024, WebSocketOverflowPolicy::DROP_OLDEST);
+        done.clear();
+        queue.push(entry("high", "", WebSocketPriority::HIGH), done);
+        queue.push(entry("low", "", WebSocketPriority::LOW), done);
+        queue.push(entry("normal"), done);
+
+        WebSocketSendQueue::Entry out;
+        queue.popNext(0, out, done);
+        check(out.message.data == "high" && queue.droppedCount() == 1, "low priority evicted first");
+    }
+
+    return testResult();
+}
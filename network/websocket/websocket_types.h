@@ -2,6 +2,7 @@
 
 #include "network_types.h"
 #include <string>
+#include <string_view>
 #include <map>
 
 enum class WebSocketState
@@ -41,30 +42,160 @@ struct WebSocketMessage
         : data(binary_data.begin(), binary_data.end()), is_binary(true) {}
 };
 
+enum class WebSocketOpcode : uint8_t
+{
+    CONTINUATION = 0x00,
+    TEXT = 0x01,
+    BINARY = 0x02,
+    CLOSE = 0x08,
+    PING = 0x09,
+    PONG = 0x0A
+};
+
+// Non-owning view on a received message. data points into the connection's
+// receive buffer and is only valid for the duration of the callback; call
+// copy() to keep the message around.
+struct WebSocketMessageView
+{
+    std::string_view data;
+    WebSocketOpcode opcode;
+
+    WebSocketMessageView() : opcode(WebSocketOpcode::TEXT) {}
+    WebSocketMessageView(std::string_view d, WebSocketOpcode op) : data(d), opcode(op) {}
+
+    bool isBinary() const { return opcode == WebSocketOpcode::BINARY; }
+
+    WebSocketMessage copy() const
+    {
+        WebSocketMessage msg;
+        msg.data.assign(data.data(), data.size());
+        msg.is_binary = isBinary();
+        return msg;
+    }
+};
+
+enum class WebSocketPriority : uint8_t
+{
+    LOW = 0,
+    NORMAL = 1,
+    HIGH = 2
+};
+
+// What to do when the outgoing queue is full
+enum class WebSocketOverflowPolicy
+{
+    REJECT_NEW,   // Refuse the new message
+    DROP_OLDEST   // Evict the oldest message of equal or lower priority
+};
+
+enum class WebSocketSendResult
+{
+    SENT,       // Fully written to the socket
+    DROPPED,    // Rejected or evicted because the queue was full
+    EXPIRED,    // TTL elapsed before it could be sent
+    REPLACED,   // Superseded by a newer message with the same replace key
+    CANCELLED   // Connection closed or client cleaned up before it was sent
+};
+
+using WebSocketSendCallback = std::function<void(WebSocketSendResult result)>;
+
+struct WebSocketSendOptions
+{
+    WebSocketPriority priority;
+    uint32_t ttl_ms;              // 0 uses WebSocketConfig::default_message_ttl_ms
+    std::string replace_key;      // A queued message with the same key is replaced
+    WebSocketSendCallback on_complete;
+
+    WebSocketSendOptions()
+        : priority(WebSocketPriority::NORMAL)
+        , ttl_ms(0)
+    {}
+};
+
+struct WebSocketQueueMetrics
+{
+    size_t queued_messages;
+    size_t queued_bytes;
+    uint64_t oldest_age_ms;       // Age of the oldest queued message
+    size_t in_flight_messages;    // Handed to mongoose, not yet written to the socket
+    size_t send_buffer_bytes;     // Current mongoose send buffer fill
+    uint32_t sent;
+    uint32_t dropped;
+    uint32_t expired;
+    uint32_t replaced;
+
+    WebSocketQueueMetrics()
+        : queued_messages(0), queued_bytes(0), oldest_age_ms(0)
+        , in_flight_messages(0), send_buffer_bytes(0)
+        , sent(0), dropped(0), expired(0), replaced(0)
+    {}
+};
+
+// Link quality measured from ping/pong probes
+struct WebSocketLinkStats
+{
+    uint32_t last_rtt_ms;
+    uint32_t smoothed_rtt_ms;     // RFC 6298 style SRTT
+    uint32_t jitter_ms;           // RTT variance (RTTVAR)
+    float loss;                   // Fraction of recent probes without a pong (0..1)
+    uint32_t probes_sent;
+    uint32_t probes_lost;
+    uint32_t probe_interval_ms;   // Current adaptive keepalive interval
+
+    WebSocketLinkStats()
+        : last_rtt_ms(0), smoothed_rtt_ms(0), jitter_ms(0), loss(0.0f)
+        , probes_sent(0), probes_lost(0), probe_interval_ms(0)
+    {}
+};
+
 struct WebSocketConfig
 {
     std::string url;
     std::map<std::string, std::string> headers;
     std::vector<std::string> protocols;
     uint32_t connect_timeout_ms;
-    uint32_t ping_interval_ms;
-    uint32_t pong_timeout_ms;
+    uint32_t ping_interval_ms;      // Keepalive interval when the link is idle and healthy
+    uint32_t pong_timeout_ms;       // Upper bound of the adaptive pong timeout
+    uint32_t min_ping_interval_ms;  // Probe interval after a network event or a missed pong (>= 250 ms)
+    uint32_t min_pong_timeout_ms;   // Lower bound of the adaptive pong timeout
+    uint32_t send_echo_timeout_ms;  // Probe when nothing was received this long after a send
+    uint32_t max_missed_pongs;      // Consecutive lost probes before the link is declared dead
     bool verify_ssl;
     bool auto_reconnect;
-    uint32_t reconnect_delay_ms;
-    uint32_t max_reconnect_attempts;
+    uint32_t reconnect_delay_ms;      // Base delay of the jittered backoff
+    uint32_t max_reconnect_delay_ms;  // Backoff cap, retries continue at this interval
+    uint32_t max_reconnect_attempts;  // 0 retries forever
+
+    // Outgoing queue bounds and backpressure
+    size_t max_queue_messages;
+    size_t max_queue_bytes;
+    size_t max_send_buffer_bytes;   // Stop draining while mongoose holds more than this
+    uint32_t default_message_ttl_ms; // 0 means messages never expire
+    WebSocketOverflowPolicy overflow_policy;
 
     WebSocketConfig()
         : connect_timeout_ms(30000)
         , ping_interval_ms(30000)
         , pong_timeout_ms(10000)
+        , min_ping_interval_ms(2000)
+        , min_pong_timeout_ms(1000)
+        , send_echo_timeout_ms(2000)
+        , max_missed_pongs(2)
         , verify_ssl(true)
         , auto_reconnect(false)
-        , reconnect_delay_ms(5000)
-        , max_reconnect_attempts(3)
+        , reconnect_delay_ms(1000)
+        , max_reconnect_delay_ms(60000)
+        , max_reconnect_attempts(0)
+        , max_queue_messages(32)
+        , max_queue_bytes(16 * 1024)
+        , max_send_buffer_bytes(8 * 1024)
+        , default_message_ttl_ms(0)
+        , overflow_policy(WebSocketOverflowPolicy::DROP_OLDEST)
     {}
 };
 
 using WebSocketMessageCallback = std::function<void(const WebSocketMessage& message)>;
+using WebSocketMessageViewCallback = std::function<void(const WebSocketMessageView& message)>;
 using WebSocketStateCallback = std::function<void(WebSocketState state)>;
+using WebSocketLinkStatsCallback = std::function<void(const WebSocketLinkStats& stats)>;
 using WebSocketCloseCallback = std::function<void(WebSocketCloseReason reason, const std::string& message)>;
\ No newline at end of file
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+Pack the frames of an image sequence into a single LVGL image.
+
+The frames (same size PNG files, in animation order) are stacked vertically
+into one atlas image converted with LVGLImage.py, optionally compressed. The
+generated C file defines the atlas image `<name>_atlas_image` and an
+`image_atlas_t <name>_atlas` (main/image_atlas.h) with the sub-rectangle of
+every frame.
+
+Usage: pack_atlas.py --name light_on --cf RGB565A8 [--compress LZ4]
+                     --output <dir> frame_00.png frame_01.png ...
+"""
+import os
+import sys
+import argparse
+import tempfile
+from os import path
+
+import png
+
+sys.path.insert(0, path.dirname(path.abspath(__file__)))
+from LVGLImage import LVGLImage, ColorFormat, CompressMethod  # noqa: E402
+
+
+def read_rgba(filename):
+    w, h, rows, _ = png.Reader(filename=filename).asRGBA8()
+    return w, h, [bytearray(row) for row in rows]
+
+
+def pack(frames):
+    """Stack the frames vertically, returns the atlas rows and frame rects"""
+    rows = []
+    rects = []
+    frame_w = frame_h = None
+
+    for filename in frames:
+        w, h, frame_rows = read_rgba(filename)
+        if frame_w is None:
+            frame_w, frame_h = w, h
+        elif (w, h) != (frame_w, frame_h):
+            raise ValueError(f"{filename} is {w}x{h}, expected {frame_w}x{frame_h}")
+
+        y = len(rows)
+        rects.append((0, y, w - 1, y + h - 1))
+        rows += frame_rows
+
+    return frame_w, len(rows), rows, rects
+
+
+def atlas_c_code(name, rects):
+    lines = [
+        '',
+        '#include "image_atlas.h"',
+        '',
+        f'static const lv_area_t {name}_atlas_frames[] = {{',
+    ]
+    for x1, y1, x2, y2 in rects:
+        lines.append(f'    {{{x1}, {y1}, {x2}, {y2}}},')
+    lines += [
+        '};',
+        '',
+        f'const image_atlas_t {name}_atlas = {{',
+        f'    .image = &{name}_atlas_image,',
+        f'    .frame_count = {len(rects)},',
+        f'    .frames = {name}_atlas_frames,',
+        '};',
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack image sequence frames into an LVGL atlas image.')
+    parser.add_argument('--name', required=True,
+                        help="sequence name, C symbols are <name>_atlas and <name>_atlas_image")
+    parser.add_argument('--cf', default="RGB565A8",
+                        choices=["ARGB8888", "XRGB8888", "RGB565", "RGB565A8", "RGB888"],
+                        help="color format of the atlas image")
+    parser.add_argument('--compress', default="NONE", choices=["NONE", "RLE", "LZ4"],
+                        help="compression of the atlas image data")
+    parser.add_argument('-o', '--output', default="./output", help="output folder")
+    parser.add_argument('frames', nargs='+', help="PNG frames, in animation order")
+    args = parser.parse_args()
+
+    w, h, rows, rects = pack(args.frames)
+
+    os.makedirs(args.output, exist_ok=True)
+    symbol = f"{args.name}_atlas_image"
+    c_file = path.join(args.output, f"{args.name}_atlas.c")
+
+    # LVGLImage names the C variable after the file
+    with tempfile.TemporaryDirectory() as tmp:
+        png_file = path.join(tmp, f"{symbol}.png")
+        with open(png_file, "wb") as f:
+            png.Writer(w, h, greyscale=False, alpha=True).write(f, rows)
+
+        image_c = path.join(tmp, f"{symbol}.c")
+        LVGLImage().from_png(png_file, ColorFormat[args.cf]).to_c_array(
+            image_c, compress=CompressMethod[args.compress])
+
+        with open(image_c) as f:
+            code = f.read()
+
+    with open(c_file, "w") as f:
+        f.write(code)
+        f.write(atlas_c_code(args.name, rects))
+
+    print(f"packed {len(rects)} frames of {w}x{h // len(rects)} into {c_file}")
+
+
+if __name__ == '__main__':
+    main()
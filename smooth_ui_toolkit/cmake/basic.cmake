@@ -38,4 +38,8 @@ if(SMOOTH_UI_TOOLKIT_BUILD_TEST)
     add_subdirectory(./test/)
     enable_testing()
     add_test(ringbuffer test/ringbuffer_test)
+    add_test(animation_group test/animation_group_test)
+    add_test(fixed_point test/fixed_point_test)
+    add_test(cubic_bezier test/cubic_bezier_test)
+    add_test(event test/event_test)
 endif()
\ No newline at end of file
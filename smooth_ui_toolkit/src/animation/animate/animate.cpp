@@ -199,16 +199,20 @@ KeyFrameGenerator& Animate::get_key_frame_generator()
 {
     if (_generator_dirty || !_key_frame_generator) {
         _key_frame_generator.reset();
-        if (animationType == animation_type::spring) {
-            _key_frame_generator = std::make_unique<Spring>();
-        } else if (animationType == animation_type::easing) {
-            _key_frame_generator = std::make_unique<Easing>();
-        }
+        _key_frame_generator = create_key_frame_generator();
         _generator_dirty = false;
     }
     return *_key_frame_generator;
 }
 
+std::unique_ptr<KeyFrameGenerator> Animate::create_key_frame_generator()
+{
+    if (animationType == animation_type::easing) {
+        return std::make_unique<Easing>();
+    }
+    return std::make_unique<Spring>();
+}
+
 Animate::Animate(Animate&& other) noexcept
     : start(other.start),
       end(other.end),
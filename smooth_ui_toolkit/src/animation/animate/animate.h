@@ -158,11 +158,25 @@ public:
         return _playing_state;
     }
 
+    /**
+     * @brief Is animation waiting to start or playing, i.e. still needs update() calls
+     *
+     * @return true
+     * @return false
+     */
+    inline bool isRunning()
+    {
+        return _playing_state == animate_state::delaying || _playing_state == animate_state::playing ||
+               _playing_state == animate_state::repeat_delaying;
+    }
+
 protected:
     std::function<void(const float&)> _on_update;
     std::function<void()> _on_complete;
     std::unique_ptr<KeyFrameGenerator> _key_frame_generator;
     KeyFrameGenerator& get_key_frame_generator();
+    // Spring or Easing generator for the current animation type, override to use other implementations
+    virtual std::unique_ptr<KeyFrameGenerator> create_key_frame_generator();
     animate_state::State_t _playing_state = animate_state::idle;
     float _start_time = 0.0f;
     float _pause_time = 0.0f;
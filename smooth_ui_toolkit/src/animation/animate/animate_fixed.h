@@ -0,0 +1,42 @@
+/**
+ * @file animate_fixed.h
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "animate.h"
+#include "../generators/spring/spring_fixed.h"
+#include "../generators/easing/easing_fixed.h"
+
+namespace smooth_ui_toolkit {
+
+/**
+ * @brief Animate solved by FixedSpring and FixedEasing, deterministic across platforms
+ *
+ * Same interface as Animate, values are still read as float.
+ * 定点数动画插值
+ *
+ * @tparam Fixed_t fpm::fixed type, see FixedSpring for the value ranges
+ */
+template <typename Fixed_t = fpm::fixed_16_16>
+class FixedAnimate : public Animate {
+public:
+    FixedAnimate() {}
+    ~FixedAnimate() {}
+
+protected:
+    std::unique_ptr<KeyFrameGenerator> create_key_frame_generator() override
+    {
+        if (animationType == animation_type::easing) {
+            return std::make_unique<FixedEasing<Fixed_t>>();
+        }
+        return std::make_unique<FixedSpring<Fixed_t>>();
+    }
+};
+
+} // namespace smooth_ui_toolkit
@@ -0,0 +1,355 @@
+/**
+ * @file animation_group.cpp
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "animation_group.h"
+#include "utils/hal/hal.h"
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+using namespace smooth_ui_toolkit;
+
+AnimationGroup::Id AnimationGroup::add(float value)
+{
+    Id id;
+    if (!_free_ids.empty()) {
+        id = _free_ids.back();
+        _free_ids.pop_back();
+        _members[id] = Member_t();
+    } else {
+        id = _members.size();
+        _members.emplace_back();
+    }
+
+    Member_t& member = _members[id];
+    member.alive = true;
+    member.lane = _lane_id.size();
+    member.notifiedValue = value;
+    resolve_spring(member, SpringOptions_t());
+
+    // New lanes are at rest, after the running ones
+    _start_time.push_back(0.0f);
+    _end.push_back(value);
+    _c1.push_back(0.0f);
+    _c2.push_back(0.0f);
+    _zw.push_back(0.0f);
+    _wd.push_back(0.0f);
+    _value.push_back(value);
+    _velocity.push_back(0.0f);
+    _rest_speed.push_back(member.restSpeed);
+    _rest_delta.push_back(member.restDelta);
+    _type.push_back(lane_underdamped);
+    _lane_id.push_back(id);
+
+    return id;
+}
+
+void AnimationGroup::remove(Id id)
+{
+    Member_t& member = _members[id];
+    if (!member.alive) {
+        return;
+    }
+
+    stop_lane(member.lane);
+    swap_lanes(member.lane, _lane_id.size() - 1);
+
+    _start_time.pop_back();
+    _end.pop_back();
+    _c1.pop_back();
+    _c2.pop_back();
+    _zw.pop_back();
+    _wd.pop_back();
+    _value.pop_back();
+    _velocity.pop_back();
+    _rest_speed.pop_back();
+    _rest_delta.pop_back();
+    _type.pop_back();
+    _lane_id.pop_back();
+
+    member = Member_t();
+    _free_ids.push_back(id);
+}
+
+void AnimationGroup::setSpringOptions(Id id, const SpringOptions_t& options)
+{
+    Member_t& member = _members[id];
+    member.animationType = animation_type::spring;
+    resolve_spring(member, options);
+    _rest_speed[member.lane] = member.restSpeed;
+    _rest_delta[member.lane] = member.restDelta;
+}
+
+void AnimationGroup::setEasingOptions(Id id, const EasingOptions_t& options)
+{
+    Member_t& member = _members[id];
+    member.animationType = animation_type::easing;
+    member.duration = options.duration;
+    member.easingFunction = options.easingFunction;
+}
+
+void AnimationGroup::onUpdate(Id id, std::function<void(const float&)> callback)
+{
+    _members[id].onUpdate = callback;
+}
+
+void AnimationGroup::teleport(Id id, float newValue)
+{
+    uint32_t lane = _members[id].lane;
+    stop_lane(lane);
+    lane = _members[id].lane;
+    _end[lane] = newValue;
+    _value[lane] = newValue;
+    _velocity[lane] = 0.0f;
+    mark_changed(id);
+}
+
+void AnimationGroup::move(Id id, float newValue)
+{
+    uint32_t lane = _members[id].lane;
+    // Same as AnimateValue::move(), moving to the current target does nothing
+    if (newValue == _end[lane]) {
+        return;
+    }
+    retarget(id, _value[lane], newValue);
+}
+
+void AnimationGroup::retarget(Id id, float start, float end)
+{
+    const Member_t& member = _members[id];
+    uint32_t lane = member.lane;
+
+    _start_time[lane] = ui_hal::get_tick_s();
+    _end[lane] = end;
+    _value[lane] = start;
+
+    if (member.animationType == animation_type::easing) {
+        _type[lane] = lane_easing;
+        _c1[lane] = start;
+        _c2[lane] = end - start;
+        _zw[lane] = 0.0f;
+        _wd[lane] = 1.0f / member.duration;
+    } else {
+        // Same coefficients as Spring::retarget(), which keeps the current velocity
+        float velocity = -_velocity[lane];
+        float delta = end - start;
+        float w0 = member.undampedAngularFreq;
+        float zeta = member.dampingRatio;
+
+        _zw[lane] = zeta * w0;
+        if (zeta < 1) {
+            _type[lane] = lane_underdamped;
+            _wd[lane] = w0 * std::sqrt(1 - zeta * zeta);
+            _c1[lane] = (velocity + zeta * w0 * delta) / _wd[lane];
+            _c2[lane] = delta;
+        } else if (zeta == 1) {
+            _type[lane] = lane_critical;
+            _wd[lane] = 0.0f;
+            _c1[lane] = velocity + w0 * delta;
+            _c2[lane] = delta;
+        } else {
+            _type[lane] = lane_overdamped;
+            _wd[lane] = w0 * std::sqrt(zeta * zeta - 1);
+            _c1[lane] = (velocity + zeta * w0 * delta) / _wd[lane];
+            _c2[lane] = _wd[lane] * delta;
+        }
+    }
+
+    start_lane(lane);
+    mark_changed(id);
+}
+
+float AnimationGroup::value(Id id) const
+{
+    return _value[_members[id].lane];
+}
+
+float AnimationGroup::target(Id id) const
+{
+    return _end[_members[id].lane];
+}
+
+bool AnimationGroup::done(Id id) const
+{
+    return _members[id].lane >= _running_count;
+}
+
+void AnimationGroup::update()
+{
+    update(ui_hal::get_tick_s());
+}
+
+void AnimationGroup::update(const float& currentTime)
+{
+    const size_t running_count = _running_count;
+    const float* start_time = _start_time.data();
+    const float* end = _end.data();
+    const float* c1 = _c1.data();
+    const float* c2 = _c2.data();
+    const float* zw = _zw.data();
+    const float* wd = _wd.data();
+    float* value = _value.data();
+    float* velocity = _velocity.data();
+
+    // Underdamped spring for every running lane, no branch nor call but exp/sin/cos, computed once for both position
+    // and velocity. Other lanes are solved again below
+    for (size_t i = 0; i < running_count; i++) {
+        float t = currentTime - start_time[i];
+        float envelope = std::exp(-zw[i] * t);
+        float sin_term = std::sin(wd[i] * t);
+        float cos_term = std::cos(wd[i] * t);
+        float position_term = c1[i] * sin_term + c2[i] * cos_term;
+        value[i] = end[i] - envelope * position_term;
+        velocity[i] = envelope * (zw[i] * position_term - wd[i] * (c1[i] * cos_term - c2[i] * sin_term));
+    }
+
+    // Other lane types and rest checks, settled lanes leave the running range
+    uint32_t lane = 0;
+    while (lane < _running_count) {
+        float t = currentTime - _start_time[lane];
+        bool at_rest;
+        if (_type[lane] == lane_easing) {
+            solve_scalar(lane, t);
+            at_rest = t * _wd[lane] >= 1.0f;
+        } else {
+            if (_type[lane] != lane_underdamped) {
+                solve_scalar(lane, t);
+            }
+            at_rest = std::abs(_velocity[lane]) <= _rest_speed[lane] &&
+                      std::abs(_end[lane] - _value[lane]) <= _rest_delta[lane];
+        }
+
+        mark_changed(_lane_id[lane]);
+        if (at_rest) {
+            stop_lane(lane);
+        } else {
+            lane++;
+        }
+    }
+
+    // Callbacks last, they may move members
+    _notifying_ids.swap(_changed_ids);
+    for (Id id : _notifying_ids) {
+        Member_t& member = _members[id];
+        member.notify = false;
+        if (!member.alive) {
+            continue;
+        }
+        float current_value = _value[member.lane];
+        if (current_value == member.notifiedValue) {
+            continue;
+        }
+        member.notifiedValue = current_value;
+        if (member.onUpdate) {
+            auto callback = member.onUpdate;
+            callback(current_value);
+        }
+    }
+    _notifying_ids.clear();
+}
+
+void AnimationGroup::swap_lanes(uint32_t a, uint32_t b)
+{
+    if (a == b) {
+        return;
+    }
+    std::swap(_start_time[a], _start_time[b]);
+    std::swap(_end[a], _end[b]);
+    std::swap(_c1[a], _c1[b]);
+    std::swap(_c2[a], _c2[b]);
+    std::swap(_zw[a], _zw[b]);
+    std::swap(_wd[a], _wd[b]);
+    std::swap(_value[a], _value[b]);
+    std::swap(_velocity[a], _velocity[b]);
+    std::swap(_rest_speed[a], _rest_speed[b]);
+    std::swap(_rest_delta[a], _rest_delta[b]);
+    std::swap(_type[a], _type[b]);
+    std::swap(_lane_id[a], _lane_id[b]);
+    _members[_lane_id[a]].lane = a;
+    _members[_lane_id[b]].lane = b;
+}
+
+void AnimationGroup::start_lane(uint32_t lane)
+{
+    if (lane >= _running_count) {
+        swap_lanes(lane, _running_count);
+        _running_count++;
+    }
+}
+
+void AnimationGroup::stop_lane(uint32_t lane)
+{
+    if (lane < _running_count) {
+        _running_count--;
+        swap_lanes(lane, _running_count);
+    }
+}
+
+void AnimationGroup::solve_scalar(uint32_t lane, float t)
+{
+    // Same formulas as Spring::calc_position(), Spring::calc_velocity_analytical() and Easing::next()
+    switch (_type[lane]) {
+        case lane_critical: {
+            float w0 = _zw[lane];
+            float envelope = std::exp(-w0 * t);
+            _value[lane] = _end[lane] - envelope * (_c2[lane] + _c1[lane] * t);
+            _velocity[lane] = envelope * (w0 * (_c2[lane] + _c1[lane] * t) - _c1[lane]);
+            break;
+        }
+        case lane_overdamped: {
+            float envelope = std::exp(-_zw[lane] * t);
+            float freq_for_t = std::min(_wd[lane] * t, 300.0f);
+            float sinh_term = std::sinh(freq_for_t);
+            float cosh_term = std::cosh(freq_for_t);
+            _value[lane] = _end[lane] - (envelope * (_c1[lane] * sinh_term + _c2[lane] * cosh_term)) / _wd[lane];
+            _velocity[lane] = envelope * ((_zw[lane] * (_c1[lane] * sinh_term + _c2[lane] * cosh_term)) / _wd[lane] -
+                                          (_c1[lane] * cosh_term + _c2[lane] * sinh_term));
+            break;
+        }
+        case lane_easing: {
+            float progress = t * _wd[lane];
+            if (progress >= 1.0f) {
+                _value[lane] = _end[lane];
+            } else {
+                const auto& easing_function = _members[_lane_id[lane]].easingFunction;
+                _value[lane] = _c1[lane] + _c2[lane] * easing_function(progress);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void AnimationGroup::mark_changed(Id id)
+{
+    Member_t& member = _members[id];
+    if (!member.notify) {
+        member.notify = true;
+        _changed_ids.push_back(id);
+    }
+}
+
+void AnimationGroup::resolve_spring(Member_t& member, const SpringOptions_t& options)
+{
+    // Duration and bounce based options are converted like Spring::init() does
+    Spring spring;
+    spring.springOptions = options;
+    if (options.duration > 0 || options.visualDuration > 0) {
+        spring.setSpringOptions(options.duration, options.bounce, options.visualDuration);
+    }
+
+    const SpringOptions_t& resolved = spring.springOptions;
+    float sqrt_stiffness_mass = std::sqrt(resolved.stiffness * resolved.mass);
+    member.undampedAngularFreq = sqrt_stiffness_mass / resolved.mass;
+    member.dampingRatio = resolved.damping / (2 * sqrt_stiffness_mass);
+    member.restSpeed = resolved.restSpeed;
+    member.restDelta = resolved.restDelta;
+}
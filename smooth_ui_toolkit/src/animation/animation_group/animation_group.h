@@ -0,0 +1,220 @@
+/**
+ * @file animation_group.h
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "../generators/generators.h"
+#include "../generators/spring/spring.h"
+#include "../generators/easing/easing.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace smooth_ui_toolkit {
+
+/**
+ * @brief Batch of animated values solved together
+ *
+ * Each member moves like an AnimateValue (same spring and easing curves, retarget keeps the spring velocity), but the
+ * solver state of all members is stored as structure of arrays and advanced in one loop with a shared timestamp,
+ * instead of one Animate and one virtual KeyFrameGenerator per value. Running members are kept packed at the front of
+ * the arrays, so settled members cost nothing. The underdamped spring, the usual case, is solved in a branch free loop
+ * evaluating exp/sin/cos once per member for both position and velocity; critically damped, overdamped and easing
+ * members are then solved one by one.
+ * 批量动画值，结构数组存储，所有成员使用同一时间戳在一个循环中更新
+ *
+ * Delay and repeat are not supported. Update callbacks are invoked at the end of update(), only for members whose
+ * value changed, so they may call move() or teleport().
+ */
+class AnimationGroup {
+public:
+    using Id = uint32_t;
+    static constexpr Id INVALID_ID = UINT32_MAX;
+
+    AnimationGroup() {}
+    ~AnimationGroup() {}
+
+    // Disable copy constructor and copy assignment operator
+    AnimationGroup(const AnimationGroup&) = delete;
+    AnimationGroup& operator=(const AnimationGroup&) = delete;
+
+    /**
+     * @brief Add a member at rest on a value, animated by a default spring
+     *
+     * @param value
+     * @return Id
+     */
+    Id add(float value = 0.0f);
+
+    /**
+     * @brief Remove a member, its id may be returned again by add()
+     *
+     * @param id
+     */
+    void remove(Id id);
+
+    /**
+     * @brief Animate a member by a spring, used from the next move()
+     *
+     * @param id
+     * @param options
+     */
+    void setSpringOptions(Id id, const SpringOptions_t& options);
+
+    /**
+     * @brief Animate a member by an easing, used from the next move()
+     *
+     * @param id
+     * @param options
+     */
+    void setEasingOptions(Id id, const EasingOptions_t& options);
+
+    /**
+     * @brief Value update callback of a member
+     *
+     * @param id
+     * @param callback
+     */
+    void onUpdate(Id id, std::function<void(const float&)> callback);
+
+    /**
+     * @brief Set a member to a new value immediately
+     *
+     * @param id
+     * @param newValue
+     */
+    void teleport(Id id, float newValue);
+
+    /**
+     * @brief Move a member to a new value from its current value and velocity
+     *
+     * @param id
+     * @param newValue
+     */
+    void move(Id id, float newValue);
+
+    /**
+     * @brief Move a member from a start value to an end value, like Animate::retarget()
+     *
+     * @param id
+     * @param start
+     * @param end
+     */
+    void retarget(Id id, float start, float end);
+
+    /**
+     * @brief Current value of a member, as of the last update()
+     *
+     * @param id
+     * @return float
+     */
+    float value(Id id) const;
+
+    /**
+     * @brief Value a member is moving to
+     *
+     * @param id
+     * @return float
+     */
+    float target(Id id) const;
+
+    /**
+     * @brief Is a member at rest
+     *
+     * @param id
+     * @return true
+     * @return false
+     */
+    bool done(Id id) const;
+
+    /**
+     * @brief Update all running members, keep calling this method to update animations
+     *
+     */
+    void update();
+
+    /**
+     * @brief Update all running members with explicit current time
+     *
+     * @param currentTime Current time in seconds
+     */
+    void update(const float& currentTime);
+
+    /**
+     * @brief Number of members
+     *
+     * @return size_t
+     */
+    inline size_t size() const
+    {
+        return _lane_id.size();
+    }
+
+    /**
+     * @brief Number of members still moving
+     *
+     * @return size_t
+     */
+    inline size_t runningCount() const
+    {
+        return _running_count;
+    }
+
+protected:
+    enum LaneType_t : uint8_t {
+        lane_underdamped = 0,
+        lane_critical,
+        lane_overdamped,
+        lane_easing,
+    };
+
+    // Per member data, indexed by id
+    struct Member_t {
+        uint32_t lane = 0;
+        bool alive = false;
+        bool notify = false;
+        animation_type::Type_t animationType = animation_type::spring;
+        float undampedAngularFreq = 0.0f;
+        float dampingRatio = 0.0f;
+        float restSpeed = 0.1f;
+        float restDelta = 0.1f;
+        float duration = 1.0f;
+        std::function<float(float)> easingFunction;
+        std::function<void(const float&)> onUpdate;
+        float notifiedValue = 0.0f;
+    };
+    std::vector<Member_t> _members;
+    std::vector<Id> _free_ids;
+    std::vector<Id> _changed_ids;
+
+    // Solver state, indexed by lane, running lanes first
+    std::vector<float> _start_time;
+    std::vector<float> _end;
+    std::vector<float> _c1;     // Spring: velocity coefficient, easing: start value
+    std::vector<float> _c2;     // Spring: position coefficient, easing: range
+    std::vector<float> _zw;     // Spring: damping ratio * undamped angular frequency
+    std::vector<float> _wd;     // Spring: damped angular frequency, easing: inverse duration
+    std::vector<float> _value;
+    std::vector<float> _velocity;
+    std::vector<float> _rest_speed;
+    std::vector<float> _rest_delta;
+    std::vector<uint8_t> _type;
+    std::vector<Id> _lane_id;
+    size_t _running_count = 0;
+    std::vector<Id> _notifying_ids;
+
+    void swap_lanes(uint32_t a, uint32_t b);
+    void start_lane(uint32_t lane);
+    void stop_lane(uint32_t lane);
+    void solve_scalar(uint32_t lane, float t);
+    void mark_changed(Id id);
+    static void resolve_spring(Member_t& member, const SpringOptions_t& options);
+};
+
+} // namespace smooth_ui_toolkit
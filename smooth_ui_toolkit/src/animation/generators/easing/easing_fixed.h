@@ -0,0 +1,96 @@
+/**
+ * @file easing_fixed.h
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "easing.h"
+#include "../../../utils/fpm/fixed.hpp"
+
+namespace smooth_ui_toolkit {
+
+/**
+ * @brief Easing interpolated in fixed-point, same options and curves as Easing
+ *
+ * Progress and interpolation run in Fixed_t (an fpm::fixed type), the easing function is sampled on the fixed-point
+ * progress and its result rounded to Fixed_t, which absorbs last bit float differences of the easing function across
+ * platforms (trig based curves like sine and elastic may still differ by one step). Values follow Easing within one
+ * Fixed_t step per unit of move distance.
+ * 定点数 easing
+ *
+ * @tparam Fixed_t
+ */
+template <typename Fixed_t = fpm::fixed_16_16>
+class FixedEasing : public Easing {
+public:
+    FixedEasing() {}
+    ~FixedEasing() {}
+
+    virtual void init() override
+    {
+        done = false;
+        value = start;
+        _inv_duration = Fixed_t(1) / Fixed_t(easingOptions.duration);
+        set_range();
+        _value = _start;
+    }
+
+    virtual void retarget(const float& start, const float& end) override
+    {
+        this->start = start;
+        this->end = end;
+        set_range();
+        done = false;
+    }
+
+    virtual bool next(const float& t) override
+    {
+        if (done) {
+            return done;
+        }
+
+        Fixed_t progress = Fixed_t(t) * _inv_duration;
+        if (progress >= Fixed_t(1)) {
+            _value = _end;
+            value = end;
+            done = true;
+            return done;
+        }
+
+        Fixed_t eased = Fixed_t(easingOptions.easingFunction(static_cast<float>(progress)));
+        _value = _start + _range * eased;
+        value = static_cast<float>(_value);
+        return done;
+    }
+
+    /**
+     * @brief Current value in fixed-point
+     *
+     * @return Fixed_t
+     */
+    inline Fixed_t fixedValue() const
+    {
+        return _value;
+    }
+
+protected:
+    Fixed_t _start{0};
+    Fixed_t _end{0};
+    Fixed_t _range{0};
+    Fixed_t _value{0};
+    Fixed_t _inv_duration{1};
+
+    void set_range()
+    {
+        _start = Fixed_t(start);
+        _end = Fixed_t(end);
+        _range = _end - _start;
+    }
+};
+
+} // namespace smooth_ui_toolkit
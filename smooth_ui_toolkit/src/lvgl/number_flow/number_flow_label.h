@@ -0,0 +1,638 @@
+/**
+ * @file number_flow_label.h
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+// Refs: https://number-flow.barvian.me
+#pragma once
+#include "../lvgl_cpp/obj.h"
+#include "../../animation/animate_value/animate_value.h"
+#include "../../utils/hal/hal.h"
+#include "digit_flow.h"
+#include <lvgl.h>
+#include <vector>
+#include <memory>
+#include <array>
+#include <optional>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace smooth_ui_toolkit {
+namespace lvgl_cpp {
+
+/**
+ * @brief NumberFlow drawn by a single object
+ *
+ * Same API and animations as NumberFlow, but the digit strips, sign, prefix and suffix are not child objects: their
+ * springs live in this object and are stepped together in update(), and every glyph is drawn from the draw callback
+ * of this object. The object is only invalidated while a spring is running.
+ * 同 NumberFlow 的接口和动画，但只有一个 lvgl 对象，所有字形都在其绘制回调中绘制
+ */
+class NumberFlowLabel : public Widget<lv_obj_create> {
+public:
+    using Widget::Widget;
+
+    // no copy constructor and copy assignment operator
+    NumberFlowLabel(const NumberFlowLabel&) = delete;
+    NumberFlowLabel& operator=(const NumberFlowLabel&) = delete;
+
+    struct Item_t {
+        AnimateValue positionX;
+        AnimateValue opacity;
+        bool isGoingDestroy = false;
+    };
+
+    struct Digit_t : public Item_t {
+        // Scroll offset of the digit strip, same as DigitFlow
+        AnimateValue offsetY;
+        size_t index = 1;
+    };
+
+    struct Text_t : public Item_t {
+        std::string text;
+        int width = 0;
+    };
+
+    // 动画类型，默认 spring 更自然
+    animation_type::Type_t animationType = animation_type::spring;
+    // 透明背景
+    bool transparentBg = true;
+    // 显示正负号
+    bool showPositiveSign = false;
+    // 最小显示位数，不足时前导补0
+    int minDigits = 0;
+
+    void init()
+    {
+        // Mask basic
+        setPadding(0, 0, 0, 0);
+        removeFlag(LV_OBJ_FLAG_SCROLLABLE);
+        if (transparentBg) {
+            setOutlineWidth(0);
+            setBorderWidth(0);
+            setBgOpa(LV_OPA_TRANSP);
+        }
+
+        if (!_is_inited) {
+            _is_inited = true;
+            addEventCb(event_cb, LV_EVENT_DRAW_MAIN, this);
+            addEventCb(event_cb, LV_EVENT_GET_SELF_SIZE, this);
+        }
+
+        // Font height
+        _font_height = lv_font_get_line_height(getTextFont());
+        _font_width = lv_font_get_glyph_width(getTextFont(), '0', '0');
+        setSize(LV_SIZE_CONTENT, _font_height);
+
+        setValue(_current_number);
+    }
+
+    // 设置前缀
+    void setPrefix(const std::string& newPrefix)
+    {
+        _prefix = newPrefix;
+        handle_prefix_changed();
+    }
+
+    // 设置后缀
+    void setSuffix(const std::string& newSuffix)
+    {
+        _suffix = newSuffix;
+        handle_suffix_changed();
+    }
+
+    // 设置前缀颜色
+    void setPrefixColor(lv_color_t color)
+    {
+        _prefix_color = color;
+        invalidate();
+    }
+
+    // 设置后缀颜色
+    void setSuffixColor(lv_color_t color)
+    {
+        _suffix_color = color;
+        invalidate();
+    }
+
+    // 设置数字颜色，前缀后缀未设置颜色时也使用此颜色
+    void setDigitColor(lv_color_t color)
+    {
+        Widget::setTextColor(color);
+    }
+
+    void update()
+    {
+        if (!_is_inited) {
+            init();
+        }
+
+        // One clock read for every spring
+        const float now = ui_hal::get_tick_s();
+        bool running = false;
+
+        for (auto& digit : _digits) {
+            running |= update_item(digit, now);
+            digit.offsetY.update(now);
+            running |= digit.offsetY.isRunning();
+        }
+        _digits.erase(std::remove_if(_digits.begin(),
+                                     _digits.end(),
+                                     [](Digit_t& digit) {
+                                         return digit.isGoingDestroy && digit.positionX.done() &&
+                                                digit.opacity.done();
+                                     }),
+                      _digits.end());
+
+        for (auto* text : {&_text_prefix, &_text_sign, &_text_point, &_text_suffix}) {
+            if (*text) {
+                running |= update_item(**text, now);
+                if ((*text)->isGoingDestroy && (*text)->positionX.done() && (*text)->opacity.done()) {
+                    text->reset();
+                }
+            }
+        }
+
+        // Settled values are drawn once more after the last running update
+        if (running || _is_dirty) {
+            update_content_width();
+            invalidate();
+        }
+        _is_dirty = running;
+    }
+
+    int value()
+    {
+        return _current_number;
+    }
+
+    // 获取控件总宽度的便利方法
+    int getTotalWidth()
+    {
+        update_prefix_width_cache();
+        update_suffix_width_cache();
+        return _cached_prefix_width + get_sign_width() + get_digits_width() + _cached_suffix_width;
+    }
+
+    void setValue(int targetValue)
+    {
+        _current_number = targetValue;
+        handle_prefix_changed();
+        handle_sign_changed();
+        handle_digit_changed();
+        handle_point_changed();
+        handle_suffix_changed();
+        handle_digit_number_changed();
+        _is_dirty = true;
+    }
+
+protected:
+    // Same strip as DigitFlow
+    static inline constexpr std::array<const char*, 12> _digit_texts = {
+        "9", "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "0"};
+
+    bool _is_inited = false;
+    bool _is_dirty = false;
+    int32_t _font_height = 0;
+    int32_t _font_width = 0;
+    int32_t _content_width = 0;
+    int _last_number = 0;
+    int _current_number = 0;
+    int _current_number_of_digits = 1;
+    // Digits after the decimal point, the value is then a fixed point number
+    int _decimal_places = 0;
+    std::vector<Digit_t> _digits;
+    std::unique_ptr<Text_t> _text_sign;
+    std::unique_ptr<Text_t> _text_point;
+    std::unique_ptr<Text_t> _text_prefix;
+    std::unique_ptr<Text_t> _text_suffix;
+    std::string _prefix = "";
+    std::string _suffix = "";
+    std::optional<lv_color_t> _prefix_color;
+    std::optional<lv_color_t> _suffix_color;
+
+    int _cached_prefix_width = 0;
+    int _cached_suffix_width = 0;
+
+    void invalidate()
+    {
+        lv_obj_invalidate(this->raw_ptr());
+    }
+
+    static bool update_item(Item_t& item, float now)
+    {
+        item.positionX.update(now);
+        item.opacity.update(now);
+        return item.positionX.isRunning() || item.opacity.isRunning();
+    }
+
+    int get_actual_digits(int num)
+    {
+        if (num == 0) {
+            return 1;
+        }
+        int count = 0;
+        int temp = std::abs(num);
+        while (temp != 0) {
+            temp /= 10;
+            count++;
+        }
+        return count;
+    }
+
+    int get_number_of_digits(int num)
+    {
+        return std::max({get_actual_digits(num), minDigits, _decimal_places + 1});
+    }
+
+    int get_text_width(const std::string& text)
+    {
+        // UTF-8 aware, suffixes like "°C" are not ASCII
+        lv_point_t size;
+        lv_text_get_size(&size, text.c_str(), getTextFont(), 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+        return size.x;
+    }
+
+    int get_sign_width()
+    {
+        if (_text_sign && !_text_sign->isGoingDestroy) {
+            return _text_sign->width;
+        }
+        return 0;
+    }
+
+    int get_point_width()
+    {
+        return _decimal_places > 0 ? get_text_width(".") : 0;
+    }
+
+    int get_digits_width()
+    {
+        return _current_number_of_digits * _font_width + get_point_width();
+    }
+
+    // Digits after the decimal point are shifted by its width
+    int get_digit_x(int index, int numberOfDigits)
+    {
+        int x = _cached_prefix_width + get_sign_width() + index * _font_width;
+        if (_decimal_places > 0 && index >= numberOfDigits - _decimal_places) {
+            x += get_point_width();
+        }
+        return x;
+    }
+
+    void update_prefix_width_cache()
+    {
+        _cached_prefix_width = (_text_prefix && !_text_prefix->isGoingDestroy) ? _text_prefix->width : 0;
+    }
+
+    void update_suffix_width_cache()
+    {
+        _cached_suffix_width = (_text_suffix && !_text_suffix->isGoingDestroy) ? _text_suffix->width : 0;
+    }
+
+    void update_content_width()
+    {
+        // Same as the content size of NumberFlow, where every item is a child
+        float width = 0;
+        auto extend = [&](Item_t& item, int itemWidth) {
+            width = std::max(width, item.positionX.directValue() + itemWidth);
+        };
+        for (auto& digit : _digits) {
+            extend(digit, _font_width);
+        }
+        for (auto* text : {&_text_prefix, &_text_sign, &_text_point, &_text_suffix}) {
+            if (*text) {
+                extend(**text, (*text)->width);
+            }
+        }
+
+        int32_t content_width = std::ceil(width);
+        if (content_width != _content_width) {
+            _content_width = content_width;
+            lv_obj_refresh_self_size(this->raw_ptr());
+        }
+    }
+
+    void digit_increase(Digit_t& digit)
+    {
+        if (digit.index >= _digit_texts.size() - 2) {
+            digit.index = 1;
+            digit.offsetY.retarget(0, 1 * _font_height);
+        } else {
+            digit.index++;
+            digit.offsetY = digit.index * _font_height;
+        }
+    }
+
+    void digit_decrease(Digit_t& digit)
+    {
+        if (digit.index <= 1) {
+            digit.index = _digit_texts.size() - 2;
+            digit.offsetY.retarget((_digit_texts.size() - 1) * _font_height, digit.index * _font_height);
+        } else {
+            digit.index--;
+            digit.offsetY = digit.index * _font_height;
+        }
+    }
+
+    static int digit_value(const Digit_t& digit)
+    {
+        return _digit_texts[digit.index][0] - '0';
+    }
+
+    void handle_digit_changed()
+    {
+        auto new_number_of_digits = get_number_of_digits(_current_number);
+        int digit_list_size = _digits.size();
+
+        // Add digits
+        if (new_number_of_digits > digit_list_size) {
+            while (new_number_of_digits > digit_list_size) {
+                _digits.emplace_back();
+                auto& digit = _digits.back();
+                DigitFlow::setup_animation(digit.offsetY, animationType);
+                digit.offsetY = digit.index * _font_height;
+                DigitFlow::setup_animation(digit.positionX, animationType);
+                if (digit_list_size != 0) {
+                    digit.positionX.teleport((_current_number_of_digits - 1) * _font_width);
+                }
+                digit.positionX.move(digit_list_size * _font_width);
+                DigitFlow::setup_animation(digit.opacity, animationType);
+                digit.opacity.move(255);
+                digit_list_size++;
+            }
+        }
+
+        // Remove digits
+        else if ((new_number_of_digits < digit_list_size) && (new_number_of_digits < _current_number_of_digits)) {
+            // move extra digits back to the last one, and mark destroy
+            for (int i = new_number_of_digits; i < digit_list_size; i++) {
+                _digits[i].positionX.move(get_digit_x(new_number_of_digits - 1, new_number_of_digits));
+                _digits[i].opacity = 0;
+                _digits[i].opacity.move(0);
+                _digits[i].isGoingDestroy = true;
+            }
+        }
+
+        // Reorder digits
+        update_prefix_width_cache();
+        for (int i = 0; i < new_number_of_digits; i++) {
+            _digits[i].positionX.move(get_digit_x(i, new_number_of_digits));
+            _digits[i].opacity.move(255);
+            _digits[i].isGoingDestroy = false;
+        }
+
+        _current_number_of_digits = new_number_of_digits;
+    }
+
+    void handle_digit_number_changed()
+    {
+        // Iterate through each digit
+        int number = std::abs(_current_number);
+        int actual_digits = get_actual_digits(number);
+        int divisor = std::pow(10, _current_number_of_digits - 1);
+
+        for (int i = 0; i < _current_number_of_digits; ++i) {
+            int digit;
+
+            // 如果当前位是前导零位置
+            if (i < (_current_number_of_digits - actual_digits)) {
+                digit = 0;
+            } else {
+                digit = number / divisor;
+                number %= divisor;
+            }
+            divisor /= 10;
+
+            if (digit_value(_digits[i]) != digit) {
+                bool increase = (_last_number < _current_number);
+                if (_current_number < 0) {
+                    increase = !increase;
+                }
+                // Roll through the strip like DigitFlow::increaseTo() and decreaseTo()
+                if (increase) {
+                    do {
+                        digit_increase(_digits[i]);
+                    } while (digit_value(_digits[i]) != digit);
+                } else {
+                    do {
+                        digit_decrease(_digits[i]);
+                    } while (digit_value(_digits[i]) != digit);
+                }
+            }
+        }
+        _last_number = _current_number;
+    }
+
+    // Show, move or hide a text item, same as the labels of NumberFlow
+    void handle_text_changed(std::unique_ptr<Text_t>& item, const std::string& text, int positionX)
+    {
+        if (text.empty()) {
+            if (item) {
+                item->isGoingDestroy = true;
+                item->positionX.move(0);
+                item->opacity.move(0);
+            }
+            return;
+        }
+
+        if (!item) {
+            item = std::make_unique<Text_t>();
+            DigitFlow::setup_animation(item->positionX, animationType);
+            DigitFlow::setup_animation(item->opacity, animationType);
+        }
+        item->positionX.move(positionX);
+        if (item->text != text) {
+            item->opacity.teleport(0);
+        }
+        item->opacity.move(255);
+        item->isGoingDestroy = false;
+        item->text = text;
+        item->width = get_text_width(text);
+        _is_dirty = true;
+    }
+
+    void handle_sign_changed()
+    {
+        std::string new_sign;
+        if (_current_number < 0) {
+            new_sign = "-";
+        } else if (_current_number > 0) {
+            new_sign = showPositiveSign ? "+" : "";
+        }
+
+        update_prefix_width_cache();
+        handle_text_changed(_text_sign, new_sign, _cached_prefix_width);
+    }
+
+    void handle_point_changed()
+    {
+        handle_text_changed(_text_point,
+                            _decimal_places > 0 ? "." : "",
+                            get_digit_x(_current_number_of_digits - _decimal_places, _current_number_of_digits) -
+                                get_point_width());
+    }
+
+    void handle_prefix_changed()
+    {
+        handle_text_changed(_text_prefix, _prefix, 0);
+        update_prefix_width_cache();
+    }
+
+    void handle_suffix_changed()
+    {
+        // Position suffix after digits
+        update_prefix_width_cache();
+        handle_text_changed(_text_suffix, _suffix, _cached_prefix_width + get_sign_width() + get_digits_width());
+        update_suffix_width_cache();
+    }
+
+    void draw_text(lv_layer_t* layer,
+                   lv_draw_label_dsc_t& dsc,
+                   lv_opa_t baseOpa,
+                   const lv_area_t& coords,
+                   Item_t& item,
+                   const char* text,
+                   int32_t width,
+                   int32_t offsetX,
+                   int32_t y)
+    {
+        dsc.opa = LV_OPA_MIX2(baseOpa, std::clamp((int)item.opacity.directValue(), 0, 255));
+        if (dsc.opa <= LV_OPA_MIN) {
+            return;
+        }
+
+        // lv_draw_label() keeps the pointer, texts are static or live until the next update()
+        dsc.text = text;
+        lv_area_t area;
+        area.x1 = coords.x1 + (int32_t)std::round(item.positionX.directValue()) + offsetX;
+        area.y1 = coords.y1 + y;
+        area.x2 = area.x1 + width - 1;
+        area.y2 = area.y1 + _font_height - 1;
+
+        // Strip glyphs scrolled out of the object are not queued at all
+        if (area.y2 < coords.y1 || area.y1 > coords.y2 || area.x2 < coords.x1 || area.x1 > coords.x2) {
+            return;
+        }
+        lv_draw_label(layer, &dsc, &area);
+    }
+
+    void draw(lv_layer_t* layer)
+    {
+        lv_area_t coords;
+        lv_obj_get_content_coords(this->raw_ptr(), &coords);
+
+        // lv_obj_redraw() clips DRAW_MAIN to this object, which has no padding: the glyph strips scroll out of it like
+        // out of the DigitFlow masks
+        lv_draw_label_dsc_t dsc;
+        lv_draw_label_dsc_init(&dsc);
+        lv_obj_init_draw_label_dsc(this->raw_ptr(), LV_PART_MAIN, &dsc);
+        const lv_opa_t base_opa = dsc.opa;
+        const lv_color_t digit_color = dsc.color;
+
+        for (auto& digit : _digits) {
+            // Only the two strip glyphs around the offset can be visible
+            float offset_y = digit.offsetY.directValue();
+            int first = std::floor(offset_y / _font_height);
+            for (int i = std::max(first, 0); i <= first + 1 && i < (int)_digit_texts.size(); i++) {
+                const char* text = _digit_texts[i];
+                int32_t glyph_width = lv_font_get_glyph_width(dsc.font, text[0], 0);
+                int32_t y = i * _font_height - (int32_t)std::round(offset_y);
+                draw_text(layer, dsc, base_opa, coords, digit, text, glyph_width, (_font_width - glyph_width) / 2, y);
+            }
+        }
+
+        if (_text_sign) {
+            draw_text(layer, dsc, base_opa, coords, *_text_sign, _text_sign->text.c_str(), _text_sign->width, 0, 0);
+        }
+        if (_text_point) {
+            draw_text(layer, dsc, base_opa, coords, *_text_point, _text_point->text.c_str(), _text_point->width, 0, 0);
+        }
+        if (_text_prefix) {
+            dsc.color = _prefix_color.value_or(digit_color);
+            draw_text(layer, dsc, base_opa, coords, *_text_prefix, _text_prefix->text.c_str(), _text_prefix->width, 0, 0);
+        }
+        if (_text_suffix) {
+            dsc.color = _suffix_color.value_or(digit_color);
+            draw_text(layer, dsc, base_opa, coords, *_text_suffix, _text_suffix->text.c_str(), _text_suffix->width, 0, 0);
+        }
+    }
+
+    static void event_cb(lv_event_t* e)
+    {
+        auto self = (NumberFlowLabel*)lv_event_get_user_data(e);
+        if (lv_event_get_code(e) == LV_EVENT_DRAW_MAIN) {
+            self->draw(lv_event_get_layer(e));
+        } else if (lv_event_get_code(e) == LV_EVENT_GET_SELF_SIZE) {
+            auto size = (lv_point_t*)lv_event_get_param(e);
+            size->x = std::max(size->x, self->_content_width);
+            size->y = std::max(size->y, self->_font_height);
+        }
+    }
+};
+
+/**
+ * @brief NumberFlowFloat drawn by a single object
+ *
+ * Same API as NumberFlowFloat. The value is shown as a fixed point number of decimalPlaces digits, the integer and
+ * decimal digits, the point, sign, prefix and suffix being drawn by one NumberFlowLabel.
+ */
+class NumberFlowFloatLabel : public NumberFlowLabel {
+public:
+    using NumberFlowLabel::NumberFlowLabel;
+
+    int decimalPlaces = 2; // 小数位数
+
+    void init()
+    {
+        _decimal_places = decimalPlaces;
+        _current_number = to_fixed_point(_current_value);
+        NumberFlowLabel::init();
+    }
+
+    void update()
+    {
+        if (!_is_inited) {
+            init();
+        }
+        NumberFlowLabel::update();
+    }
+
+    float value() const
+    {
+        return _current_value;
+    }
+
+    void setValue(float targetValue)
+    {
+        _current_value = targetValue;
+        _decimal_places = decimalPlaces;
+        NumberFlowLabel::setValue(to_fixed_point(targetValue));
+    }
+
+    void setDecimalPlaces(int places)
+    {
+        decimalPlaces = places;
+        if (_is_inited) {
+            setValue(_current_value);
+        }
+    }
+
+protected:
+    float _current_value = 0.0f;
+
+    int to_fixed_point(float value)
+    {
+        return static_cast<int>(std::round(value * std::pow(10, decimalPlaces)));
+    }
+};
+
+} // namespace lvgl_cpp
+} // namespace smooth_ui_toolkit
@@ -27,3 +27,4 @@
 #include "number_flow/digit_flow.h"
 #include "number_flow/number_flow.h"
 #include "number_flow/number_flow_float.h"
+#include "number_flow/number_flow_label.h"
@@ -9,11 +9,13 @@
  *
  */
 #pragma once
-#include "animation/animate/animate.h"
+#include "animation/animate/animate.h"
+#include "animation/animate/animate_fixed.h"
 #include "animation/animate_value/animate_value.h"
 #include "animation/sequence/animate_sequence.h"
 #include "animation/animate_vector/animate_vector2.h"
-#include "animation/animate_vector/animate_vector4.h"
+#include "animation/animate_vector/animate_vector4.h"
+#include "animation/animation_group/animation_group.h"
 #include "utils/easing/cubic_bezier/cubic_bezier.h"
 #include "utils/easing/ease.h"
 #include "utils/event/event_queue.h"
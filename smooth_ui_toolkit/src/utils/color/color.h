@@ -139,6 +139,17 @@ struct AnimateRgb_t : public Rgb_t {
         b = b_anim;
     }
 
+    // Update all channels with the same timestamp (seconds), for batch updates
+    inline void update(const float& currentTime)
+    {
+        r_anim.update(currentTime);
+        g_anim.update(currentTime);
+        b_anim.update(currentTime);
+        r = r_anim.directValue();
+        g = g_anim.directValue();
+        b = b_anim.directValue();
+    }
+
     inline void teleport(uint8_t r, uint8_t g, uint8_t b)
     {
         r_anim.teleport(r);
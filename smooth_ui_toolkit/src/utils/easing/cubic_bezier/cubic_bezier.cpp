@@ -11,6 +11,11 @@
 #include "cubic_bezier.h"
 #include <functional>
 #include <cmath>
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <algorithm>
 
 static const float subdivisionPrecision = 0.0000001;
 static const int subdivisionMaxIterations = 12;
@@ -21,6 +26,12 @@ static float calcBezier(float t, float a1, float a2)
     return (((1.0 - 3.0 * a2 + 3.0 * a1) * t + (3.0 * a2 - 6.0 * a1)) * t + 3.0 * a1) * t;
 }
 
+// 曲线斜率 dx/dt
+static float getSlope(float t, float a1, float a2)
+{
+    return 3.0 * (1.0 - 3.0 * a2 + 3.0 * a1) * t * t + 2.0 * (3.0 * a2 - 6.0 * a1) * t + 3.0 * a1;
+}
+
 // 使用二分法逼近，找到给定 x 对应的 t 值
 static float binarySubdivide(float x, float lowerBound, float upperBound, float mX1, float mX2)
 {
@@ -60,3 +71,109 @@ std::function<float(float)> smooth_ui_toolkit::cubic_bezier(float mX1, float mY1
         return calcBezier(bezierT, mY1, mY2);
     };
 }
+
+// 查表模式
+static const int splineTableSize = 33;
+static const float splineStepSize = 1.0 / (splineTableSize - 1);
+static const float newtonPrecision = 0.000001;
+static const float newtonMinSlope = 0.001;
+static const int newtonMaxIterations = 4;
+
+namespace {
+
+struct SplineTable_t {
+    float mX1, mY1, mX2, mY2;
+    // t of evenly spaced x
+    std::array<float, splineTableSize> t;
+};
+
+} // namespace
+
+// 双精度二分求解 x 对应的 t，用于建表，以及斜率接近 0 处的查表
+static float solveTForX(float x, float mX1, float mX2, double lower, double upper, int iterations)
+{
+    double a1 = mX1;
+    double a2 = mX2;
+    for (int i = 0; i < iterations; i++) {
+        double middle = (lower + upper) / 2.0;
+        if ((((1.0 - 3.0 * a2 + 3.0 * a1) * middle + (3.0 * a2 - 6.0 * a1)) * middle + 3.0 * a1) * middle > x) {
+            upper = middle;
+        } else {
+            lower = middle;
+        }
+    }
+    return (lower + upper) / 2.0;
+}
+
+static std::shared_ptr<const SplineTable_t> createSplineTable(float mX1, float mY1, float mX2, float mY2)
+{
+    auto table = std::make_shared<SplineTable_t>();
+    table->mX1 = mX1;
+    table->mY1 = mY1;
+    table->mX2 = mX2;
+    table->mY2 = mY2;
+    for (int i = 0; i < splineTableSize; i++) {
+        table->t[i] = solveTForX(i * splineStepSize, mX1, mX2, 0.0, 1.0, 40);
+    }
+    return table;
+}
+
+static std::mutex _table_mutex;
+static std::map<std::array<float, 4>, std::shared_ptr<const SplineTable_t>> _table_cache;
+
+static float sampleSplineTable(const SplineTable_t& table, float x)
+{
+    // 表内线性插值作为初值
+    float position = x * (splineTableSize - 1);
+    int index = std::clamp(static_cast<int>(position), 0, splineTableSize - 2);
+    float lowerT = table.t[index];
+    float upperT = table.t[index + 1];
+    float t = lowerT + (upperT - lowerT) * (position - index);
+
+    // 误差过大时牛顿迭代修正，斜率过小或不收敛则在该区间内二分
+    for (int i = 0; i < newtonMaxIterations; i++) {
+        float currentX = calcBezier(t, table.mX1, table.mX2) - x;
+        if (std::abs(currentX) <= newtonPrecision) {
+            return calcBezier(t, table.mY1, table.mY2);
+        }
+        float slope = getSlope(t, table.mX1, table.mX2);
+        if (slope < newtonMinSlope) {
+            break;
+        }
+        // 解一定在该区间内
+        t = std::clamp(t - currentX / slope, lowerT, upperT);
+    }
+
+    t = solveTForX(x, table.mX1, table.mX2, lowerT, upperT, 20);
+    return calcBezier(t, table.mY1, table.mY2);
+}
+
+std::function<float(float)> smooth_ui_toolkit::cubic_bezier_table(float mX1, float mY1, float mX2, float mY2)
+{
+    if (mX1 == mY1 && mX2 == mY2) {
+        return [](float t) { return t; };
+    }
+
+    std::shared_ptr<const SplineTable_t> table;
+    {
+        std::lock_guard<std::mutex> lock(_table_mutex);
+        auto& cached = _table_cache[{mX1, mY1, mX2, mY2}];
+        if (!cached) {
+            cached = createSplineTable(mX1, mY1, mX2, mY2);
+        }
+        table = cached;
+    }
+
+    return [table](float t) {
+        if (t == 0.0 || t == 1.0) {
+            return t;
+        }
+        return sampleSplineTable(*table, t);
+    };
+}
+
+size_t smooth_ui_toolkit::cubic_bezier_table_count()
+{
+    std::lock_guard<std::mutex> lock(_table_mutex);
+    return _table_cache.size();
+}
@@ -10,6 +10,7 @@
  */
 #pragma once
 #include <functional>
+#include <cstddef>
 // 参考：
 // https://github.com/motiondivision/motion/blob/main/packages/framer-motion/src/easing/cubic-bezier.ts
 
@@ -17,4 +18,28 @@ namespace smooth_ui_toolkit {
 
 std::function<float(float)> cubic_bezier(float mX1, float mY1, float mX2, float mY2);
 
-}
+/**
+ * @brief Cubic bezier easing from a pre-sampled spline table, same curve as cubic_bezier()
+ *
+ * The t for evenly spaced x is solved once per unique set of control points and cached, every easing function
+ * created for the same curve (and every Animate using it) shares that table. Sampling interpolates the table and only
+ * runs Newton steps when the guess is off by more than 1e-6 in x, it is faster and more accurate than the per sample
+ * bisection of cubic_bezier().
+ * 预采样查表的贝塞尔缓动，相同控制点共享同一张表
+ *
+ * @param mX1 0~1
+ * @param mY1
+ * @param mX2 0~1
+ * @param mY2
+ * @return std::function<float(float)>
+ */
+std::function<float(float)> cubic_bezier_table(float mX1, float mY1, float mX2, float mY2);
+
+/**
+ * @brief Number of cached cubic bezier tables
+ *
+ * @return size_t
+ */
+size_t cubic_bezier_table_count();
+
+} // namespace smooth_ui_toolkit
@@ -12,6 +12,9 @@
 #include <functional>
 #include <queue>
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <utility>
 
 namespace smooth_ui_toolkit {
 
@@ -32,12 +35,25 @@ public:
         events.push(event);
     }
 
+    /**
+     * @brief Handle all queued events, the mutex is only held to swap the queue out, so handlers may emit (handled on
+     * next poll) and emitters are not blocked by handlers
+     *
+     * @param onEvent
+     */
     void poll(std::function<void(const T&)> onEvent)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        while (!events.empty()) {
-            onEvent(events.front());
-            events.pop();
+        std::unique_lock<std::mutex> lock(mutex);
+        if (events.empty()) {
+            return;
+        }
+        std::queue<T> polling_events;
+        std::swap(events, polling_events);
+        lock.unlock();
+
+        while (!polling_events.empty()) {
+            onEvent(polling_events.front());
+            polling_events.pop();
         }
     };
 
@@ -66,4 +82,84 @@ public:
     }
 };
 
+/**
+ * @brief Lock free event queue for one producer thread and one consumer thread
+ *
+ * A fixed size ring buffer like ring_buffer, with atomic read/write indices instead of the shared size counter, so
+ * emit() and poll() never block each other. Events are dropped when the queue is full.
+ * 单生产者单消费者无锁队列
+ *
+ * @tparam T
+ * @tparam Capacity
+ */
+template <typename T, size_t Capacity>
+class SpscEventQueue {
+public:
+    SpscEventQueue()
+    {
+        _buffer = std::make_unique<T[]>(Capacity + 1);
+    }
+
+    // Disable copy constructor and copy assignment operator
+    SpscEventQueue(const SpscEventQueue&) = delete;
+    SpscEventQueue& operator=(const SpscEventQueue&) = delete;
+
+    /**
+     * @brief Queue an event, producer thread only
+     *
+     * @param event
+     * @return false if the queue is full and the event is dropped
+     */
+    bool emit(const T& event)
+    {
+        size_t w_index = _w_index.load(std::memory_order_relaxed);
+        size_t next = (w_index + 1) % (Capacity + 1);
+        if (next == _r_index.load(std::memory_order_acquire)) {
+            return false;
+        }
+        _buffer[w_index] = event;
+        _w_index.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Handle all queued events, consumer thread only
+     *
+     * @param onEvent
+     */
+    void poll(std::function<void(const T&)> onEvent)
+    {
+        size_t r_index = _r_index.load(std::memory_order_relaxed);
+        size_t w_index = _w_index.load(std::memory_order_acquire);
+        while (r_index != w_index) {
+            onEvent(_buffer[r_index]);
+            r_index = (r_index + 1) % (Capacity + 1);
+            _r_index.store(r_index, std::memory_order_release);
+        }
+    }
+
+    bool empty()
+    {
+        return _r_index.load(std::memory_order_acquire) == _w_index.load(std::memory_order_acquire);
+    }
+
+    size_t size()
+    {
+        size_t w_index = _w_index.load(std::memory_order_acquire);
+        size_t r_index = _r_index.load(std::memory_order_acquire);
+        return (w_index + Capacity + 1 - r_index) % (Capacity + 1);
+    }
+
+    constexpr size_t capacity() const
+    {
+        return Capacity;
+    }
+
+private:
+    // One slot more than Capacity, so full and empty differ
+    std::unique_ptr<T[]> _buffer;
+    std::atomic<size_t> _w_index{0};
+    std::atomic<size_t> _r_index{0};
+};
+
 } // namespace smooth_ui_toolkit
@@ -13,12 +13,19 @@
 #include <vector>
 #include <mutex>
 #include <algorithm>
+#include <iterator>
+#include <memory>
 
 namespace smooth_ui_toolkit {
 
 /**
  * @brief Observer pattern like godot's signal
  *
+ * Slots are stored as an immutable list, replaced on every connect/disconnect/clear (copy on write). emit() only locks
+ * to take a reference to the current list and calls the slots without holding the lock, so slots may connect,
+ * disconnect or emit again, and a slow slot doesn't block other emitters. Changes made during an emit apply from the
+ * next emit.
+ *
  * @tparam T
  */
 template <typename... Args>
@@ -28,8 +35,11 @@ public:
 
     void emit(Args... args)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        for (auto& [id, slot] : _slots) {
+        auto slots = snapshot();
+        if (!slots) {
+            return;
+        }
+        for (auto& [id, slot] : *slots) {
             slot(args...);
         }
     }
@@ -38,31 +48,49 @@ public:
     {
         std::lock_guard<std::mutex> lock(_mutex);
         size_t id = ++_last_id;
-        _slots.push_back({id, slot});
+        auto slots = _slots ? std::make_shared<SlotList>(*_slots) : std::make_shared<SlotList>();
+        slots->push_back({id, slot});
+        _slots = std::move(slots);
         return id;
     }
 
     void disconnect(size_t id)
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        _slots.erase(std::remove_if(_slots.begin(),
-                                    _slots.end(),
-                                    [id](auto& pair) {
-                                        return pair.first == id;
-                                    }),
-                     _slots.end());
+        if (!_slots) {
+            return;
+        }
+        auto slots = std::make_shared<SlotList>();
+        slots->reserve(_slots->size());
+        std::copy_if(_slots->begin(), _slots->end(), std::back_inserter(*slots), [id](auto& pair) {
+            return pair.first != id;
+        });
+        _slots = std::move(slots);
     }
 
     void clear()
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        _slots.clear();
+        _slots.reset();
+    }
+
+    size_t size()
+    {
+        auto slots = snapshot();
+        return slots ? slots->size() : 0;
     }
 
 private:
-    std::vector<std::pair<size_t, SlotType>> _slots;
+    using SlotList = std::vector<std::pair<size_t, SlotType>>;
+    std::shared_ptr<const SlotList> _slots;
     size_t _last_id = 0;
     std::mutex _mutex;
+
+    std::shared_ptr<const SlotList> snapshot()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _slots;
+    }
 };
 
 template <>
@@ -0,0 +1,229 @@
+/**
+ * @file animation_group_test.cpp
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <animation/animate_value/animate_value.h>
+#include <animation/animation_group/animation_group.h>
+#include <utils/easing/ease.h>
+#include <utils/hal/hal.h>
+
+using namespace smooth_ui_toolkit;
+
+// 虚拟时钟，60 Hz
+static uint32_t _tick_ms = 1000;
+static const uint32_t _frame_ms = 16;
+
+static void setup_spring(SpringOptions_t& options, int kind)
+{
+    switch (kind) {
+        case 0: // 欠阻尼，NumberFlow 的配置
+            options.visualDuration = 0.6;
+            options.bounce = 0.05;
+            break;
+        case 1: // 欠阻尼，默认参数
+            break;
+        case 2: // 临界阻尼
+            options.stiffness = 100;
+            options.damping = 20;
+            break;
+        default: // 过阻尼
+            options.stiffness = 100;
+            options.damping = 40;
+            break;
+    }
+}
+
+static float target_of(int member, int round)
+{
+    return std::fmod(member * 37.0f + round * 113.0f, 500.0f) - 250.0f;
+}
+
+// 与逐个 AnimateValue 的结果一致
+void test_same_as_animate_value()
+{
+    std::cout << "Running tests on animation_group...\n";
+
+    const int count = 40;
+    std::vector<std::unique_ptr<AnimateValue>> values;
+    AnimationGroup group;
+    std::vector<AnimationGroup::Id> ids;
+
+    for (int i = 0; i < count; i++) {
+        auto value = std::make_unique<AnimateValue>();
+        auto id = group.add();
+        int kind = i % 5;
+        if (kind == 4) {
+            value->easingOptions().duration = 0.5;
+            value->easingOptions().easingFunction = ease::ease_out_quad;
+            EasingOptions_t options;
+            options.duration = 0.5;
+            options.easingFunction = ease::ease_out_quad;
+            group.setEasingOptions(id, options);
+        } else {
+            setup_spring(value->springOptions(), kind);
+            SpringOptions_t options;
+            setup_spring(options, kind);
+            group.setSpringOptions(id, options);
+        }
+        value->teleport(target_of(i, 0));
+        group.teleport(id, target_of(i, 0));
+        values.push_back(std::move(value));
+        ids.push_back(id);
+    }
+    group.update(ui_hal::get_tick_s());
+
+    float max_error = 0.0f;
+    for (int frame = 1; frame <= 400; frame++) {
+        // 定期重定向，部分成员在运动中途改变目标
+        if (frame % 25 == 1) {
+            int round = frame / 25 + 1;
+            for (int i = 0; i < count; i++) {
+                if ((i + round) % 3 != 0) {
+                    values[i]->move(target_of(i, round));
+                    group.move(ids[i], target_of(i, round));
+                }
+            }
+        }
+
+        _tick_ms += _frame_ms;
+        float now = ui_hal::get_tick_s();
+        group.update(now);
+        for (int i = 0; i < count; i++) {
+            values[i]->update(now);
+            max_error = std::max(max_error, std::abs(values[i]->directValue() - group.value(ids[i])));
+        }
+    }
+    std::cout << "Max error: " << max_error << "\n";
+    assert(max_error < 0.01f && "Group values should match AnimateValue");
+
+    // 全部静止
+    for (int i = 0; i < 200; i++) {
+        _tick_ms += _frame_ms;
+        group.update(ui_hal::get_tick_s());
+    }
+    assert(group.runningCount() == 0 && "All members should be at rest");
+    for (int i = 0; i < count; i++) {
+        assert(std::abs(group.value(ids[i]) - group.target(ids[i])) <= 0.1f && "Members should rest on target");
+    }
+}
+
+// 回调只在值变化时调用
+void test_callbacks()
+{
+    AnimationGroup group;
+    auto a = group.add(0.0f);
+    auto b = group.add(10.0f);
+
+    int a_calls = 0;
+    int b_calls = 0;
+    float a_last = 0.0f;
+    group.onUpdate(a, [&](const float& value) {
+        a_calls++;
+        a_last = value;
+    });
+    group.onUpdate(b, [&](const float&) { b_calls++; });
+
+    group.update(ui_hal::get_tick_s());
+    assert(a_calls == 0 && b_calls == 0 && "No callback without change");
+
+    group.move(a, 100.0f);
+    while (!group.done(a)) {
+        _tick_ms += _frame_ms;
+        group.update(ui_hal::get_tick_s());
+    }
+    assert(a_calls > 0 && "Moving member should be notified");
+    assert(a_last == group.value(a) && "Last callback should have the final value");
+    assert(b_calls == 0 && "Still member should not be notified");
+
+    int settled_calls = a_calls;
+    for (int i = 0; i < 10; i++) {
+        _tick_ms += _frame_ms;
+        group.update(ui_hal::get_tick_s());
+    }
+    assert(a_calls == settled_calls && "Settled member should not be notified");
+
+    group.teleport(b, 20.0f);
+    group.update(ui_hal::get_tick_s());
+    assert(b_calls == 1 && group.value(b) == 20.0f && "Teleport should notify once");
+
+    // 移除后 id 复用
+    group.remove(a);
+    assert(group.size() == 1 && group.value(b) == 20.0f);
+    auto c = group.add(5.0f);
+    assert(c == a && group.value(c) == 5.0f && group.done(c));
+}
+
+// 与逐个 Animate::update() 的耗时对比
+void bench_update()
+{
+    const int count = 1000;
+    const int frames = 600;
+
+    std::vector<std::unique_ptr<AnimateValue>> values;
+    AnimationGroup group;
+    for (int i = 0; i < count; i++) {
+        auto value = std::make_unique<AnimateValue>();
+        setup_spring(value->springOptions(), 0);
+        values.push_back(std::move(value));
+
+        auto id = group.add();
+        SpringOptions_t options;
+        setup_spring(options, 0);
+        group.setSpringOptions(id, options);
+    }
+
+    auto run = [&](auto&& step) {
+        double seconds = 0;
+        for (int frame = 0; frame < frames; frame++) {
+            if (frame % 60 == 0) {
+                for (int i = 0; i < count; i++) {
+                    values[i]->move(target_of(i, frame));
+                    group.move(i, target_of(i, frame));
+                }
+            }
+            _tick_ms += _frame_ms;
+            float now = ui_hal::get_tick_s();
+            auto start = std::chrono::steady_clock::now();
+            step(now);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        return seconds * 1e9 / (double(count) * frames);
+    };
+
+    uint32_t start_tick = _tick_ms;
+    double animate_ns = run([&](float now) {
+        for (auto& value : values) {
+            value->update(now);
+        }
+    });
+    _tick_ms = start_tick;
+    double group_ns = run([&](float now) { group.update(now); });
+
+    std::cout << "Animate::update(): " << animate_ns << " ns per value per frame\n";
+    std::cout << "AnimationGroup::update(): " << group_ns << " ns per value per frame\n";
+    std::cout << "Speedup: " << animate_ns / group_ns << "x\n";
+}
+
+int main()
+{
+    ui_hal::on_get_tick([]() { return _tick_ms; });
+
+    test_same_as_animate_value();
+    test_callbacks();
+    bench_update();
+
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file cubic_bezier_test.cpp
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <utils/easing/cubic_bezier/cubic_bezier.h>
+
+using namespace smooth_ui_toolkit;
+
+struct Curve_t {
+    const char* name;
+    float x1, y1, x2, y2;
+};
+
+static const std::vector<Curve_t> _curves = {
+    {"ease", 0.25f, 0.1f, 0.25f, 1.0f},
+    {"ease-in-out", 0.42f, 0.0f, 0.58f, 1.0f},
+    {"ios slide", 0.32f, 0.72f, 0.0f, 1.0f},
+    {"steep", 0.9f, 0.0f, 0.1f, 1.0f},
+    {"overshoot", 0.68f, -0.6f, 0.32f, 1.6f},
+    {"flat ends", 1.0f, 0.0f, 0.0f, 1.0f},
+};
+
+static double bezier(double t, double a1, double a2)
+{
+    return ((1 - 3 * a2 + 3 * a1) * t * t + (3 * a2 - 6 * a1) * t + 3 * a1) * t;
+}
+
+// 双精度二分求解的参考值
+static double reference(const Curve_t& curve, double x)
+{
+    double lower = 0.0;
+    double upper = 1.0;
+    for (int i = 0; i < 60; i++) {
+        double middle = (lower + upper) / 2;
+        if (bezier(middle, curve.x1, curve.x2) > x) {
+            upper = middle;
+        } else {
+            lower = middle;
+        }
+    }
+    return bezier((lower + upper) / 2, curve.y1, curve.y2);
+}
+
+static double max_error(const Curve_t& curve, const std::function<float(float)>& easing)
+{
+    double error = 0.0;
+    for (int i = 0; i <= 4000; i++) {
+        float x = i / 4000.0f;
+        error = std::max(error, std::abs(easing(x) - reference(curve, x)));
+    }
+    return error;
+}
+
+void test_accuracy()
+{
+    std::cout << "Running tests on cubic_bezier...\n";
+
+    for (const auto& curve : _curves) {
+        double table_error = max_error(curve, cubic_bezier_table(curve.x1, curve.y1, curve.x2, curve.y2));
+        double solver_error = max_error(curve, cubic_bezier(curve.x1, curve.y1, curve.x2, curve.y2));
+        std::cout << "  " << curve.name << ": table error " << table_error << ", solver error " << solver_error
+                  << "\n";
+        assert(table_error <= 2e-5 && "Table easing should follow the curve");
+        assert(table_error <= solver_error + 1e-6 && "Table easing should be at least as accurate as the solver");
+    }
+
+    auto easing = cubic_bezier_table(0.25f, 0.1f, 0.25f, 1.0f);
+    assert(easing(0.0f) == 0.0f && easing(1.0f) == 1.0f && "Ends should be exact");
+    auto linear = cubic_bezier_table(0.3f, 0.3f, 0.7f, 0.7f);
+    assert(linear(0.37f) == 0.37f && "Linear curve should be identity");
+}
+
+void test_cache()
+{
+    size_t count = cubic_bezier_table_count();
+    auto a = cubic_bezier_table(0.11f, 0.22f, 0.33f, 0.44f);
+    auto b = cubic_bezier_table(0.11f, 0.22f, 0.33f, 0.44f);
+    assert(cubic_bezier_table_count() == count + 1 && "Same curve should share one table");
+    assert(a(0.5f) == b(0.5f));
+    cubic_bezier_table(0.11f, 0.22f, 0.33f, 0.45f);
+    assert(cubic_bezier_table_count() == count + 2 && "Other curve should get its own table");
+}
+
+// 查表与逐次求解的耗时对比
+static double bench(const std::function<float(float)>& easing)
+{
+    const int samples = 1000000;
+    float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+        sink += easing((i % 997) / 997.0f);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    volatile float keep = sink;
+    (void)keep;
+    return seconds * 1e9 / samples;
+}
+
+void bench_sampling()
+{
+    for (const auto& curve : _curves) {
+        double solver_ns = bench(cubic_bezier(curve.x1, curve.y1, curve.x2, curve.y2));
+        double table_ns = bench(cubic_bezier_table(curve.x1, curve.y1, curve.x2, curve.y2));
+        std::cout << "  " << curve.name << ": cubic_bezier() " << solver_ns << " ns, cubic_bezier_table() "
+                  << table_ns << " ns\n";
+    }
+}
+
+int main()
+{
+    test_accuracy();
+    test_cache();
+    bench_sampling();
+
+    std::cout << "All tests passed!\n";
+    return 0;
+}
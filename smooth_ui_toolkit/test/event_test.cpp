@@ -0,0 +1,282 @@
+/**
+ * @file event_test.cpp
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <utils/event/signal.h>
+#include <utils/event/event_queue.h>
+
+using namespace smooth_ui_toolkit;
+
+static bool wait_for(const std::atomic<bool>& flag)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!flag.load()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// 在槽函数里连接、断开、再次发射
+void test_signal_reentrancy()
+{
+    std::cout << "Running tests on signal...\n";
+
+    Signal<int> signal;
+    int late_calls = 0;
+    int self_calls = 0;
+    int nested_calls = 0;
+
+    // 发射中连接，下次发射生效
+    size_t connector = signal.connect([&](int) {
+        signal.connect([&](int) { late_calls++; });
+    });
+    signal.emit(0);
+    assert(late_calls == 0 && signal.size() == 2 && "Slot connected during emit should wait for next emit");
+    signal.disconnect(connector);
+    signal.emit(0);
+    assert(late_calls == 1 && signal.size() == 1);
+
+    // 发射中断开自己
+    size_t self_id = 0;
+    self_id = signal.connect([&](int) {
+        self_calls++;
+        signal.disconnect(self_id);
+    });
+    signal.emit(0);
+    signal.emit(0);
+    assert(self_calls == 1 && "Slot should disconnect itself");
+
+    // 递归发射
+    signal.connect([&](int depth) {
+        nested_calls++;
+        if (depth < 3) {
+            signal.emit(depth + 1);
+        }
+    });
+    signal.emit(0);
+    assert(nested_calls == 4 && "Slot should emit again");
+
+    // 发射中清空
+    signal.connect([&](int) { signal.clear(); });
+    signal.emit(10);
+    assert(signal.size() == 0 && "Slot should clear the signal");
+    signal.emit(10);
+}
+
+// 慢槽函数不阻塞其他线程的发射
+void test_signal_concurrency()
+{
+    Signal<bool> signal;
+    std::atomic<bool> slow_entered{false};
+    std::atomic<bool> other_emitted{false};
+    std::atomic<bool> slow_released{false};
+
+    signal.connect([&](bool slow) {
+        if (slow) {
+            slow_entered = true;
+            slow_released = wait_for(other_emitted);
+        }
+    });
+
+    std::thread slow_thread([&]() { signal.emit(true); });
+    bool entered = wait_for(slow_entered);
+    assert(entered);
+    signal.emit(false);
+    other_emitted = true;
+    slow_thread.join();
+    assert(slow_released && "Emit should not wait for a slot running in another thread");
+}
+
+void test_event_queue_reentrancy()
+{
+    std::cout << "Running tests on event_queue...\n";
+
+    EventQueue<int> queue;
+    std::vector<int> handled;
+    queue.emit(1);
+    queue.emit(2);
+    queue.poll([&](const int& event) {
+        handled.push_back(event);
+        // 处理中发射，下次 poll 处理
+        if (event < 10) {
+            queue.emit(event + 10);
+        }
+    });
+    assert(handled.size() == 2 && queue.size() == 2 && "Events emitted during poll should wait for next poll");
+    queue.poll([&](const int& event) { handled.push_back(event); });
+    assert(handled.size() == 4 && handled[2] == 11 && handled[3] == 12 && queue.empty());
+}
+
+void test_spsc_event_queue()
+{
+    std::cout << "Running tests on spsc_event_queue...\n";
+
+    SpscEventQueue<int, 4> small;
+    int accepted = 0;
+    for (int i = 0; i < 5; i++) {
+        accepted += small.emit(i) ? 1 : 0;
+    }
+    assert(accepted == 4 && small.size() == 4 && "Full queue should drop events");
+    std::vector<int> polled;
+    small.poll([&](const int& event) { polled.push_back(event); });
+    assert(polled == std::vector<int>({0, 1, 2, 3}) && small.empty());
+
+    // 跨线程按序传递
+    const int count = 200000;
+    SpscEventQueue<int, 256> queue;
+    std::thread producer([&]() {
+        for (int i = 0; i < count; i++) {
+            while (!queue.emit(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int next = 0;
+    bool in_order = true;
+    while (next < count) {
+        int before = next;
+        queue.poll([&](const int& event) {
+            in_order = in_order && event == next;
+            next++;
+        });
+        if (next == before) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    assert(in_order && queue.empty() && "Events should arrive in order");
+}
+
+// 旧实现：发射时持有锁，作为对照
+template <typename... Args>
+class LockedSignal {
+public:
+    void emit(Args... args)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& slot : _slots) {
+            slot(args...);
+        }
+    }
+    void connect(const std::function<void(Args...)>& slot)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _slots.push_back(slot);
+    }
+
+private:
+    std::vector<std::function<void(Args...)>> _slots;
+    std::mutex _mutex;
+};
+
+template <typename SignalType>
+double bench_signal(SignalType& signal, int threads)
+{
+    const int emits = 20000;
+    std::atomic<uint64_t> sink{0};
+    for (int i = 0; i < 4; i++) {
+        signal.connect([&sink](int value) {
+            // 少量计算模拟槽函数的工作
+            uint64_t hash = value;
+            for (int k = 0; k < 200; k++) {
+                hash = hash * 6364136223846793005ull + 1442695040888963407ull;
+            }
+            sink.fetch_add(hash & 1, std::memory_order_relaxed);
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&signal, t]() {
+            for (int i = 0; i < emits; i++) {
+                signal.emit(i + t);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (double(emits) * threads);
+}
+
+template <typename Queue>
+double bench_queue(Queue& queue)
+{
+    const int count = 500000;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&]() {
+        for (int i = 0; i < count; i++) {
+            if constexpr (std::is_same<decltype(queue.emit(i)), bool>::value) {
+                while (!queue.emit(i)) {
+                    std::this_thread::yield();
+                }
+            } else {
+                queue.emit(i);
+            }
+        }
+    });
+    int received = 0;
+    while (received < count) {
+        int before = received;
+        queue.poll([&](const int&) { received++; });
+        if (received == before) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / count;
+}
+
+void bench_contention()
+{
+    int threads = std::max(2u, std::min(4u, std::thread::hardware_concurrency()));
+    {
+        LockedSignal<int> locked;
+        Signal<int> snapshot;
+        double locked_ns = bench_signal(locked, threads);
+        double snapshot_ns = bench_signal(snapshot, threads);
+        std::cout << "Signal emit, " << threads << " threads: locked " << locked_ns << " ns, snapshot " << snapshot_ns
+                  << " ns\n";
+    }
+    {
+        EventQueue<int> locked;
+        SpscEventQueue<int, 1024> spsc;
+        double locked_ns = bench_queue(locked);
+        double spsc_ns = bench_queue(spsc);
+        std::cout << "Queue, 1 producer 1 consumer: EventQueue " << locked_ns << " ns, SpscEventQueue " << spsc_ns
+                  << " ns per event\n";
+    }
+}
+
+int main()
+{
+    test_signal_reentrancy();
+    test_signal_concurrency();
+    test_event_queue_reentrancy();
+    test_spsc_event_queue();
+    bench_contention();
+
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file fixed_point_test.cpp
+ * @author Forairaaaaa
+ * @brief
+ * @version 0.1
+ * @date 2025-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <animation/animate/animate_fixed.h>
+#include <utils/hal/hal.h>
+
+using namespace smooth_ui_toolkit;
+
+// 与 float 版本的最大误差，相对于移动距离
+static const float _spring_tolerance = 0.002f;
+static const float _easing_tolerance = 0.0001f;
+
+static const float _frame_time = 1.0f / 60.0f;
+
+struct SpringCase_t {
+    const char* name;
+    SpringOptions_t options;
+};
+
+static std::vector<SpringCase_t> spring_cases()
+{
+    std::vector<SpringCase_t> cases;
+    SpringOptions_t options;
+    cases.push_back({"default", options});
+
+    options = SpringOptions_t();
+    options.visualDuration = 0.6;
+    options.bounce = 0.05;
+    cases.push_back({"visual duration", options});
+
+    options = SpringOptions_t();
+    options.visualDuration = 0.3;
+    options.bounce = 0.5;
+    cases.push_back({"bouncy", options});
+
+    options = SpringOptions_t();
+    options.duration = 800;
+    options.bounce = 0.3;
+    cases.push_back({"duration", options});
+
+    options = SpringOptions_t();
+    options.stiffness = 100;
+    options.damping = 20;
+    cases.push_back({"critical", options});
+
+    options = SpringOptions_t();
+    options.stiffness = 100;
+    options.damping = 40;
+    cases.push_back({"overdamped", options});
+    return cases;
+}
+
+// 同一组参数分别跑 float 和定点版本，中途重定向一次，返回最大相对误差
+template <typename Fixed_t>
+float compare_spring(const SpringOptions_t& options, float start, float end, float retargetEnd)
+{
+    Spring reference;
+    FixedSpring<Fixed_t> fixed;
+    reference.springOptions = options;
+    fixed.springOptions = options;
+    reference.start = fixed.start = start;
+    reference.end = fixed.end = end;
+    reference.init();
+    fixed.init();
+
+    float distance = std::max(std::abs(end - start), std::abs(retargetEnd - start));
+    float max_error = 0.0f;
+    float t = 0.0f;
+    for (int frame = 0; frame < 600; frame++) {
+        if (frame == 20) {
+            reference.retarget(reference.value, retargetEnd);
+            fixed.retarget(fixed.value, retargetEnd);
+            t = 0.0f;
+        }
+        t += _frame_time;
+        bool reference_done = reference.next(t);
+        bool fixed_done = fixed.next(t);
+        max_error = std::max(max_error, std::abs(reference.value - fixed.value) / distance);
+        if (reference_done && fixed_done) {
+            break;
+        }
+    }
+    assert(reference.done && fixed.done && "Both springs should come to rest");
+    assert(std::abs(fixed.value - retargetEnd) <= options.restDelta + 0.01f && "Fixed spring should rest on target");
+    return max_error;
+}
+
+void test_spring_accuracy()
+{
+    std::cout << "Running tests on fixed point spring...\n";
+
+    for (const auto& spring_case : spring_cases()) {
+        float error = compare_spring<fpm::fixed_16_16>(spring_case.options, 0, 300, -120);
+        error = std::max(error, compare_spring<fpm::fixed_16_16>(spring_case.options, -480, 720, 240));
+        // 大范围数值
+        error = std::max(error, compare_spring<fpm::fixed_16_16>(spring_case.options, -4000, 4000, -2000));
+        std::cout << "  " << spring_case.name << ": max error " << error * 100 << "%\n";
+        assert(error <= _spring_tolerance && "Fixed spring should follow float spring");
+    }
+}
+
+void test_easing_accuracy()
+{
+    std::cout << "Running tests on fixed point easing...\n";
+
+    std::vector<std::function<float(float)>> functions = {
+        ease::linear, ease::ease_in_out_quad, ease::ease_out_cubic, ease::ease_out_back, ease::ease_out_bounce};
+    for (const auto& function : functions) {
+        Easing reference;
+        FixedEasing<> fixed;
+        reference.easingOptions.duration = fixed.easingOptions.duration = 0.4f;
+        reference.easingOptions.easingFunction = fixed.easingOptions.easingFunction = function;
+        reference.start = fixed.start = -150;
+        reference.end = fixed.end = 450;
+        reference.init();
+        fixed.init();
+
+        float max_error = 0.0f;
+        for (int frame = 1; frame <= 30; frame++) {
+            float t = frame * _frame_time;
+            reference.next(t);
+            fixed.next(t);
+            max_error = std::max(max_error, std::abs(reference.value - fixed.value) / 600.0f);
+        }
+        assert(max_error <= _easing_tolerance && "Fixed easing should follow float easing");
+        assert(fixed.done && fixed.value == 450.0f && "Fixed easing should end on target");
+    }
+}
+
+// 定点结果逐位一致，与平台无关
+static const uint32_t _expected_checksum = 1410287999u;
+
+void test_determinism()
+{
+    std::cout << "Running tests on fixed point determinism...\n";
+
+    auto checksum = []() {
+        uint32_t hash = 2166136261u;
+        for (const auto& spring_case : spring_cases()) {
+            FixedSpring<> spring;
+            spring.springOptions = spring_case.options;
+            spring.start = 12.5f;
+            spring.end = 333.0f;
+            spring.init();
+            for (int frame = 1; frame <= 120; frame++) {
+                if (frame == 30) {
+                    spring.retarget(spring.value, -77.0f);
+                }
+                // Time from integer milliseconds, a single rounding, so the input is the same everywhere
+                uint32_t elapsed_ms = (frame < 30 ? frame : frame - 29) * 16;
+                spring.next(static_cast<float>(elapsed_ms) / 1000.0f);
+                hash = (hash ^ static_cast<uint32_t>(spring.fixedValue().raw_value())) * 16777619u;
+            }
+        }
+        return hash;
+    };
+
+    uint32_t hash = checksum();
+    std::cout << "  checksum " << hash << "\n";
+    assert(hash == checksum() && "Fixed spring should be reproducible");
+    assert(hash == _expected_checksum && "Fixed spring should give the same values on every platform");
+}
+
+// FixedAnimate 与 Animate 接口一致
+static uint32_t _tick_ms = 0;
+
+void test_fixed_animate()
+{
+    FixedAnimate<> animation;
+    animation.start = 100;
+    animation.end = 500;
+    animation.springOptions().visualDuration = 0.5;
+    animation.springOptions().bounce = 0.2;
+
+    int updates = 0;
+    animation.onUpdate([&](const float&) { updates++; });
+    animation.init();
+    animation.play();
+    while (animation.isRunning() && _tick_ms < 10000) {
+        _tick_ms += 16;
+        animation.update();
+    }
+    assert(updates > 0 && !animation.isRunning() && "FixedAnimate should complete");
+    assert(std::abs(animation.value() - 500.0f) <= 0.1f && "FixedAnimate should rest on target");
+
+    animation.easingOptions().duration = 0.3;
+    animation.start = 500;
+    animation.end = 0;
+    animation.init();
+    animation.play();
+    while (animation.isRunning() && _tick_ms < 20000) {
+        _tick_ms += 16;
+        animation.update();
+    }
+    assert(animation.value() == 0.0f && "FixedAnimate easing should complete");
+}
+
+// float 与定点版本的 next() 耗时对比
+template <typename Generator>
+double bench_generator(Generator& generator)
+{
+    const int rounds = 2000;
+    const int frames = 120;
+    float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        generator.start = 0;
+        generator.end = (round & 1) ? 300.0f : -300.0f;
+        generator.init();
+        for (int frame = 1; frame <= frames; frame++) {
+            generator.done = false;
+            generator.next(frame * _frame_time);
+            sink += generator.value;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    volatile float keep = sink;
+    (void)keep;
+    return seconds * 1e9 / (double(rounds) * frames);
+}
+
+void bench_generators()
+{
+    SpringOptions_t options;
+    options.visualDuration = 0.6;
+    options.bounce = 0.2;
+
+    Spring spring;
+    spring.springOptions = options;
+    FixedSpring<> fixed_spring;
+    fixed_spring.springOptions = options;
+    Easing easing;
+    easing.easingOptions.easingFunction = ease::ease_out_quad;
+    FixedEasing<> fixed_easing;
+    fixed_easing.easingOptions.easingFunction = ease::ease_out_quad;
+
+    std::cout << "Spring::next(): " << bench_generator(spring) << " ns\n";
+    std::cout << "FixedSpring::next(): " << bench_generator(fixed_spring) << " ns\n";
+    std::cout << "Easing::next(): " << bench_generator(easing) << " ns\n";
+    std::cout << "FixedEasing::next(): " << bench_generator(fixed_easing) << " ns\n";
+}
+
+int main()
+{
+    ui_hal::on_get_tick([]() { return _tick_ms; });
+
+    test_spring_accuracy();
+    test_easing_accuracy();
+    test_determinism();
+    test_fixed_animate();
+    bench_generators();
+
+    std::cout << "All tests passed!\n";
+    return 0;
+}